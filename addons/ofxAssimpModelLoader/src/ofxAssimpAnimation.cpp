@@ -21,10 +21,23 @@ ofxAssimpAnimation::ofxAssimpAnimation(const aiScene * scene, aiAnimation * anim
     durationInSeconds = 0;
     durationInMilliSeconds = 0;
     speed = 1;
+    blendWeight = 1;
+    bUpdateNodes = true;
+    numBakedSamples = 0;
+    bakedSampleRate = 0;
     
     if(animation != NULL) {
         durationInSeconds = animation->mDuration;
         durationInMilliSeconds = durationInSeconds * 1000;
+
+        // find the nodes once, FindNode walks the whole hierarchy
+        channelNodes.resize(animation->mNumChannels);
+        for(unsigned int i=0; i<animation->mNumChannels; i++) {
+            channelNodes[i] = scene->mRootNode->FindNode(animation->mChannels[i]->mNodeName);
+        }
+        positionCursors.assign(animation->mNumChannels, 0);
+        rotationCursors.assign(animation->mNumChannels, 0);
+        scalingCursors.assign(animation->mNumChannels, 0);
     }
 }
 
@@ -63,73 +76,116 @@ void ofxAssimpAnimation::update() {
     setPosition(position);
 }
 
-void ofxAssimpAnimation::updateAnimationNodes() {
-	for(unsigned int i=0; i<animation->mNumChannels; i++) {
-        const aiNodeAnim * channel = animation->mChannels[i];
-        aiNode * targetNode = scene->mRootNode->FindNode(channel->mNodeName);
-        
-        aiVector3D presentPosition(0, 0, 0);
-        if(channel->mNumPositionKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumPositionKeys - 1) {
-                if(progressInSeconds < channel->mPositionKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
-            const aiVectorKey & key = channel->mPositionKeys[frame];
-            const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
-            } else {
-                presentPosition = key.mValue;
-            }
+//--------------------------------------------------------------
+// returns the last key with mTime <= time, starting the search from the
+// one found last time unless time went backwards
+template<class Key>
+static unsigned int findKey(const Key * keys, unsigned int numKeys, double time, unsigned int & cursor) {
+    unsigned int frame = cursor;
+    if(frame >= numKeys || time < keys[frame].mTime) {
+        frame = 0;
+    }
+    while(frame < numKeys - 1) {
+        if(time < keys[frame+1].mTime) {
+            break;
         }
-        
-        aiQuaternion presentRotation(1, 0, 0, 0);
-        if(channel->mNumRotationKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumRotationKeys - 1) {
-                if(progressInSeconds < channel->mRotationKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
-            const aiQuatKey& key = channel->mRotationKeys[frame];
-            const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
-            double diffTime = nextKey.mTime - key.mTime;
-            if(diffTime < 0.0) {
-                diffTime += getDurationInSeconds();
-            }
-            if(diffTime > 0) {
-                float factor = float((progressInSeconds - key.mTime) / diffTime);
-                aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
-            } else {
-                presentRotation = key.mValue;
-            }
+        frame++;
+    }
+    cursor = frame;
+    return frame;
+}
+
+void ofxAssimpAnimation::sampleKeys(unsigned int i, float time, aiVector3D & presentPosition, aiQuaternion & presentRotation, aiVector3D & presentScaling) {
+    const aiNodeAnim * channel = animation->mChannels[i];
+
+    presentPosition = aiVector3D(0, 0, 0);
+    if(channel->mNumPositionKeys > 0) {
+        unsigned int frame = findKey(channel->mPositionKeys, channel->mNumPositionKeys, time, positionCursors[i]);
+        unsigned int nextFrame = (frame + 1) % channel->mNumPositionKeys;
+        const aiVectorKey & key = channel->mPositionKeys[frame];
+        const aiVectorKey & nextKey = channel->mPositionKeys[nextFrame];
+        double diffTime = nextKey.mTime - key.mTime;
+        if(diffTime < 0.0) {
+            diffTime += getDurationInSeconds();
         }
-        
-        aiVector3D presentScaling(1, 1, 1);
-        if(channel->mNumScalingKeys > 0) {
-            unsigned int frame = 0;
-            while(frame < channel->mNumScalingKeys - 1){
-                if(progressInSeconds < channel->mScalingKeys[frame+1].mTime) {
-                    break;
-                }
-                frame++;
-            }
-            
-            presentScaling = channel->mScalingKeys[frame].mValue;
+        if(diffTime > 0) {
+            float factor = float((time - key.mTime) / diffTime);
+            presentPosition = key.mValue + (nextKey.mValue - key.mValue) * factor;
+        } else {
+            presentPosition = key.mValue;
+        }
+    }
+
+    presentRotation = aiQuaternion(1, 0, 0, 0);
+    if(channel->mNumRotationKeys > 0) {
+        unsigned int frame = findKey(channel->mRotationKeys, channel->mNumRotationKeys, time, rotationCursors[i]);
+        unsigned int nextFrame = (frame + 1) % channel->mNumRotationKeys;
+        const aiQuatKey& key = channel->mRotationKeys[frame];
+        const aiQuatKey& nextKey = channel->mRotationKeys[nextFrame];
+        double diffTime = nextKey.mTime - key.mTime;
+        if(diffTime < 0.0) {
+            diffTime += getDurationInSeconds();
         }
+        if(diffTime > 0) {
+            float factor = float((time - key.mTime) / diffTime);
+            aiQuaternion::Interpolate(presentRotation, key.mValue, nextKey.mValue, factor);
+        } else {
+            presentRotation = key.mValue;
+        }
+    }
+
+    presentScaling = aiVector3D(1, 1, 1);
+    if(channel->mNumScalingKeys > 0) {
+        unsigned int frame = findKey(channel->mScalingKeys, channel->mNumScalingKeys, time, scalingCursors[i]);
+        presentScaling = channel->mScalingKeys[frame].mValue;
+    }
+}
+
+void ofxAssimpAnimation::sampleBaked(unsigned int i, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling) {
+    float sample = progressInSeconds * bakedSampleRate;
+    int s0 = ofClamp((int)sample, 0, numBakedSamples - 1);
+    int s1 = min(s0 + 1, numBakedSamples - 1);
+    float factor = ofClamp(sample - s0, 0, 1);
+    int i0 = i * numBakedSamples + s0;
+    int i1 = i * numBakedSamples + s1;
+
+    position.x = ofLerp(bakedPosX[i0], bakedPosX[i1], factor);
+    position.y = ofLerp(bakedPosY[i0], bakedPosY[i1], factor);
+    position.z = ofLerp(bakedPosZ[i0], bakedPosZ[i1], factor);
+
+    aiQuaternion::Interpolate(rotation,
+                              aiQuaternion(bakedRotW[i0], bakedRotX[i0], bakedRotY[i0], bakedRotZ[i0]),
+                              aiQuaternion(bakedRotW[i1], bakedRotX[i1], bakedRotY[i1], bakedRotZ[i1]),
+                              factor);
+
+    // scaling keys are not interpolated
+    scaling.x = bakedScaleX[i0];
+    scaling.y = bakedScaleY[i0];
+    scaling.z = bakedScaleZ[i0];
+}
+
+void ofxAssimpAnimation::sampleChannel(unsigned int i, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling) {
+    if(numBakedSamples > 0) {
+        sampleBaked(i, position, rotation, scaling);
+    } else {
+        sampleKeys(i, progressInSeconds, position, rotation, scaling);
+    }
+}
+
+void ofxAssimpAnimation::updateAnimationNodes() {
+    if(!bUpdateNodes) {
+        return;
+    }
+	for(unsigned int i=0; i<animation->mNumChannels; i++) {
+        aiNode * targetNode = channelNodes[i];
+        if(targetNode == NULL) {
+            continue;
+        }
+
+        aiVector3D presentPosition;
+        aiQuaternion presentRotation;
+        aiVector3D presentScaling;
+        sampleChannel(i, presentPosition, presentRotation, presentScaling);
         
         aiMatrix4x4 mat = aiMatrix4x4(presentRotation.GetMatrix());
         mat.a1 *= presentScaling.x; mat.b1 *= presentScaling.x; mat.c1 *= presentScaling.x;
@@ -141,6 +197,86 @@ void ofxAssimpAnimation::updateAnimationNodes() {
     }
 }
 
+void ofxAssimpAnimation::setupPose(const ofxAssimpPose & pose) {
+    poseIndices.resize(channelNodes.size());
+    for(unsigned int i=0; i<channelNodes.size(); i++) {
+        poseIndices[i] = pose.getNodeIndex(channelNodes[i]);
+    }
+}
+
+void ofxAssimpAnimation::samplePose(ofxAssimpPose & pose) {
+    if(animation == NULL || poseIndices.size() != animation->mNumChannels) {
+        return;
+    }
+    for(unsigned int i=0; i<animation->mNumChannels; i++) {
+        int node = poseIndices[i];
+        if(node < 0) {
+            continue;
+        }
+        aiVector3D position;
+        aiQuaternion rotation;
+        aiVector3D scaling;
+        sampleChannel(i, position, rotation, scaling);
+        pose.add(node, position, rotation, scaling, blendWeight);
+    }
+}
+
+void ofxAssimpAnimation::bake(float samplesPerSecond) {
+    if(animation == NULL || samplesPerSecond <= 0) {
+        return;
+    }
+    bakedSampleRate = samplesPerSecond;
+    numBakedSamples = ceil(getDurationInSeconds() * samplesPerSecond) + 1;
+
+    int numSamples = animation->mNumChannels * numBakedSamples;
+    bakedPosX.resize(numSamples); bakedPosY.resize(numSamples); bakedPosZ.resize(numSamples);
+    bakedRotW.resize(numSamples); bakedRotX.resize(numSamples); bakedRotY.resize(numSamples); bakedRotZ.resize(numSamples);
+    bakedScaleX.resize(numSamples); bakedScaleY.resize(numSamples); bakedScaleZ.resize(numSamples);
+
+    for(unsigned int i=0; i<animation->mNumChannels; i++) {
+        for(int s=0; s<numBakedSamples; s++) {
+            float time = min(s / samplesPerSecond, getDurationInSeconds());
+            aiVector3D position;
+            aiQuaternion rotation;
+            aiVector3D scaling;
+            sampleKeys(i, time, position, rotation, scaling);
+
+            int idx = i * numBakedSamples + s;
+            bakedPosX[idx] = position.x; bakedPosY[idx] = position.y; bakedPosZ[idx] = position.z;
+            bakedRotW[idx] = rotation.w; bakedRotX[idx] = rotation.x; bakedRotY[idx] = rotation.y; bakedRotZ[idx] = rotation.z;
+            bakedScaleX[idx] = scaling.x; bakedScaleY[idx] = scaling.y; bakedScaleZ[idx] = scaling.z;
+        }
+    }
+}
+
+void ofxAssimpAnimation::clearBake() {
+    numBakedSamples = 0;
+    bakedSampleRate = 0;
+    bakedPosX.clear(); bakedPosY.clear(); bakedPosZ.clear();
+    bakedRotW.clear(); bakedRotX.clear(); bakedRotY.clear(); bakedRotZ.clear();
+    bakedScaleX.clear(); bakedScaleY.clear(); bakedScaleZ.clear();
+}
+
+bool ofxAssimpAnimation::isBaked() {
+    return numBakedSamples > 0;
+}
+
+void ofxAssimpAnimation::setBlendWeight(float weight) {
+    blendWeight = weight;
+}
+
+float ofxAssimpAnimation::getBlendWeight() {
+    return blendWeight;
+}
+
+void ofxAssimpAnimation::setUpdateNodes(bool updateNodes) {
+    bUpdateNodes = updateNodes;
+}
+
+const vector<aiNode*> & ofxAssimpAnimation::getChannelNodes() {
+    return channelNodes;
+}
+
 void ofxAssimpAnimation::play() {
     if(animation == NULL) {
         return;
@@ -6,9 +6,11 @@
 #pragma once
 
 #include "ofMain.h"
+#include "ofxAssimpPose.h"
 
 class aiScene;
 class aiAnimation;
+class aiNode;
 
 class ofxAssimpAnimation {
 
@@ -41,10 +43,28 @@ public:
     void setPosition(float position);
     void setLoopState(ofLoopType state);
     void setSpeed(float speed);
+
+    // pre samples every channel at a fixed rate so evaluating the
+    // animation doesn't need to search the keyframes anymore
+    void bake(float samplesPerSecond);
+    void clearBake();
+    bool isBaked();
+
+    // used when the model blends several animations, instead of writing
+    // the nodes in setPosition the animation is added to a pose
+    void setBlendWeight(float weight);
+    float getBlendWeight();
+    void setUpdateNodes(bool updateNodes);
+    void setupPose(const ofxAssimpPose & pose);
+    void samplePose(ofxAssimpPose & pose);
+    const vector<aiNode*> & getChannelNodes();
     
 protected:
     
     void updateAnimationNodes();
+    void sampleChannel(unsigned int channel, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling);
+    void sampleKeys(unsigned int channel, float time, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling);
+    void sampleBaked(unsigned int channel, aiVector3D & position, aiQuaternion & rotation, aiVector3D & scaling);
     
     const aiScene * scene;
     aiAnimation * animation;
@@ -59,4 +79,22 @@ protected:
     float durationInSeconds;
     int durationInMilliSeconds;
     float speed;
+    float blendWeight;
+    bool bUpdateNodes;
+
+    vector<aiNode*> channelNodes;
+    vector<int> poseIndices;
+
+    // last key used by every channel, playing forward the next key
+    // is almost always the same or the one after it
+    vector<unsigned int> positionCursors;
+    vector<unsigned int> rotationCursors;
+    vector<unsigned int> scalingCursors;
+
+    // baked channels, numBakedSamples per channel one after another
+    int numBakedSamples;
+    float bakedSampleRate;
+    vector<float> bakedPosX, bakedPosY, bakedPosZ;
+    vector<float> bakedRotW, bakedRotX, bakedRotY, bakedRotZ;
+    vector<float> bakedScaleX, bakedScaleY, bakedScaleZ;
 };
@@ -6,6 +6,7 @@
 #include "ofxAssimpMeshHelper.h"
 #include "ofxAssimpUtils.h"
 #include "aiMesh.h"
+#include "aiScene.h"
 
 ofxAssimpMeshHelper::ofxAssimpMeshHelper() {
     mesh = NULL;
@@ -14,6 +15,7 @@ ofxAssimpMeshHelper::ofxAssimpMeshHelper() {
     twoSided = false;
     hasChanged = false;
     validCache = false;
+    skinningPending = false;
 }
 
 ofxAssimpMeshHelper::~ofxAssimpMeshHelper() {
@@ -33,3 +35,43 @@ ofTexture * ofxAssimpMeshHelper::getTexturePtr() {
     }
     return NULL;
 }
+
+void ofxAssimpMeshHelper::setupSkinning(const aiScene * scene) {
+    skinningWeights.setup(mesh);
+    if(!mesh->HasBones()) {
+        return;
+    }
+    // find the nodes of the bones only once instead of every frame
+    boneNodes.resize(mesh->mNumBones);
+    for(unsigned int a=0; a<mesh->mNumBones; ++a) {
+        boneNodes[a] = scene->mRootNode->FindNode(mesh->mBones[a]->mName);
+    }
+    boneMatrices.resize(mesh->mNumBones*12);
+    animatedPosBack.resize(mesh->mNumVertices);
+    if(mesh->HasNormals()) {
+        animatedNormBack.resize(mesh->mNumVertices);
+    }
+}
+
+void ofxAssimpMeshHelper::updateBoneMatrices() {
+    for(unsigned int a=0; a<mesh->mNumBones; ++a) {
+        const aiBone* bone = mesh->mBones[a];
+
+        // start with the mesh-to-bone matrix
+        aiMatrix4x4 boneMatrix = bone->mOffsetMatrix;
+        // and now append all node transformations down the parent chain until we're back at mesh coordinates again
+        const aiNode* tempNode = boneNodes[a];
+        while(tempNode) {
+            // check your matrix multiplication order here!!!
+            boneMatrix = tempNode->mTransformation * boneMatrix;
+            // boneMatrix = boneMatrix * tempNode->mTransformation;
+            tempNode = tempNode->mParent;
+        }
+
+        // the skinning only needs the first 3 rows
+        float * m = &boneMatrices[a*12];
+        m[0] = boneMatrix.a1; m[1] = boneMatrix.a2; m[2]  = boneMatrix.a3; m[3]  = boneMatrix.a4;
+        m[4] = boneMatrix.b1; m[5] = boneMatrix.b2; m[6]  = boneMatrix.b3; m[7]  = boneMatrix.b4;
+        m[8] = boneMatrix.c1; m[9] = boneMatrix.c2; m[10] = boneMatrix.c3; m[11] = boneMatrix.c4;
+    }
+}
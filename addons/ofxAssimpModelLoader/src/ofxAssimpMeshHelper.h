@@ -8,8 +8,10 @@
 #include "ofMain.h"
 #include "assimp.h"
 #include "ofxAssimpTexture.h"
+#include "ofxAssimpSkinning.h"
 
 class aiMesh;
+class aiScene;
 
 class ofxAssimpMeshHelper {
 
@@ -20,6 +22,11 @@ public:
     
     bool hasTexture();
     ofTexture * getTexturePtr();
+
+    // finds the bone nodes and allocates the skinning buffers
+    void setupSkinning(const aiScene * scene);
+    // walks the bones up to the root to find their current matrices
+    void updateBoneMatrices();
     
     aiMesh * mesh; // pointer to the aiMesh we represent.
 
@@ -38,6 +45,15 @@ public:
     vector<aiVector3D> animatedPos;
     vector<aiVector3D> animatedNorm;
 
+    // skinning data, the back buffers are written by the skinning
+    // threads while the ones above are uploaded to the vbo
+    ofxAssimpSkinningWeights skinningWeights;
+    vector<aiNode*> boneNodes;
+    vector<float> boneMatrices;
+    vector<aiVector3D> animatedPosBack;
+    vector<aiVector3D> animatedNormBack;
+    bool skinningPending;
+
     ofMesh cachedMesh;
     bool validCache;
     
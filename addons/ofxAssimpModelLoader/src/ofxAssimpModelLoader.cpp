@@ -8,6 +8,7 @@
 
 ofxAssimpModelLoader::ofxAssimpModelLoader(){
 	scene = NULL;
+	bThreadedSkinning = false;
 	clear();
 }
 
@@ -263,6 +264,8 @@ void ofxAssimpModelLoader::loadGLResources(){
         	meshHelper.animatedNorm.resize(mesh->mNumVertices);
         }
 
+        meshHelper.setupSkinning(scene);
+
 
         int usage;
         if(getAnimationCount()){
@@ -318,9 +321,14 @@ void ofxAssimpModelLoader::clear(){
 
     ofLogVerbose("ofxAssimpModelLoader") << "clear(): deleting GL resources";
 
+    // the skinning threads could still be writing to the meshes
+    ofxAssimpSkinningPool::getPool().wait(skinningBatch);
+
     // clear out everything.
     modelMeshes.clear();
     animations.clear();
+    animationPose.clear();
+    bAnimationBlending = false;
     pos.set(0,0,0);
     scale.set(1,1,1);
     rotAngle.clear();
@@ -360,6 +368,9 @@ void ofxAssimpModelLoader::update() {
     if(hasAnimations() == false) {
         return;
     }
+    if(bThreadedSkinning) {
+        finishSkinning();
+    }
     updateBones();
     updateGLResources();
 }
@@ -368,6 +379,15 @@ void ofxAssimpModelLoader::updateAnimations() {
     for(unsigned int i=0; i<animations.size(); i++) {
         animations[i].update();
     }
+    if(bAnimationBlending) {
+        animationPose.reset();
+        for(unsigned int i=0; i<animations.size(); i++) {
+            if(animations[i].isPlaying()) {
+                animations[i].samplePose(animationPose);
+            }
+        }
+        animationPose.apply();
+    }
 }
 
 void ofxAssimpModelLoader::updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix) {
@@ -395,58 +415,42 @@ void ofxAssimpModelLoader::updateBones() {
     // update mesh position for the animation
 	for(unsigned int i=0; i<modelMeshes.size(); ++i) {
 		// current mesh we are introspecting
-		const aiMesh* mesh = modelMeshes[i].mesh;
-        
-		// calculate bone matrices
-		vector<aiMatrix4x4> boneMatrices(mesh->mNumBones);
-		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-            
-			// find the corresponding node by again looking recursively through the node hierarchy for the same name
-			aiNode* node = scene->mRootNode->FindNode(bone->mName);
-            
-			// start with the mesh-to-bone matrix
-			boneMatrices[a] = bone->mOffsetMatrix;
-			// and now append all node transformations down the parent chain until we're back at mesh coordinates again
-			const aiNode* tempNode = node;
-			while(tempNode) {
-				// check your matrix multiplication order here!!!
-				boneMatrices[a] = tempNode->mTransformation * boneMatrices[a];
-				// boneMatrices[a] = boneMatrices[a] * tempNode->mTransformation;
-				tempNode = tempNode->mParent;
-			}
-			modelMeshes[i].hasChanged = true;
-			modelMeshes[i].validCache = false;
+		ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+		const aiMesh* mesh = meshHelper.mesh;
+		if(meshHelper.skinningWeights.empty()) {
+			continue;
 		}
-        
-		modelMeshes[i].animatedPos.assign(modelMeshes[i].animatedPos.size(),0);
-		if(mesh->HasNormals()){
-			modelMeshes[i].animatedNorm.assign(modelMeshes[i].animatedNorm.size(),0);
+
+		meshHelper.updateBoneMatrices();
+
+		if(bThreadedSkinning) {
+			ofxAssimpSkinningPool::getPool().submit(&meshHelper, skinningBatch);
+			meshHelper.skinningPending = true;
+		} else {
+			ofxAssimpSkinVertices(mesh,
+								  meshHelper.skinningWeights,
+								  &meshHelper.boneMatrices[0],
+								  &meshHelper.animatedPos[0],
+								  mesh->HasNormals() ? &meshHelper.animatedNorm[0] : NULL,
+								  0, mesh->mNumVertices);
+			meshHelper.hasChanged = true;
+			meshHelper.validCache = false;
 		}
-		// loop through all vertex weights of all bones
-		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-			const aiMatrix4x4& posTrafo = boneMatrices[a];
-            
-			for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-				const aiVertexWeight& weight = bone->mWeights[b];
-                
-				size_t vertexId = weight.mVertexId;
-				const aiVector3D& srcPos = mesh->mVertices[vertexId];
-                
-				modelMeshes[i].animatedPos[vertexId] += weight.mWeight * (posTrafo * srcPos);
-			}
-			if(mesh->HasNormals()){
-				// 3x3 matrix, contains the bone matrix without the translation, only with rotation and possibly scaling
-				aiMatrix3x3 normTrafo = aiMatrix3x3( posTrafo);
-				for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-					const aiVertexWeight& weight = bone->mWeights[b];
-					size_t vertexId = weight.mVertexId;
-                    
-					const aiVector3D& srcNorm = mesh->mNormals[vertexId];
-					modelMeshes[i].animatedNorm[vertexId] += weight.mWeight * (normTrafo * srcNorm);
-				}
-			}
+	}
+}
+
+void ofxAssimpModelLoader::finishSkinning() {
+	// wait for the meshes skinned last frame and swap the
+	// results in so they get uploaded
+	ofxAssimpSkinningPool::getPool().wait(skinningBatch);
+	for(unsigned int i=0; i<modelMeshes.size(); ++i) {
+		ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+		if(meshHelper.skinningPending) {
+			meshHelper.animatedPos.swap(meshHelper.animatedPosBack);
+			meshHelper.animatedNorm.swap(meshHelper.animatedNormBack);
+			meshHelper.hasChanged = true;
+			meshHelper.validCache = false;
+			meshHelper.skinningPending = false;
 		}
 	}
 }
@@ -528,6 +532,39 @@ void ofxAssimpModelLoader::setPositionForAllAnimations(float position) {
     }
 }
 
+void ofxAssimpModelLoader::enableAnimationBlending() {
+    if(bAnimationBlending) {
+        return;
+    }
+    // one slot in the pose for every node animated by any animation
+    vector<aiNode*> nodes;
+    for(unsigned int i=0; i<animations.size(); i++) {
+        const vector<aiNode*> & channelNodes = animations[i].getChannelNodes();
+        for(unsigned int j=0; j<channelNodes.size(); j++) {
+            if(channelNodes[j] != NULL && find(nodes.begin(), nodes.end(), channelNodes[j]) == nodes.end()) {
+                nodes.push_back(channelNodes[j]);
+            }
+        }
+    }
+    animationPose.setup(nodes);
+    for(unsigned int i=0; i<animations.size(); i++) {
+        animations[i].setupPose(animationPose);
+        animations[i].setUpdateNodes(false);
+    }
+    bAnimationBlending = true;
+}
+
+void ofxAssimpModelLoader::disableAnimationBlending() {
+    for(unsigned int i=0; i<animations.size(); i++) {
+        animations[i].setUpdateNodes(true);
+    }
+    bAnimationBlending = false;
+}
+
+bool ofxAssimpModelLoader::getUsingAnimationBlending() {
+    return bAnimationBlending;
+}
+
 // DEPRECATED.
 void ofxAssimpModelLoader::setAnimation(int animationIndex) {
     if(!hasAnimations()) {
@@ -1022,3 +1059,21 @@ void ofxAssimpModelLoader::disableColors(){
 void ofxAssimpModelLoader::disableMaterials(){
 	bUsingMaterials = false;
 }
+
+//-------------------------------------------
+void ofxAssimpModelLoader::enableThreadedSkinning(){
+    bThreadedSkinning = true;
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::disableThreadedSkinning(){
+    if(bThreadedSkinning){
+        finishSkinning();
+    }
+    bThreadedSkinning = false;
+}
+
+//-------------------------------------------
+bool ofxAssimpModelLoader::getUsingThreadedSkinning(){
+    return bThreadedSkinning;
+}
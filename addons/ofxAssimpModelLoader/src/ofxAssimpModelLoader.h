@@ -45,6 +45,12 @@ class ofxAssimpModelLoader{
         void setPausedForAllAnimations(bool pause);
         void setLoopStateForAllAnimations(ofLoopType state);
         void setPositionForAllAnimations(float position);
+
+        // blend all the playing animations by their blend weight
+        // instead of letting the last one updated win
+        void enableAnimationBlending();
+        void disableAnimationBlending();
+        bool getUsingAnimationBlending();
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setAnimation(int animationIndex));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setNormalizedTime(float time));
         OF_DEPRECATED_MSG("Use ofxAssimpAnimation instead", void setTime(float time));
@@ -93,6 +99,12 @@ class ofxAssimpModelLoader{
     	void disableColors();
     	void disableMaterials();
 
+        // skin animated meshes in worker threads, the results are one
+        // frame behind the animation. see ofxAssimpSkinningPool
+        void enableThreadedSkinning();
+        void disableThreadedSkinning();
+        bool getUsingThreadedSkinning();
+
         void draw(ofPolyRenderMode renderType);
 		
 		ofPoint getPosition();
@@ -118,6 +130,7 @@ class ofxAssimpModelLoader{
         void updateAnimations();
         void updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix);
         void updateBones();
+        void finishSkinning();
         void updateModelMatrix();
     
         // the main Asset Import scene that does the magic.
@@ -158,5 +171,9 @@ class ofxAssimpModelLoader{
         bool bUsingNormals;
         bool bUsingColors;
         bool bUsingMaterials;
+        bool bThreadedSkinning;
+        bool bAnimationBlending;
+        ofxAssimpPose animationPose;
+        ofxAssimpSkinningPool::Batch skinningBatch;
         float normalizeFactor;
 };
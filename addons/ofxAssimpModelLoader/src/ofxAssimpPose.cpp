@@ -0,0 +1,95 @@
+//
+//  ofxAssimpPose.cpp
+//
+
+#include "ofxAssimpPose.h"
+#include "assimp.h"
+#include "aiScene.h"
+
+void ofxAssimpPose::setup(const vector<aiNode*> & _nodes) {
+    nodes = _nodes;
+    int numNodes = nodes.size();
+    posX.assign(numNodes, 0);
+    posY.assign(numNodes, 0);
+    posZ.assign(numNodes, 0);
+    rotW.assign(numNodes, 0);
+    rotX.assign(numNodes, 0);
+    rotY.assign(numNodes, 0);
+    rotZ.assign(numNodes, 0);
+    scaleX.assign(numNodes, 0);
+    scaleY.assign(numNodes, 0);
+    scaleZ.assign(numNodes, 0);
+    weights.assign(numNodes, 0);
+}
+
+void ofxAssimpPose::clear() {
+    setup(vector<aiNode*>());
+}
+
+int ofxAssimpPose::getNumNodes() const {
+    return nodes.size();
+}
+
+int ofxAssimpPose::getNodeIndex(const aiNode * node) const {
+    for(unsigned int i=0; i<nodes.size(); i++) {
+        if(nodes[i] == node) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ofxAssimpPose::reset() {
+    weights.assign(weights.size(), 0);
+}
+
+void ofxAssimpPose::add(int i, const aiVector3D & position, const aiQuaternion & rotation, const aiVector3D & scaling, float weight) {
+    if(weight <= 0) {
+        return;
+    }
+    if(weights[i] == 0) {
+        posX[i] = posY[i] = posZ[i] = 0;
+        rotW[i] = rotX[i] = rotY[i] = rotZ[i] = 0;
+        scaleX[i] = scaleY[i] = scaleZ[i] = 0;
+    }
+
+    posX[i] += position.x * weight;
+    posY[i] += position.y * weight;
+    posZ[i] += position.z * weight;
+
+    // q and -q are the same rotation, keep all the added ones in the same
+    // hemisphere so the normalized sum interpolates through the short path
+    float dot = rotW[i]*rotation.w + rotX[i]*rotation.x + rotY[i]*rotation.y + rotZ[i]*rotation.z;
+    float rotWeight = dot < 0 ? -weight : weight;
+    rotW[i] += rotation.w * rotWeight;
+    rotX[i] += rotation.x * rotWeight;
+    rotY[i] += rotation.y * rotWeight;
+    rotZ[i] += rotation.z * rotWeight;
+
+    scaleX[i] += scaling.x * weight;
+    scaleY[i] += scaling.y * weight;
+    scaleZ[i] += scaling.z * weight;
+
+    weights[i] += weight;
+}
+
+void ofxAssimpPose::apply() {
+    for(unsigned int i=0; i<nodes.size(); i++) {
+        float weight = weights[i];
+        if(weight <= 0) {
+            continue;
+        }
+
+        aiQuaternion rotation(rotW[i], rotX[i], rotY[i], rotZ[i]);
+        rotation.Normalize();
+
+        float scale = 1.f / weight;
+        aiMatrix4x4 mat = aiMatrix4x4(rotation.GetMatrix());
+        mat.a1 *= scaleX[i] * scale; mat.b1 *= scaleX[i] * scale; mat.c1 *= scaleX[i] * scale;
+        mat.a2 *= scaleY[i] * scale; mat.b2 *= scaleY[i] * scale; mat.c2 *= scaleY[i] * scale;
+        mat.a3 *= scaleZ[i] * scale; mat.b3 *= scaleZ[i] * scale; mat.c3 *= scaleZ[i] * scale;
+        mat.a4 = posX[i] * scale; mat.b4 = posY[i] * scale; mat.c4 = posZ[i] * scale;
+
+        nodes[i]->mTransformation = mat;
+    }
+}
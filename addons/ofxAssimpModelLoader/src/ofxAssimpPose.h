@@ -0,0 +1,42 @@
+//
+//  ofxAssimpPose.h
+//
+//  Flat buffer with the position, rotation and scaling of every animated
+//  node of a scene, stored as separate arrays per component. Several
+//  animations add their weighted samples into it and the blended result
+//  is written to the nodes once.
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+class aiNode;
+class aiVector3D;
+class aiQuaternion;
+
+class ofxAssimpPose {
+
+public:
+
+    void setup(const vector<aiNode*> & nodes);
+    void clear();
+
+    int getNumNodes() const;
+    int getNodeIndex(const aiNode * node) const;
+
+    // sets all the weights to 0, call before adding the animations
+    void reset();
+    void add(int node, const aiVector3D & position, const aiQuaternion & rotation, const aiVector3D & scaling, float weight);
+
+    // writes the blended transformation of every node with some weight
+    void apply();
+
+protected:
+
+    vector<aiNode*> nodes;
+    vector<float> posX, posY, posZ;
+    vector<float> rotW, rotX, rotY, rotZ;
+    vector<float> scaleX, scaleY, scaleZ;
+    vector<float> weights;
+};
@@ -0,0 +1,226 @@
+//
+//  ofxAssimpSkinning.cpp
+//
+
+#include "ofxAssimpSkinning.h"
+#include "ofxAssimpMeshHelper.h"
+#include "aiMesh.h"
+#include "Poco/Environment.h"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+// meshes are split in jobs of this many vertices so big meshes
+// can be skinned by several threads at once
+static const int OFX_ASSIMP_SKINNING_JOB_SIZE = 4096;
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningWeights::setup(const aiMesh * mesh){
+	clear();
+	if(!mesh->HasBones()) return;
+
+	// count the weights per vertex to find where each vertex starts
+	offsets.assign(mesh->mNumVertices+1,0);
+	for(unsigned int a=0; a<mesh->mNumBones; ++a){
+		const aiBone * bone = mesh->mBones[a];
+		for(unsigned int b=0; b<bone->mNumWeights; ++b){
+			offsets[bone->mWeights[b].mVertexId+1]++;
+		}
+	}
+	for(unsigned int v=0; v<mesh->mNumVertices; ++v){
+		offsets[v+1] += offsets[v];
+	}
+	if(offsets.back()==0){
+		clear();
+		return;
+	}
+
+	bones.resize(offsets.back());
+	weights.resize(offsets.back());
+	vector<unsigned int> next(offsets.begin(),offsets.end()-1);
+	for(unsigned int a=0; a<mesh->mNumBones; ++a){
+		const aiBone * bone = mesh->mBones[a];
+		for(unsigned int b=0; b<bone->mNumWeights; ++b){
+			unsigned int idx = next[bone->mWeights[b].mVertexId]++;
+			bones[idx] = a;
+			weights[idx] = bone->mWeights[b].mWeight;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningWeights::clear(){
+	offsets.clear();
+	bones.clear();
+	weights.clear();
+}
+
+//--------------------------------------------------------------
+bool ofxAssimpSkinningWeights::empty() const{
+	return offsets.empty();
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinVertices(const aiMesh * mesh,
+						   const ofxAssimpSkinningWeights & skin,
+						   const float * boneMatrices,
+						   aiVector3D * outPositions,
+						   aiVector3D * outNormals,
+						   int firstVertex, int lastVertex){
+	const unsigned int * offsets = &skin.offsets[0];
+	const unsigned int * bones = &skin.bones[0];
+	const float * weights = &skin.weights[0];
+	const aiVector3D * srcPositions = mesh->mVertices;
+	const aiVector3D * srcNormals = outNormals ? mesh->mNormals : NULL;
+
+	for(int v=firstVertex; v<lastVertex; ++v){
+		// blend the matrices of every bone affecting this vertex
+		// and transform the vertex only once with the result
+		float m[12];
+#ifdef __SSE__
+		__m128 r0 = _mm_setzero_ps();
+		__m128 r1 = _mm_setzero_ps();
+		__m128 r2 = _mm_setzero_ps();
+		for(unsigned int k=offsets[v]; k<offsets[v+1]; ++k){
+			const float * bone = boneMatrices + bones[k]*12;
+			__m128 w = _mm_set1_ps(weights[k]);
+			r0 = _mm_add_ps(r0, _mm_mul_ps(w, _mm_loadu_ps(bone)));
+			r1 = _mm_add_ps(r1, _mm_mul_ps(w, _mm_loadu_ps(bone+4)));
+			r2 = _mm_add_ps(r2, _mm_mul_ps(w, _mm_loadu_ps(bone+8)));
+		}
+		_mm_storeu_ps(m, r0);
+		_mm_storeu_ps(m+4, r1);
+		_mm_storeu_ps(m+8, r2);
+#else
+		for(int j=0; j<12; ++j){
+			m[j] = 0;
+		}
+		for(unsigned int k=offsets[v]; k<offsets[v+1]; ++k){
+			const float * bone = boneMatrices + bones[k]*12;
+			const float w = weights[k];
+			for(int j=0; j<12; ++j){
+				m[j] += w * bone[j];
+			}
+		}
+#endif
+
+		const aiVector3D & p = srcPositions[v];
+		outPositions[v].x = m[0]*p.x + m[1]*p.y + m[2]*p.z  + m[3];
+		outPositions[v].y = m[4]*p.x + m[5]*p.y + m[6]*p.z  + m[7];
+		outPositions[v].z = m[8]*p.x + m[9]*p.y + m[10]*p.z + m[11];
+
+		if(srcNormals){
+			const aiVector3D & n = srcNormals[v];
+			outNormals[v].x = m[0]*n.x + m[1]*n.y + m[2]*n.z;
+			outNormals[v].y = m[4]*n.x + m[5]*n.y + m[6]*n.z;
+			outNormals[v].z = m[8]*n.x + m[9]*n.y + m[10]*n.z;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+ofxAssimpSkinningPool::Batch::Batch(){
+	pending = 0;
+}
+
+//--------------------------------------------------------------
+ofxAssimpSkinningPool & ofxAssimpSkinningPool::getPool(){
+	// never deleted, the workers are blocked waiting for jobs on exit
+	static ofxAssimpSkinningPool * pool = new ofxAssimpSkinningPool;
+	return *pool;
+}
+
+//--------------------------------------------------------------
+ofxAssimpSkinningPool::ofxAssimpSkinningPool(){
+	numThreads = max(1,(int)Poco::Environment::processorCount()-1);
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::setNumThreads(int _numThreads){
+	if(!workers.empty()){
+		ofLogWarning("ofxAssimpSkinningPool") << "setNumThreads(): skinning threads already started, ignoring";
+		return;
+	}
+	numThreads = max(1,_numThreads);
+}
+
+//--------------------------------------------------------------
+int ofxAssimpSkinningPool::getNumThreads(){
+	return numThreads;
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::start(){
+	for(int i=0;i<numThreads;i++){
+		workers.push_back(new Worker(*this));
+		workers.back()->startThread(true,false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::submit(ofxAssimpMeshHelper * mesh, Batch & batch){
+	if(workers.empty()){
+		start();
+	}
+	int numVertices = mesh->animatedPosBack.size();
+	ofMutex::ScopedLock lock(mutex);
+	for(int first=0; first<numVertices; first+=OFX_ASSIMP_SKINNING_JOB_SIZE){
+		Job job;
+		job.mesh = mesh;
+		job.batch = &batch;
+		job.firstVertex = first;
+		job.lastVertex = min(first+OFX_ASSIMP_SKINNING_JOB_SIZE,numVertices);
+		jobs.push_back(job);
+		batch.pending++;
+	}
+	jobAvailable.broadcast();
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::wait(Batch & batch){
+	ofMutex::ScopedLock lock(mutex);
+	while(batch.pending>0){
+		jobFinished.wait(mutex);
+	}
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::waitForJob(Job & job){
+	ofMutex::ScopedLock lock(mutex);
+	while(jobs.empty()){
+		jobAvailable.wait(mutex);
+	}
+	job = jobs.front();
+	jobs.pop_front();
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::finished(Job & job){
+	ofMutex::ScopedLock lock(mutex);
+	job.batch->pending--;
+	if(job.batch->pending==0){
+		jobFinished.broadcast();
+	}
+}
+
+//--------------------------------------------------------------
+ofxAssimpSkinningPool::Worker::Worker(ofxAssimpSkinningPool & pool)
+:pool(pool){
+}
+
+//--------------------------------------------------------------
+void ofxAssimpSkinningPool::Worker::threadedFunction(){
+	Job job;
+	while(isThreadRunning()){
+		pool.waitForJob(job);
+		ofxAssimpMeshHelper & mesh = *job.mesh;
+		ofxAssimpSkinVertices(mesh.mesh,
+							  mesh.skinningWeights,
+							  &mesh.boneMatrices[0],
+							  &mesh.animatedPosBack[0],
+							  mesh.animatedNormBack.empty() ? NULL : &mesh.animatedNormBack[0],
+							  job.firstVertex, job.lastVertex);
+		pool.finished(job);
+	}
+}
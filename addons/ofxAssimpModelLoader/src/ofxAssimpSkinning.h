@@ -0,0 +1,91 @@
+//
+//  ofxAssimpSkinning.h
+//
+//  CPU skinning of animated meshes. The bone weights of every mesh are
+//  flattened once at load time into a per vertex table so a vertex is
+//  skinned by blending its bone matrices and transforming it only once.
+//  The work can be split in jobs and run on a pool of worker threads
+//  shared by all the models.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "Poco/Condition.h"
+#include <deque>
+
+class aiMesh;
+class aiNode;
+class aiVector3D;
+class ofxAssimpMeshHelper;
+
+class ofxAssimpSkinningWeights {
+public:
+	void setup(const aiMesh * mesh);
+	void clear();
+	bool empty() const;
+
+	// for vertex v its bones and weights are in [offsets[v], offsets[v+1])
+	vector<unsigned int> offsets;
+	vector<unsigned int> bones;
+	vector<float> weights;
+};
+
+// bone matrices are passed as 3x4 row major floats, the last row of an
+// aiMatrix4x4 is always 0,0,0,1 for bones so it's not stored
+void ofxAssimpSkinVertices(const aiMesh * mesh,
+						   const ofxAssimpSkinningWeights & weights,
+						   const float * boneMatrices,
+						   aiVector3D * outPositions,
+						   aiVector3D * outNormals,
+						   int firstVertex, int lastVertex);
+
+class ofxAssimpSkinningPool {
+public:
+	// jobs submitted with the same batch can be waited for together
+	struct Batch{
+		Batch();
+		int pending;
+	};
+
+	static ofxAssimpSkinningPool & getPool();
+
+	// number of worker threads, by default one less than the number of
+	// cores. has to be called before any model starts skinning in threads
+	void setNumThreads(int numThreads);
+	int getNumThreads();
+
+	// skins the vertices of the mesh into its back buffers
+	void submit(ofxAssimpMeshHelper * mesh, Batch & batch);
+	void wait(Batch & batch);
+
+private:
+	ofxAssimpSkinningPool();
+
+	class Worker: public ofThread{
+	public:
+		Worker(ofxAssimpSkinningPool & pool);
+		void threadedFunction();
+		ofxAssimpSkinningPool & pool;
+	};
+
+	struct Job{
+		ofxAssimpMeshHelper * mesh;
+		Batch * batch;
+		int firstVertex;
+		int lastVertex;
+	};
+
+	void start();
+	void waitForJob(Job & job);
+	void finished(Job & job);
+
+	friend class Worker;
+
+	vector<Worker*> workers;
+	int numThreads;
+	deque<Job> jobs;
+	ofMutex mutex;
+	Poco::Condition jobAvailable;
+	Poco::Condition jobFinished;
+};
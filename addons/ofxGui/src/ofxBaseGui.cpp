@@ -2,6 +2,7 @@
 #include "ofXml.h"
 #include "ofImage.h"
 #include "ofBitmapFont.h"
+#include "ofGraphics.h"
 
 
 void ofxGuiSetFont(const string & fontPath,int fontsize, bool _bAntiAliased=true, bool _bFullCharacterSet=false, int dpi=0){
@@ -62,6 +63,9 @@ bool ofxBaseGui::useTTF = false;
 
 ofxBaseGui::ofxBaseGui(){
 	currentFrame = ofGetFrameNum();
+	geometryVersion = 0;
+	shapesMesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	textMesh.setMode(OF_PRIMITIVE_TRIANGLES);
 	serializer = ofPtr<ofBaseFileSerializer> (new ofXml);
 
 	thisHeaderBackgroundColor=headerBackgroundColor;
@@ -140,6 +144,99 @@ ofRectangle ofxBaseGui::getTextBoundingBox(const string & text,float x, float y)
 	}
 }
 
+bool ofxBaseGui::isBatchable(){
+	return false;
+}
+
+void ofxBaseGui::clearGeometry(){
+	shapesMesh.clear();
+	textMesh.clear();
+	textItems.clear();
+	geometryVersion++;
+}
+
+void ofxBaseGui::addRectangle(const ofRectangle & r, const ofColor & color){
+	ofFloatColor c = color;
+	shapesMesh.addVertex(ofVec3f(r.x, r.y));
+	shapesMesh.addVertex(ofVec3f(r.x + r.width, r.y));
+	shapesMesh.addVertex(ofVec3f(r.x + r.width, r.y + r.height));
+	shapesMesh.addVertex(ofVec3f(r.x + r.width, r.y + r.height));
+	shapesMesh.addVertex(ofVec3f(r.x, r.y + r.height));
+	shapesMesh.addVertex(ofVec3f(r.x, r.y));
+	for(int i=0;i<6;i++){
+		shapesMesh.addColor(c);
+	}
+}
+
+void ofxBaseGui::addRectangleOutline(const ofRectangle & r, const ofColor & color){
+	// 1 pixel wide lines inside the rectangle, as thin quads so they
+	// can go in the same mesh as the filled shapes
+	addRectangle(ofRectangle(r.x, r.y, r.width, 1), color);
+	addRectangle(ofRectangle(r.x, r.y + r.height - 1, r.width, 1), color);
+	addRectangle(ofRectangle(r.x, r.y + 1, 1, r.height - 2), color);
+	addRectangle(ofRectangle(r.x + r.width - 1, r.y + 1, 1, r.height - 2), color);
+}
+
+void ofxBaseGui::addLine(const ofPoint & from, const ofPoint & to, const ofColor & color){
+	ofVec3f normal = (to - from).getPerpendicular(ofVec3f(0,0,1)) * .5;
+	ofFloatColor c = color;
+	shapesMesh.addVertex(from + normal);
+	shapesMesh.addVertex(to + normal);
+	shapesMesh.addVertex(to - normal);
+	shapesMesh.addVertex(to - normal);
+	shapesMesh.addVertex(from - normal);
+	shapesMesh.addVertex(from + normal);
+	for(int i=0;i<6;i++){
+		shapesMesh.addColor(c);
+	}
+}
+
+void ofxBaseGui::addText(const string & text, float x, float y, const ofColor & color){
+	// the font meshes can be indexed, the batch uses plain triangles
+	// so the meshes of several elements can be concatenated as they are
+	ofMesh & mesh = getTextMesh(text, x, y);
+	ofFloatColor c = color;
+	int numVertices = mesh.getNumIndices() ? mesh.getNumIndices() : mesh.getNumVertices();
+	for(int i=0;i<numVertices;i++){
+		ofIndexType index = mesh.getNumIndices() ? mesh.getIndex(i) : i;
+		textMesh.addVertex(mesh.getVertex(index));
+		textMesh.addTexCoord(mesh.getTexCoord(index));
+		textMesh.addColor(c);
+	}
+
+	TextItem item;
+	item.text = text;
+	item.position.set(x, y);
+	item.color = color;
+	textItems.push_back(item);
+}
+
+void ofxBaseGui::renderGeometry(){
+	renderGeometry(shapesMesh, textMesh);
+}
+
+void ofxBaseGui::renderGeometry(ofVboMesh & shapes, ofVboMesh & text){
+	ofColor c = ofGetStyle().color;
+	ofBlendMode blendMode = ofGetStyle().blendingMode;
+	if(blendMode!=OF_BLENDMODE_ALPHA){
+		ofEnableAlphaBlending();
+	}
+
+	if(shapes.getNumVertices()){
+		shapes.draw();
+	}
+	if(text.getNumVertices()){
+		bindFontTexture();
+		text.draw();
+		unbindFontTexture();
+	}
+
+	ofSetColor(c);
+	if(blendMode!=OF_BLENDMODE_ALPHA){
+		ofEnableBlendMode(blendMode);
+	}
+}
+
 void ofxBaseGui::saveToFile(string filename) {
 	serializer->load(filename);
 	saveTo(*serializer);
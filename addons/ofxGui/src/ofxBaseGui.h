@@ -4,6 +4,10 @@
 #include "ofBaseTypes.h"
 #include "ofParameter.h"
 #include "ofTrueTypeFont.h"
+#include "ofVboMesh.h"
+#include <typeinfo>
+
+class ofxGuiGroup;
 
 class ofxBaseGui{
 public:
@@ -74,6 +78,36 @@ protected:
 	ofMesh & getTextMesh(const string & text, float x, float y);
 	ofRectangle getTextBoundingBox(const string & text,float x, float y);
 
+	// the shapes of the element as colored triangles and its text as
+	// textured ones, built in generateDraw() with the add* methods. groups
+	// copy the meshes of all their batchable elements into one mesh for
+	// shapes and one for text and draw the whole panel in two calls,
+	// render() is not called for batched elements.
+	// the elements in the addon only return true for their exact class so
+	// a subclass that overrides render() is drawn through draw(). a
+	// subclass that only draws through the add* methods can return true
+	virtual bool isBatchable();
+	void clearGeometry();
+	void addRectangle(const ofRectangle & r, const ofColor & color);
+	void addRectangleOutline(const ofRectangle & r, const ofColor & color);
+	void addLine(const ofPoint & from, const ofPoint & to, const ofColor & color);
+	void addText(const string & text, float x, float y, const ofColor & color);
+	void renderGeometry();
+	void renderGeometry(ofVboMesh & shapes, ofVboMesh & text);
+
+	ofVboMesh shapesMesh;
+	ofVboMesh textMesh;
+	unsigned int geometryVersion;		// incremented by clearGeometry()
+
+	// the strings in textMesh, to draw them with renderers that
+	// can't use the font texture, like cairo
+	struct TextItem{
+		string text;
+		ofPoint position;
+		ofColor color;
+	};
+	vector<TextItem> textItems;
+
 	ofRectangle b;
 	static ofTrueTypeFont font;
 	static bool fontLoaded;
@@ -102,5 +136,6 @@ protected:
 	virtual void generateDraw(){};
 
 private:
+	friend class ofxGuiGroup;
 	unsigned long currentFrame;
 }; 
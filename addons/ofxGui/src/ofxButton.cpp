@@ -52,3 +52,7 @@ void ofxButton::valueChanged(bool & v){
 		ofNotifyEvent(triggerEvent);
 	}
 }
+
+bool ofxButton::isBatchable(){
+	return typeid(*this) == typeid(ofxButton);
+}
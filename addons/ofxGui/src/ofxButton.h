@@ -26,6 +26,9 @@ public:
 		ofRemoveListener(triggerEvent,listener,method);
 	}
 
+protected:
+	virtual bool isBatchable();
+
 private:
 	ofEvent<void> triggerEvent;
 	void valueChanged(bool & v);
@@ -11,14 +11,24 @@ ofxGuiGroup::ofxGuiGroup(){
 	spacingNextElement = 3;
 	header = defaultHeight;
 	bGuiActive = false;
+	setupBatch();
 }
 
 ofxGuiGroup::ofxGuiGroup(const ofParameterGroup & parameters, string filename, float x, float y){
 	minimized = false;
 	parent = NULL;
+	setupBatch();
     setup(parameters, filename, x, y);
 }
 
+void ofxGuiGroup::setupBatch(){
+	bBatchRebuilt = false;
+	batchShapes.setMode(OF_PRIMITIVE_TRIANGLES);
+	batchText.setMode(OF_PRIMITIVE_TRIANGLES);
+	batchShapes.setUsage(GL_DYNAMIC_DRAW);
+	batchText.setUsage(GL_DYNAMIC_DRAW);
+}
+
 ofxGuiGroup * ofxGuiGroup::setup(string collectionName, string filename, float x, float y){
 	parameters.setName(collectionName);
 	return setup(parameters,filename,x,y);
@@ -176,6 +186,7 @@ void ofxGuiGroup::add(ofParameter<ofFloatColor> & parameter){
 
 void ofxGuiGroup::clear(){
 	collection.clear();
+	batch.clear();
 	b.height = header + spacing + spacingNextElement ;
 }
 
@@ -231,49 +242,197 @@ bool ofxGuiGroup::mouseReleased(ofMouseEventArgs & args){
 }
 
 void ofxGuiGroup::generateDraw(){
-	border.clear();
-	border.setFillColor(ofColor(thisBorderColor,180));
-	border.setFilled(true);
-	border.rectangle(b.x,b.y+ spacingNextElement,b.width+1,b.height);
-
+	clearGeometry();
 
-	headerBg.clear();
-	headerBg.setFillColor(thisHeaderBackgroundColor);
-	headerBg.setFilled(true);
-	headerBg.rectangle(b.x,b.y +1 + spacingNextElement, b.width, header);
+	addRectangle(ofRectangle(b.x,b.y+ spacingNextElement,b.width+1,b.height), ofColor(thisBorderColor,180));
+	addRectangle(ofRectangle(b.x,b.y +1 + spacingNextElement, b.width, header), thisHeaderBackgroundColor);
 
-	textMesh = getTextMesh(getName(), textPadding + b.x, header / 2 + 4 + b.y+ spacingNextElement);
+	addText(getName(), textPadding + b.x, header / 2 + 4 + b.y+ spacingNextElement, thisTextColor);
 	if(minimized){
-		textMesh.append(getTextMesh("+", b.width-textPadding-8 + b.x, header / 2 + 4+ b.y+ spacingNextElement));
+		addText("+", b.width-textPadding-8 + b.x, header / 2 + 4+ b.y+ spacingNextElement, thisTextColor);
 	}else{
-		textMesh.append(getTextMesh("-", b.width-textPadding-8 + b.x, header / 2 + 4 + b.y+ spacingNextElement));
+		addText("-", b.width-textPadding-8 + b.x, header / 2 + 4 + b.y+ spacingNextElement, thisTextColor);
 	}
 }
 
 void ofxGuiGroup::render(){
-	border.draw();
-	headerBg.draw();
+	updateBatch();
+	renderGeometry(batchShapes, batchText);
 
-	ofBlendMode blendMode = ofGetStyle().blendingMode;
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableAlphaBlending();
+	for(int i = 0; i < (int)batchOthers.size(); i++){
+		batchOthers[i]->draw();
 	}
-	ofColor c = ofGetStyle().color;
-	ofSetColor(thisTextColor);
+}
 
-	bindFontTexture();
-	textMesh.draw();
-	unbindFontTexture();
-    
-	if(!minimized){
-		for(int i = 0; i < (int)collection.size(); i++){
-			collection[i]->draw();
+bool ofxGuiGroup::isBatchable(){
+	return typeid(*this) == typeid(ofxGuiGroup);
+}
+
+void ofxGuiGroup::collectBatchElements(vector<ofxBaseGui*> & elements, vector<ofxBaseGui*> & others){
+	elements.push_back(this);
+	if(minimized) return;
+
+	for(int i = 0; i < (int)collection.size(); i++){
+		ofxBaseGui * element = collection[i];
+		if(!element->isBatchable()){
+			others.push_back(element);
+			continue;
+		}
+
+		// batched elements are not drawn through draw() so they
+		// need to be told they are visible for the mouse events
+		element->currentFrame = ofGetFrameNum();
+		ofxGuiGroup * group = dynamic_cast<ofxGuiGroup*>(element);
+		if(group){
+			group->collectBatchElements(elements, others);
+		}else{
+			elements.push_back(element);
+		}
+	}
+}
+
+// room for a few more quads so values that change length, like
+// slider numbers, or a toggle's cross don't need to rebuild the batch
+static int batchCapacity(int numVertices, int numQuads){
+	int slack = numQuads * 6;
+	return (numVertices / slack + 1) * slack;
+}
+
+static void copyToBatch(const ofMesh & src, ofMesh & dst, int first, int capacity){
+	int numVertices = src.getNumVertices();
+	bool bTexCoords = src.getNumTexCoords()>0;
+	for(int i = 0; i < numVertices; i++){
+		dst.setVertex(first + i, src.getVertex(i));
+		dst.setColor(first + i, src.getColor(i));
+		if(bTexCoords){
+			dst.setTexCoord(first + i, src.getTexCoord(i));
+		}
+	}
+	// the unused part of the range as degenerate triangles
+	for(int i = numVertices; i < capacity; i++){
+		dst.setVertex(first + i, ofVec3f());
+	}
+}
+
+static void addToBatch(const ofMesh & src, ofMesh & dst, int capacity, bool bTexCoords){
+	int numVertices = src.getNumVertices();
+	dst.addVertices(src.getVertices());
+	dst.addColors(src.getColors());
+	if(bTexCoords){
+		dst.addTexCoords(src.getTexCoords());
+	}
+	for(int i = numVertices; i < capacity; i++){
+		dst.addVertex(ofVec3f());
+		dst.addColor(ofFloatColor(0,0));
+		if(bTexCoords){
+			dst.addTexCoord(ofVec2f());
+		}
+	}
+}
+
+void ofxGuiGroup::updateBatch(){
+	batchElements.clear();
+	batchOthers.clear();
+	batchChangedAreas.clear();
+	bBatchRebuilt = false;
+	collectBatchElements(batchElements, batchOthers);
+
+	// with the same elements as last time only the ranges of the ones
+	// that changed are copied, if the list of elements changed (added,
+	// minimized...) or one outgrew its range, everything is rebuilt
+	if(batchElements.size()!=batch.size()){
+		rebuildBatch();
+		return;
+	}
+	for(int i = 0; i < (int)batch.size(); i++){
+		BatchRange & range = batch[i];
+		ofxBaseGui * element = batchElements[i];
+		if(range.element!=element){
+			rebuildBatch();
+			return;
+		}
+		if(range.geometryVersion==element->geometryVersion){
+			continue;
+		}
+		if((int)element->shapesMesh.getNumVertices()>range.shapesCapacity ||
+				(int)element->textMesh.getNumVertices()>range.textCapacity){
+			rebuildBatch();
+			return;
+		}
+		copyToBatch(element->shapesMesh, batchShapes, range.firstShape, range.shapesCapacity);
+		copyToBatch(element->textMesh, batchText, range.firstText, range.textCapacity);
+		range.geometryVersion = element->geometryVersion;
+
+		ofRectangle bounds = getGeometryBounds(element);
+		batchChangedAreas.push_back(range.bounds);
+		if(bounds!=range.bounds){
+			batchChangedAreas.push_back(bounds);
+			range.bounds = bounds;
+			batchBounds.growToInclude(bounds);
 		}
 	}
+}
 
-	ofSetColor(c);
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableBlendMode(blendMode);
+void ofxGuiGroup::rebuildBatch(){
+	batch.resize(batchElements.size());
+	batchShapes.clear();
+	batchText.clear();
+	bBatchRebuilt = true;
+	for(int i = 0; i < (int)batchElements.size(); i++){
+		BatchRange & range = batch[i];
+		ofxBaseGui * element = batchElements[i];
+		range.element = element;
+		range.geometryVersion = element->geometryVersion;
+
+		range.firstShape = batchShapes.getNumVertices();
+		range.shapesCapacity = batchCapacity(element->shapesMesh.getNumVertices(), 2);
+		addToBatch(element->shapesMesh, batchShapes, range.shapesCapacity, false);
+
+		range.firstText = batchText.getNumVertices();
+		range.textCapacity = batchCapacity(element->textMesh.getNumVertices(), 8);
+		addToBatch(element->textMesh, batchText, range.textCapacity, true);
+
+		range.bounds = getGeometryBounds(element);
+		if(i==0){
+			batchBounds = range.bounds;
+		}else{
+			batchBounds.growToInclude(range.bounds);
+		}
+	}
+}
+
+ofRectangle ofxGuiGroup::getGeometryBounds(ofxBaseGui * element){
+	ofRectangle bounds(element->b);
+	const vector<ofVec3f> & shapes = ((const ofMesh&)element->shapesMesh).getVertices();
+	for(int i = 0; i < (int)shapes.size(); i++){
+		bounds.growToInclude(shapes[i]);
+	}
+	const vector<ofVec3f> & text = ((const ofMesh&)element->textMesh).getVertices();
+	for(int i = 0; i < (int)text.size(); i++){
+		bounds.growToInclude(text[i]);
+	}
+	return bounds;
+}
+
+void ofxGuiGroup::renderBatch(ofBaseRenderer & renderer, const ofRectangle & area){
+	renderer.setFillMode(OF_FILLED);
+	for(int i = 0; i < (int)batch.size(); i++){
+		if(!batch[i].bounds.intersects(area)) continue;
+
+		ofxBaseGui * element = batch[i].element;
+		const ofMesh & shapes = element->shapesMesh;
+		for(int j = 0; j + 2 < (int)shapes.getNumVertices(); j += 3){
+			const ofVec3f & v0 = shapes.getVertices()[j];
+			const ofVec3f & v1 = shapes.getVertices()[j+1];
+			const ofVec3f & v2 = shapes.getVertices()[j+2];
+			renderer.setColor(ofColor(shapes.getColors()[j]));
+			renderer.drawTriangle(v0.x, v0.y, 0, v1.x, v1.y, 0, v2.x, v2.y, 0);
+		}
+		for(int j = 0; j < (int)element->textItems.size(); j++){
+			const ofxBaseGui::TextItem & item = element->textItems[j];
+			renderer.setColor(item.color);
+			renderer.drawString(item.text, item.position.x, item.position.y, 0, OF_BITMAPMODE_SIMPLE);
+		}
 	}
 }
 
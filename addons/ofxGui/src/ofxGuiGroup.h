@@ -59,6 +59,7 @@ public:
 	virtual void setPosition(float x, float y);
 protected:
 	virtual void render();
+	virtual bool isBatchable();
     void registerMouseEvents();
     void unregisterMouseEvents();
     virtual bool setValue(float mx, float my, bool bCheck);
@@ -80,8 +81,41 @@ protected:
 	bool bGuiActive;
 
 	ofxGuiGroup * parent;
-	ofPath border, headerBg;
-	ofVboMesh textMesh;
+
+	// the geometry of this group and every batchable element inside it,
+	// nested groups included, concatenated in two meshes so the whole
+	// group is drawn in two calls. every element has a range of vertices
+	// with some room to grow, when its geometry changes only that range
+	// is copied and uploaded again
+	struct BatchRange{
+		ofxBaseGui * element;
+		unsigned int geometryVersion;
+		int firstShape, shapesCapacity;
+		int firstText, textCapacity;
+		ofRectangle bounds;
+	};
+	void setupBatch();
+	void collectBatchElements(vector<ofxBaseGui*> & elements, vector<ofxBaseGui*> & others);
+	void updateBatch();
+	void rebuildBatch();
+	ofRectangle getGeometryBounds(ofxBaseGui * element);
+
+	// draws the batched elements that intersect area with the shape and
+	// string primitives of a renderer, for renderers that can't draw
+	// the batch meshes like cairo
+	void renderBatch(ofBaseRenderer & renderer, const ofRectangle & area);
+
+	vector<BatchRange> batch;
+	vector<ofxBaseGui*> batchElements;
+	vector<ofxBaseGui*> batchOthers;	// elements that draw themselves
+	ofVboMesh batchShapes, batchText;
+
+	// what the last updateBatch() changed: the area covered by the
+	// geometry of every element before and after changing, or
+	// everything if the batch had to be rebuilt
+	vector<ofRectangle> batchChangedAreas;
+	ofRectangle batchBounds;
+	bool bBatchRebuilt;
 };
 
 template<class ControlType>
@@ -24,39 +24,24 @@ ofxLabel* ofxLabel::setup(string labelName, string _label, float width, float he
 }
 
 void ofxLabel::generateDraw(){
-	bg.clear();
+	clearGeometry();
 
-	bg.setFillColor(thisBackgroundColor);
-	bg.setFilled(true);
-	bg.rectangle(b);
+	addRectangle(b, thisBackgroundColor);
 
     string name;
     if(!getName().empty()){
     	name = getName() + ": ";
     }
 
-    textMesh = getTextMesh(name + (string)label, b.x + textPadding, b.y + b.height / 2 + 4);
+    addText(name + (string)label, b.x + textPadding, b.y + b.height / 2 + 4, thisTextColor);
 }
 
 void ofxLabel::render() {
-	ofColor c = ofGetStyle().color;
-
-	bg.draw();
-
-	ofBlendMode blendMode = ofGetStyle().blendingMode;
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableAlphaBlending();
-	}
-    ofSetColor(textColor);
-
-    bindFontTexture();
-    textMesh.draw();
-    unbindFontTexture();
+	renderGeometry();
+}
 
-    ofSetColor(c);
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableBlendMode(blendMode);
-	}
+bool ofxLabel::isBatchable(){
+	return typeid(*this) == typeid(ofxLabel);
 }
 
 ofAbstractParameter & ofxLabel::getParameter(){
@@ -40,10 +40,9 @@ public:
 
 protected:
     void render();
+    bool isBatchable();
     ofParameter<string> label;
     void generateDraw();
     void valueChanged(string & value);
     bool setValue(float mx, float my, bool bCheckBounds){return false;}
-    ofPath bg;
-    ofVboMesh textMesh;
 };
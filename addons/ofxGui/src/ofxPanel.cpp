@@ -8,16 +8,29 @@
 #include "ofxPanel.h"
 #include "ofGraphics.h"
 #include "ofImage.h"
+#ifndef TARGET_OPENGLES
+#include "ofCairoRenderer.h"
+#endif
 
 ofImage ofxPanel::loadIcon;
 ofImage ofxPanel::saveIcon;
 
 ofxPanel::ofxPanel()
-:bGrabbed(false){}
+:bGrabbed(false)
+,bCache(false)
+,cacheType(CACHE_FBO)
+,bCacheVFlipped(true)
+,numCacheFullRedraws(0)
+,numCachePartialRedraws(0){}
 
 ofxPanel::ofxPanel(const ofParameterGroup & parameters, string filename, float x, float y)
 : ofxGuiGroup(parameters, filename, x, y)
-, bGrabbed(false){
+, bGrabbed(false)
+, bCache(false)
+, cacheType(CACHE_FBO)
+, bCacheVFlipped(true)
+, numCacheFullRedraws(0)
+, numCachePartialRedraws(0){
 }
 
 ofxPanel::~ofxPanel(){
@@ -43,27 +56,27 @@ ofxPanel * ofxPanel::setup(const ofParameterGroup & parameters, string filename,
 void ofxPanel::loadIcons(){
 	unsigned char loadIconData[] = {0x38,0x88,0xa,0x6,0x7e,0x60,0x50,0x11,0x1c};
 	unsigned char saveIconData[] = {0xff,0x4a,0x95,0xea,0x15,0xa8,0x57,0xa9,0x7f};
+	// without a gl renderer, like with ofAppNoWindow, the icons are
+	// only drawn into the pixels cache and don't need textures
+	bool bUseTexture = ofGetGLRenderer().get() != NULL;
+	loadIcon.setUseTexture(bUseTexture);
+	saveIcon.setUseTexture(bUseTexture);
 	loadIcon.allocate(9, 8, OF_IMAGE_COLOR_ALPHA);
 	saveIcon.allocate(9, 8, OF_IMAGE_COLOR_ALPHA);
 	loadStencilFromHex(loadIcon, loadIconData);
 	loadStencilFromHex(saveIcon, saveIconData);
 
-	loadIcon.getTextureReference().setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
-	saveIcon.getTextureReference().setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	if(bUseTexture){
+		loadIcon.getTextureReference().setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+		saveIcon.getTextureReference().setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	}
 }
 
 void ofxPanel::generateDraw(){
-	border.clear();
-	border.setStrokeColor(thisBorderColor);
-	border.setStrokeWidth(1);
-	border.setFilled(false);
-	border.rectangle(b.x,b.y,b.width+1,b.height-spacingNextElement);
-
+	clearGeometry();
 
-	headerBg.clear();
-	headerBg.setFillColor(ofColor(thisHeaderBackgroundColor,180));
-	headerBg.setFilled(true);
-	headerBg.rectangle(b.x,b.y+1,b.width,header);
+	addRectangleOutline(ofRectangle(b.x,b.y,b.width+1,b.height-spacingNextElement), thisBorderColor);
+	addRectangle(ofRectangle(b.x,b.y+1,b.width,header), ofColor(thisHeaderBackgroundColor,180));
 
 	float iconHeight = header*.5;
 	float iconWidth = loadIcon.getWidth()/loadIcon.getHeight()*iconHeight;
@@ -76,13 +89,15 @@ void ofxPanel::generateDraw(){
 	saveBox.set(loadBox);
 	saveBox.x += iconWidth + iconSpacing;
 
-	textMesh = getTextMesh(getName(), textPadding + b.x, header / 2 + 4 + b.y);
+	addText(getName(), textPadding + b.x, header / 2 + 4 + b.y, thisTextColor);
 }
 
-void ofxPanel::render(){
-	border.draw();
-	headerBg.draw();
+bool ofxPanel::isBatchable(){
+	return typeid(*this) == typeid(ofxPanel);
+}
 
+void ofxPanel::drawIcons(){
+	// the icons are drawn as textured quads on top of the batch
 	ofBlendMode blendMode = ofGetStyle().blendingMode;
 	if(blendMode!=OF_BLENDMODE_ALPHA){
 		ofEnableAlphaBlending();
@@ -90,10 +105,6 @@ void ofxPanel::render(){
 	ofColor c = ofGetStyle().color;
 	ofSetColor(thisTextColor);
 
-	bindFontTexture();
-	textMesh.draw();
-	unbindFontTexture();
-
 	bool texHackEnabled = ofIsTextureEdgeHackEnabled();
 	ofDisableTextureEdgeHack();
 	loadIcon.draw(loadBox);
@@ -102,16 +113,294 @@ void ofxPanel::render(){
 		ofEnableTextureEdgeHack();
 	}
 
-	for(int i = 0; i < (int)collection.size(); i++){
-		collection[i]->draw();
-	}
-
 	ofSetColor(c);
 	if(blendMode!=OF_BLENDMODE_ALPHA){
 		ofEnableBlendMode(blendMode);
 	}
 }
 
+#ifndef TARGET_OPENGLES
+// cairo can't tint images, the alpha of the icon is used as a mask
+// for the text color instead
+static void drawIcon(cairo_t * cr, ofImage & icon, const ofRectangle & box, const ofColor & color){
+	int width = icon.getWidth();
+	int height = icon.getHeight();
+	int stride = cairo_format_stride_for_width(CAIRO_FORMAT_A8, width);
+	vector<unsigned char> alpha(stride * height);
+	for(int y = 0; y < height; y++){
+		for(int x = 0; x < width; x++){
+			alpha[y * stride + x] = icon.getColor(x, y).a;
+		}
+	}
+	cairo_surface_t * mask = cairo_image_surface_create_for_data(&alpha[0], CAIRO_FORMAT_A8, width, height, stride);
+
+	cairo_save(cr);
+	cairo_translate(cr, box.x, box.y);
+	cairo_scale(cr, box.width / width, box.height / height);
+	cairo_set_source_rgba(cr, color.r / 255., color.g / 255., color.b / 255., color.a / 255.);
+	cairo_pattern_t * pattern = cairo_pattern_create_for_surface(mask);
+	cairo_pattern_set_filter(pattern, CAIRO_FILTER_NEAREST);
+	cairo_mask(cr, pattern);
+	cairo_pattern_destroy(pattern);
+	cairo_restore(cr);
+
+	cairo_surface_destroy(mask);
+}
+#endif
+
+void ofxPanel::enableCache(CacheType type){
+	bCache = true;
+	cacheType = type;
+	cacheArea.set(0,0,0,0);
+	numCacheFullRedraws = 0;
+	numCachePartialRedraws = 0;
+}
+
+void ofxPanel::disableCache(){
+	bCache = false;
+	cacheFbo = ofFbo();
+#ifndef TARGET_OPENGLES
+	cacheRenderer.reset();
+#endif
+	cachePixels.clear();
+}
+
+bool ofxPanel::getUsingCache(){
+	return bCache;
+}
+
+ofFbo & ofxPanel::getCacheFbo(){
+	return cacheFbo;
+}
+
+ofPixels & ofxPanel::getCachePixels(){
+	return cachePixels;
+}
+
+ofRectangle ofxPanel::getCacheArea(){
+	return cacheArea;
+}
+
+int ofxPanel::getNumCacheFullRedraws(){
+	return numCacheFullRedraws;
+}
+
+int ofxPanel::getNumCachePartialRedraws(){
+	return numCachePartialRedraws;
+}
+
+// whole pixels containing r
+static ofRectangle pixelBounds(const ofRectangle & r){
+	float x = floor(r.getMinX());
+	float y = floor(r.getMinY());
+	return ofRectangle(x, y, ceil(r.getMaxX()) - x, ceil(r.getMaxY()) - y);
+}
+
+void ofxPanel::render(){
+	if(!bCache){
+		ofxGuiGroup::render();
+		drawIcons();
+		return;
+	}
+
+	updateCache();
+
+	// with CACHE_PIXELS everything, even the elements that
+	// can't be batched, is already in the pixels
+	if(cacheType!=CACHE_FBO) return;
+
+	if(cacheFbo.isAllocated()){
+		// the cache has premultiplied alpha
+		bool texHackEnabled = ofIsTextureEdgeHackEnabled();
+		ofDisableTextureEdgeHack();
+		ofPushStyle();
+		ofEnableAlphaBlending();
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		ofSetColor(255);
+		cacheFbo.draw(cacheArea.x, cacheArea.y);
+		ofPopStyle();
+		if(texHackEnabled){
+			ofEnableTextureEdgeHack();
+		}
+	}
+
+	for(int i = 0; i < (int)batchOthers.size(); i++){
+		batchOthers[i]->draw();
+	}
+}
+
+void ofxPanel::updateCache(){
+	updateBatch();
+
+	ofRectangle bounds = batchBounds;
+	if(cacheType!=CACHE_FBO){
+		for(int i = 0; i < (int)batchOthers.size(); i++){
+			bounds.growToInclude(batchOthers[i]->getShape());
+		}
+	}
+	ofRectangle area = pixelBounds(bounds);
+	if(area.width<=0 || area.height<=0) return;
+
+	bool bFullRedraw = bBatchRebuilt || area!=cacheArea;
+	// the fbo is flipped differently depending on the orientation
+	if(cacheType==CACHE_FBO && ofIsVFlipped()!=bCacheVFlipped){
+		bCacheVFlipped = ofIsVFlipped();
+		bFullRedraw = true;
+	}
+	if(area.width!=cacheArea.width || area.height!=cacheArea.height){
+		if(cacheType==CACHE_FBO){
+			cacheFbo.allocate(area.width, area.height, GL_RGBA);
+			cacheFbo.getTextureReference().setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+		}else{
+#ifndef TARGET_OPENGLES
+			cacheRenderer = ofPtr<ofCairoRenderer>(new ofCairoRenderer);
+			cacheRenderer->setupMemoryOnly(ofCairoRenderer::IMAGE, false, false, ofRectangle(0, 0, area.width, area.height));
+			cachePixels.allocate(area.width, area.height, OF_PIXELS_RGBA);
+#endif
+		}
+		bFullRedraw = true;
+	}
+	cacheArea = area;
+
+	vector<ofRectangle> areas;
+	if(bFullRedraw){
+		areas.push_back(cacheArea);
+	}else{
+		vector<ofRectangle> changedAreas = batchChangedAreas;
+		if(cacheType!=CACHE_FBO){
+			// there's no way to know if the elements that can't be
+			// batched changed, they are redrawn every frame
+			for(int i = 0; i < (int)batchOthers.size(); i++){
+				changedAreas.push_back(batchOthers[i]->getShape());
+			}
+		}
+		for(int i = 0; i < (int)changedAreas.size(); i++){
+			ofRectangle changed = pixelBounds(changedAreas[i]).getIntersection(cacheArea);
+			if(changed.width>0 && changed.height>0){
+				areas.push_back(changed);
+			}
+		}
+		// every area is drawn separately, with many of them it's
+		// faster to redraw everything that changed at once
+		const int maxAreas = 8;
+		if((int)areas.size()>maxAreas){
+			for(int i = 1; i < (int)areas.size(); i++){
+				areas[0].growToInclude(areas[i]);
+			}
+			areas.resize(1);
+		}
+	}
+	if(areas.empty()) return;
+
+	if(bFullRedraw){
+		numCacheFullRedraws++;
+	}else{
+		numCachePartialRedraws++;
+	}
+	if(cacheType==CACHE_FBO){
+		redrawFbo(areas);
+	}else{
+#ifndef TARGET_OPENGLES
+		redrawPixels(areas);
+#endif
+	}
+}
+
+void ofxPanel::redrawFbo(const vector<ofRectangle> & areas){
+	ofPushStyle();
+	cacheFbo.begin();
+	ofPushMatrix();
+	ofTranslate(-cacheArea.x, -cacheArea.y);
+
+	// colors are blended as usual but alpha accumulates, so the fbo ends
+	// with premultiplied alpha and looks the same blended over the scene
+	// as the panel drawn directly
+	ofEnableAlphaBlending();
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+	glEnable(GL_SCISSOR_TEST);
+	for(int i = 0; i < (int)areas.size(); i++){
+		ofRectangle area = areas[i];
+		area.translate(-cacheArea.x, -cacheArea.y);
+		if(!ofIsVFlipped()){
+			area.y = cacheFbo.getHeight() - area.getMaxY();
+		}
+		glScissor(area.x, area.y, area.width, area.height);
+		ofClear(0, 0, 0, 0);
+		renderGeometry(batchShapes, batchText);
+		drawIcons();
+	}
+	glDisable(GL_SCISSOR_TEST);
+
+	ofPopMatrix();
+	cacheFbo.end();
+	ofPopStyle();
+}
+
+#ifndef TARGET_OPENGLES
+void ofxPanel::redrawPixels(const vector<ofRectangle> & areas){
+	cairo_t * cr = cacheRenderer->getCairoContext();
+	// the elements that can't be batched draw through the current renderer
+	ofPtr<ofBaseRenderer> previousRenderer = ofGetCurrentRenderer();
+	if(!batchOthers.empty()){
+		ofSetCurrentRenderer(cacheRenderer);
+	}
+	for(int i = 0; i < (int)areas.size(); i++){
+		ofRectangle area = areas[i];
+		area.translate(-cacheArea.x, -cacheArea.y);
+
+		cairo_save(cr);
+		cairo_rectangle(cr, area.x, area.y, area.width, area.height);
+		cairo_clip(cr);
+		cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+		cairo_paint(cr);
+		cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+		// the shapes are triangles that share edges, antialiasing
+		// would show the seams
+		cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
+		cacheRenderer->pushMatrix();
+		cacheRenderer->translate(-cacheArea.x, -cacheArea.y);
+		renderBatch(*cacheRenderer, areas[i]);
+		drawIcon(cr, loadIcon, loadBox, thisTextColor);
+		drawIcon(cr, saveIcon, saveBox, thisTextColor);
+		for(int j = 0; j < (int)batchOthers.size(); j++){
+			if(batchOthers[j]->getShape().intersects(areas[i])){
+				batchOthers[j]->draw();
+			}
+		}
+		cacheRenderer->popMatrix();
+		cairo_restore(cr);
+	}
+	cacheRenderer->flush();
+	if(!batchOthers.empty() && previousRenderer){
+		ofSetCurrentRenderer(previousRenderer);
+	}
+
+	// cairo stores premultiplied BGRA
+	ofPixels & surface = cacheRenderer->getImageSurfacePixels();
+	int width = cachePixels.getWidth();
+	for(int i = 0; i < (int)areas.size(); i++){
+		ofRectangle area = areas[i];
+		area.translate(-cacheArea.x, -cacheArea.y);
+		for(int y = area.y; y < area.getMaxY(); y++){
+			const unsigned char * src = surface.getPixels() + (y * width + (int)area.x) * 4;
+			unsigned char * dst = cachePixels.getPixels() + (y * width + (int)area.x) * 4;
+			for(int x = 0; x < area.width; x++, src += 4, dst += 4){
+				int a = src[3];
+				if(a==0){
+					dst[0] = dst[1] = dst[2] = dst[3] = 0;
+				}else{
+					dst[0] = src[2] * 255 / a;
+					dst[1] = src[1] * 255 / a;
+					dst[2] = src[0] * 255 / a;
+					dst[3] = a;
+				}
+			}
+		}
+	}
+}
+#endif
+
 bool ofxPanel::mouseReleased(ofMouseEventArgs & args){
     this->bGrabbed = false;
     if(ofxGuiGroup::mouseReleased(args)) return true;
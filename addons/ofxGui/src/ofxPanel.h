@@ -1,8 +1,12 @@
 #pragma once
 
 #include "ofxGuiGroup.h"
+#include "ofFbo.h"
 
 class ofxGuiGroup;
+#ifndef TARGET_OPENGLES
+class ofCairoRenderer;
+#endif
 
 class ofxPanel : public ofxGuiGroup {
 public:
@@ -15,17 +19,69 @@ public:
 
 	bool mouseReleased(ofMouseEventArgs & args);
 
+	// renders the panel into a cache and only redraws the areas of the
+	// elements that changed since the last frame, drawing the panel is
+	// then just drawing the cache. with CACHE_FBO the cache is an fbo,
+	// with CACHE_PIXELS it's rendered in memory with cairo, for apps
+	// without a gl context, and draw() only updates the pixels.
+	// cairo is not available with opengles so there's only CACHE_FBO
+	//
+	// Info:
+	// elements that aren't batchable (see ofxBaseGui::isBatchable()) are
+	// drawn every frame, on top of the fbo with CACHE_FBO and into their
+	// area of the pixels with CACHE_PIXELS. with CACHE_PIXELS they are
+	// drawn through the cairo renderer, so anything they draw with gl
+	// calls or textures is missing from the pixels
+	// moving or resizing the panel redraws the whole cache
+	enum CacheType{
+		CACHE_FBO
+#ifndef TARGET_OPENGLES
+		,CACHE_PIXELS
+#endif
+	};
+	void enableCache(CacheType type=CACHE_FBO);
+	void disableCache();
+	bool getUsingCache();
+
+	ofFbo & getCacheFbo();
+	ofPixels & getCachePixels();	// RGBA, only updated with CACHE_PIXELS
+	ofRectangle getCacheArea();		// what the cache covers, in screen coordinates
+
+	// how many times the whole cache or only some areas of it were
+	// redrawn since it was enabled
+	int getNumCacheFullRedraws();
+	int getNumCachePartialRedraws();
+
 	ofEvent<void> loadPressedE;
 	ofEvent<void> savePressedE;
 protected:
 	void render();
+	bool isBatchable();
 	bool setValue(float mx, float my, bool bCheck);
 	void generateDraw();
 	void loadIcons();
+	void drawIcons();
+	void updateCache();
+	void redrawFbo(const vector<ofRectangle> & areas);
+#ifndef TARGET_OPENGLES
+	void redrawPixels(const vector<ofRectangle> & areas);
+#endif
 private:
 	ofRectangle loadBox, saveBox;
 	static ofImage loadIcon, saveIcon;
     
     ofPoint grabPt;
 	bool bGrabbed;
+
+	bool bCache;
+	CacheType cacheType;
+	bool bCacheVFlipped;
+	ofRectangle cacheArea;
+	ofFbo cacheFbo;
+#ifndef TARGET_OPENGLES
+	ofPtr<ofCairoRenderer> cacheRenderer;
+#endif
+	ofPixels cachePixels;
+	int numCacheFullRedraws;
+	int numCachePartialRedraws;
 };
@@ -97,17 +97,12 @@ ofxSlider<Type>::operator const Type & (){
 
 template<typename Type>
 void ofxSlider<Type>::generateDraw(){
-	bg.clear();
-	bar.clear();
+	clearGeometry();
 
-	bg.setFillColor(thisBackgroundColor);
-	bg.setFilled(true);
-	bg.rectangle(b);
+	addRectangle(b, thisBackgroundColor);
 
 	float valAsPct = ofMap( value, value.getMin(), value.getMax(), 0, b.width-2, true );
-	bar.setFillColor(thisFillColor);
-	bar.setFilled(true);
-	bar.rectangle(b.x+1, b.y+1, valAsPct, b.height-2);
+	addRectangle(ofRectangle(b.x+1, b.y+1, valAsPct, b.height-2), thisFillColor);
 
 	generateText();
 }
@@ -116,38 +111,25 @@ void ofxSlider<Type>::generateDraw(){
 template<typename Type>
 void ofxSlider<Type>::generateText(){
 	string valStr = ofToString(value);
-	textMesh = getTextMesh(getName(), b.x + textPadding, b.y + b.height / 2 + 4);
-	textMesh.append(getTextMesh(valStr, b.x + b.width - textPadding - getTextBoundingBox(valStr,0,0).width, b.y + b.height / 2 + 4));
+	addText(getName(), b.x + textPadding, b.y + b.height / 2 + 4, thisTextColor);
+	addText(valStr, b.x + b.width - textPadding - getTextBoundingBox(valStr,0,0).width, b.y + b.height / 2 + 4, thisTextColor);
 }
 
 template<>
 void ofxSlider<unsigned char>::generateText(){
 	string valStr = ofToString((int)value);
-	textMesh = getTextMesh(getName(), b.x + textPadding, b.y + b.height / 2 + 4);
-	textMesh.append(getTextMesh(valStr, b.x + b.width - textPadding - getTextBoundingBox(valStr,0,0).width, b.y + b.height / 2 + 4));
+	addText(getName(), b.x + textPadding, b.y + b.height / 2 + 4, thisTextColor);
+	addText(valStr, b.x + b.width - textPadding - getTextBoundingBox(valStr,0,0).width, b.y + b.height / 2 + 4, thisTextColor);
 }
 
 template<typename Type>
 void ofxSlider<Type>::render(){
-	ofColor c = ofGetStyle().color;
-
-	bg.draw();
-	bar.draw();
-
-	ofBlendMode blendMode = ofGetStyle().blendingMode;
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableAlphaBlending();
-	}
-	ofSetColor(thisTextColor);
-
-	bindFontTexture();
-	textMesh.draw();
-	unbindFontTexture();
+	renderGeometry();
+}
 
-	ofSetColor(c);
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableBlendMode(blendMode);
-	}
+template<typename Type>
+bool ofxSlider<Type>::isBatchable(){
+	return typeid(*this) == typeid(ofxSlider<Type>);
 }
 
 
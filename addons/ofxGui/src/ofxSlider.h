@@ -43,6 +43,7 @@ public:
 
 protected:
 	virtual void render();
+	virtual bool isBatchable();
 	ofParameter<Type> value;
 	bool bUpdateOnReleaseOnly;
 	bool bGuiActive;
@@ -50,8 +51,6 @@ protected:
 	void generateDraw();
 	void generateText();
 	void valueChanged(Type & value);
-	ofPath bg, bar;
-	ofVboMesh textMesh;
 };
 
 typedef ofxSlider<float> ofxFloatSlider;
@@ -64,6 +64,11 @@ ofAbstractParameter & ofxVecSlider_<VecType>::getParameter(){
 	return value;
 }
 
+template<class VecType>
+bool ofxVecSlider_<VecType>::isBatchable(){
+	return typeid(*this) == typeid(ofxVecSlider_<VecType>);
+}
+
 template<class VecType>
 VecType ofxVecSlider_<VecType>::operator=(const VecType & v){
 	value = v;
@@ -155,6 +160,11 @@ ofAbstractParameter & ofxColorSlider_<ColorType>::getParameter(){
 	return value;
 }
 
+template<class ColorType>
+bool ofxColorSlider_<ColorType>::isBatchable(){
+	return typeid(*this) == typeid(ofxColorSlider_<ColorType>);
+}
+
 template<class ColorType>
 ofColor_<ColorType> ofxColorSlider_<ColorType>::operator=(const ofColor_<ColorType> & v){
 	value = v;
@@ -20,6 +20,7 @@ public:
 	operator const VecType & ();
 	const VecType * operator->();
 protected:
+    bool isBatchable();
     void changeSlider(const void * parameter, float & value);
     void changeValue(VecType & value);
     ofParameter<VecType> value;
@@ -48,6 +49,7 @@ public:
 	ofColor_<ColorType> operator=(const ofColor_<ColorType> & v);
 	operator const ofColor_<ColorType> & ();
 protected:
+    bool isBatchable();
     void changeSlider(const void * parameter, ColorType & value);
     void changeValue(ofColor_<ColorType> & value);
     ofParameter<ofColor_<ColorType> > value;
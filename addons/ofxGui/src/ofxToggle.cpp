@@ -68,56 +68,28 @@ bool ofxToggle::mouseReleased(ofMouseEventArgs & args){
 }
 
 void ofxToggle::generateDraw(){
-	bg.clear();
-	bg.setFillColor(thisBackgroundColor);
-	bg.rectangle(b);
+	clearGeometry();
 
-	fg.clear();
+	addRectangle(b, thisBackgroundColor);
+
+	ofRectangle checkbox(b.getPosition()+checkboxRect.getTopLeft(),checkboxRect.width,checkboxRect.height);
 	if(value){
-		fg.setFilled(true);
-		fg.setFillColor(thisFillColor);
+		addRectangle(checkbox, thisFillColor);
+		addLine(checkbox.getTopLeft(), checkbox.getBottomRight(), thisTextColor);
+		addLine(checkbox.getTopRight(), checkbox.getBottomLeft(), thisTextColor);
 	}else{
-		fg.setFilled(false);
-		fg.setStrokeWidth(1);
-		fg.setStrokeColor(thisFillColor);
+		addRectangleOutline(checkbox, thisFillColor);
 	}
-	fg.rectangle(b.getPosition()+checkboxRect.getTopLeft(),checkboxRect.width,checkboxRect.height);
-
-	cross.clear();
-	cross.setStrokeColor(thisTextColor);
-	cross.setStrokeWidth(1);
-	cross.setFilled(false);
-	cross.moveTo(b.getPosition()+checkboxRect.getTopLeft());
-	cross.lineTo(b.getPosition()+checkboxRect.getBottomRight());
-	cross.moveTo(b.getPosition()+checkboxRect.getTopRight());
-	cross.lineTo(b.getPosition()+checkboxRect.getBottomLeft());
 
-	textMesh = getTextMesh(getName(), b.x+textPadding + checkboxRect.width, b.y+b.height / 2 + 4);
+	addText(getName(), b.x+textPadding + checkboxRect.width, b.y+b.height / 2 + 4, thisTextColor);
 }
 
 void ofxToggle::render(){
-	bg.draw();
-	fg.draw();
-
-	if( value ){
-		cross.draw();
-	}
-
-	ofColor c = ofGetStyle().color;
-	ofBlendMode blendMode = ofGetStyle().blendingMode;
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableAlphaBlending();
-	}
-	ofSetColor(thisTextColor);
-
-	bindFontTexture();
-	textMesh.draw();
-	unbindFontTexture();
+	renderGeometry();
+}
 
-	ofSetColor(c);
-	if(blendMode!=OF_BLENDMODE_ALPHA){
-		ofEnableBlendMode(blendMode);
-	}
+bool ofxToggle::isBatchable(){
+	return typeid(*this) == typeid(ofxToggle);
 }
 
 bool ofxToggle::operator=(bool v){
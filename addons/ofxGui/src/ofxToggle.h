@@ -37,6 +37,7 @@ public:
 
 protected:
 	virtual void render();
+	virtual bool isBatchable();
 	ofRectangle checkboxRect;
 	ofParameter<bool> value;
 	bool bGuiActive;
@@ -44,6 +45,4 @@ protected:
 	bool setValue(float mx, float my, bool bCheck);
 	void generateDraw();
 	void valueChanged(bool & value);
-	ofPath bg,fg,cross;
-	ofVboMesh textMesh;
 };
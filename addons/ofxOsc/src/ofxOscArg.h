@@ -29,6 +29,7 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofFileUtils.h"
 #include <string>
 
 typedef enum _ofxOscArgType
@@ -145,3 +146,22 @@ public:
 private:
 	std::string value;
 };
+
+class ofxOscArgBlob : public ofxOscArg
+{
+public:
+	ofxOscArgBlob( const ofBuffer & _value ) { value = _value; }
+	~ofxOscArgBlob() {};
+
+	/// return the type of this argument
+	ofxOscArgType getType() { return OFXOSC_TYPE_BLOB; }
+	string getTypeName() { return "blob"; }
+
+	/// return value
+	const ofBuffer & get() const { return value; }
+	/// set value
+	void set( const ofBuffer & _value ) { value = _value; }
+
+private:
+	ofBuffer value;
+};
@@ -6,10 +6,18 @@
  */
 
 #include "ofxOscParameterSync.h"
+#include "ofUtils.h"
 
 ofxOscParameterSync::ofxOscParameterSync() {
 	syncGroup = NULL;
 	updatingParameter = false;
+	lastSendTime = 0;
+	minSendInterval = 0;
+	maxPacketSize = 1472;
+	bSnapshots = false;
+	snapshotMinChanged = 32;
+	numPacketsSent = 0;
+	numParametersSent = 0;
 }
 
 ofxOscParameterSync::~ofxOscParameterSync(){
@@ -19,7 +27,11 @@ ofxOscParameterSync::~ofxOscParameterSync(){
 
 
 void ofxOscParameterSync::setup(ofParameterGroup & group, int localPort, string host, int remotePort){
+	if(syncGroup)
+		ofRemoveListener(syncGroup->parameterChangedE,this,&ofxOscParameterSync::parameterChanged);
 	syncGroup = &group;
+	changed.clear();
+	lastSent.clear();
 	ofAddListener(group.parameterChangedE,this,&ofxOscParameterSync::parameterChanged);
 	sender.setup(host,remotePort);
 	receiver.setup(localPort);
@@ -28,12 +40,159 @@ void ofxOscParameterSync::setup(ofParameterGroup & group, int localPort, string
 void ofxOscParameterSync::update(){
 	if(receiver.hasWaitingMessages()){
 		updatingParameter = true;
-		receiver.getParameter(*syncGroup);
+		string snapshotAddress = getSnapshotAddress();
+		ofxOscMessage msg;
+		while(receiver.getNextMessage(&msg)){
+			if(msg.getAddress()==snapshotAddress && msg.getNumArgs()==1 && msg.getArgType(0)==OFXOSC_TYPE_BLOB){
+				ofParameterSnapshot snapshot;
+				if(snapshot.loadFromBuffer(msg.getArgAsBlob(0))){
+					syncGroup->setSnapshot(snapshot,true);
+				}
+			}else{
+				receiver.getParameter(msg,*syncGroup);
+			}
+		}
 		updatingParameter = false;
 	}
+
+	if(!changed.empty()){
+		unsigned long long now = ofGetElapsedTimeMillis();
+		if(lastSendTime==0 || now - lastSendTime >= (unsigned long long)minSendInterval){
+			sendChanged();
+			lastSendTime = now;
+		}
+	}
 }
 
 void ofxOscParameterSync::parameterChanged( ofAbstractParameter & parameter ){
-	if(updatingParameter) return;
-	sender.sendParameter(parameter);
+	if(parameter.type()==typeid(ofParameterGroup).name()){
+		if(!updatingParameter) sender.sendParameter(parameter);
+		return;
+	}
+	if(!parameter.isSerializable()) return;
+
+	ofxOscMessage message = sender.getParameterMessage(parameter);
+	if(updatingParameter){
+		// the other side has this value already
+		lastSent[message.getAddress()] = parameter.toString();
+		return;
+	}
+	Change & change = changed[message.getAddress()];
+	change.message = message;
+	change.value = parameter.toString();
+}
+
+void ofxOscParameterSync::sendChanged(){
+	if(bSnapshots && (int)changed.size()>=snapshotMinChanged){
+		sendSnapshot();
+		return;
+	}
+
+	// only the parameters that ended up different from what was sent last
+	toSend.clear();
+	for(map<string,Change>::iterator it=changed.begin(); it!=changed.end(); ++it){
+		string & last = lastSent[it->first];
+		if(last==it->second.value) continue;
+		last = it->second.value;
+		toSend.push_back(it->second.message);
+	}
+	changed.clear();
+
+	if(toSend.empty()) return;
+	numPacketsSent += sender.sendMessages(toSend,maxPacketSize);
+	numParametersSent += toSend.size();
+}
+
+// the size of an osc string or blob padded to 4 bytes
+static int oscPaddedSize(int size){
+	return (size + 3) & ~3;
+}
+
+void ofxOscParameterSync::sendSnapshot(){
+	if(!syncGroup) return;
+	ofParameterSnapshot snapshot;
+	syncGroup->getSnapshot(snapshot);
+	ofBuffer buffer;
+	snapshot.saveToBuffer(buffer);
+
+	// sendMessage wraps the message in a bundle: "#bundle", the time
+	// tag and the message size, then the address, ",b" and the blob
+	string address = getSnapshotAddress();
+	int packetSize = 8 + 8 + 4 + oscPaddedSize(address.size()+1) + 4 + 4 + oscPaddedSize(buffer.size());
+	if(packetSize>maxPacketSize){
+		sendAll();
+		return;
+	}
+
+	ofxOscMessage msg;
+	msg.setAddress(address);
+	msg.addBlobArg(buffer);
+	sender.sendMessage(msg);
+
+	// the last values sent are not tracked for snapshots, forget them
+	// so the next changes are always sent
+	lastSent.clear();
+	changed.clear();
+	numPacketsSent++;
+	numParametersSent += snapshot.size();
+}
+
+void ofxOscParameterSync::sendAll(){
+	toSend.clear();
+	addMessages(*syncGroup,toSend);
+	changed.clear();
+	if(toSend.empty()) return;
+	numPacketsSent += sender.sendMessages(toSend,maxPacketSize);
+	numParametersSent += toSend.size();
+}
+
+void ofxOscParameterSync::addMessages(const ofParameterGroup & group, vector<ofxOscMessage> & messages){
+	for(int i=0;i<group.size();i++){
+		const ofAbstractParameter & parameter = group[i];
+		if(!parameter.isSerializable()) continue;
+		if(parameter.type()==typeid(ofParameterGroup).name()){
+			addMessages(static_cast<const ofParameterGroup &>(parameter),messages);
+		}else{
+			messages.push_back(sender.getParameterMessage(parameter));
+			lastSent[messages.back().getAddress()] = parameter.toString();
+		}
+	}
+}
+
+string ofxOscParameterSync::getSnapshotAddress(){
+	// escaped names never contain < or >, so no parameter can use this address
+	return "/" + syncGroup->getEscapedName() + "/<snapshot>";
+}
+
+void ofxOscParameterSync::setMinSendIntervalMs(int ms){
+	minSendInterval = max(0,ms);
+}
+
+void ofxOscParameterSync::setMaxPacketSize(int bytes){
+	maxPacketSize = ofClamp(bytes,64,4096);
+}
+
+int ofxOscParameterSync::getMaxPacketSize(){
+	return maxPacketSize;
+}
+
+void ofxOscParameterSync::enableSnapshots(int minChangedParameters){
+	bSnapshots = true;
+	snapshotMinChanged = minChangedParameters;
+}
+
+void ofxOscParameterSync::disableSnapshots(){
+	bSnapshots = false;
+}
+
+bool ofxOscParameterSync::getUsingSnapshots(){
+	return bSnapshots;
+}
+
+unsigned long ofxOscParameterSync::getNumPacketsSent(){
+	return numPacketsSent;
+}
+
+unsigned long ofxOscParameterSync::getNumParametersSent(){
+	return numParametersSent;
 }
@@ -12,6 +12,23 @@
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
 
+// keeps a group of parameters in sync with the same group in another app.
+//
+// changes are not sent when they happen but in update(), so a parameter
+// that changes several times in a frame, like a slider being dragged, is
+// sent once with its last value, and only if it's different from the last
+// value sent. all the parameters changed in a frame go in as few bundles
+// as fit in the maximum packet size.
+//
+// Info:
+// setMinSendIntervalMs() limits how often changes are sent, the changes
+// wait for the next update after the interval
+// with enableSnapshots() when many parameters change at once, loading a
+// preset for example, the whole group is sent in one message as a binary
+// ofParameterSnapshot instead. the other side always understands them but
+// the groups need to have the same layout. a snapshot that doesn't fit in
+// the maximum packet size is sent as bundles of messages instead
+
 class ofxOscParameterSync {
 public:
 	ofxOscParameterSync();
@@ -21,10 +38,51 @@ public:
 	void setup(ofParameterGroup & group, int localPort, string remoteHost, int remotePort);
 	void update();
 
+	void setMinSendIntervalMs(int ms);
+	/// 1472 by default, clamped to the 4096 bytes ofxOscReceiver can read
+	void setMaxPacketSize(int bytes);
+	int getMaxPacketSize();
+
+	/// send a snapshot instead of messages when at least
+	/// minChangedParameters changed since the last send
+	void enableSnapshots(int minChangedParameters = 32);
+	void disableSnapshots();
+	bool getUsingSnapshots();
+
+	/// sends the whole group now, as a snapshot if it fits in a packet
+	void sendSnapshot();
+
+	unsigned long getNumPacketsSent();
+	unsigned long getNumParametersSent();
+
 private:
 	void parameterChanged( ofAbstractParameter & parameter );
+	void sendChanged();
+	void sendAll();
+	void addMessages(const ofParameterGroup & group, vector<ofxOscMessage> & messages);
+	string getSnapshotAddress();
+
 	ofxOscSender sender;
 	ofxOscReceiver receiver;
 	ofParameterGroup * syncGroup;
 	bool updatingParameter;
+
+	// changes waiting to be sent and the last value sent for every
+	// address, the parameters that notify can be temporary copies so
+	// they are identified by their address
+	struct Change{
+		ofxOscMessage message;
+		string value;
+	};
+	map<string,Change> changed;
+	map<string,string> lastSent;
+	vector<ofxOscMessage> toSend;
+
+	unsigned long long lastSendTime;
+	int minSendInterval;
+	int maxPacketSize;
+	bool bSnapshots;
+	int snapshotMinChanged;
+	unsigned long numPacketsSent;
+	unsigned long numParametersSent;
 };
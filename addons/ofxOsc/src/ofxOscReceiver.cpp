@@ -156,9 +156,16 @@ void ofxOscReceiver::ProcessMessage( const osc::ReceivedMessage &m, const IpEndp
 			ofMessage->addFloatArg( arg->AsFloatUnchecked() );
 		else if ( arg->IsString() )
 			ofMessage->addStringArg( arg->AsStringUnchecked() );
+		else if ( arg->IsBlob() )
+		{
+			const void * data;
+			unsigned long size;
+			arg->AsBlobUnchecked( data, size );
+			ofMessage->addBlobArg( ofBuffer( (const char*)data, size ) );
+		}
 		else
 		{
-			ofLogError("ofxOscReceiver") << "ProcessMessage: argument in message " << m.AddressPattern() << " is not an int, float, or string";
+			ofLogError("ofxOscReceiver") << "ProcessMessage: argument in message " << m.AddressPattern() << " is not an int, float, string or blob";
 		}
 	}
 
@@ -228,35 +235,41 @@ bool ofxOscReceiver::getParameter(ofAbstractParameter & parameter){
 	ofxOscMessage msg;
 	if ( messages.size() == 0 ) return false;
 	while(hasWaitingMessages()){
-		ofAbstractParameter * p = &parameter;
-        
         getNextMessage(&msg);
-        vector<string> address = ofSplitString(msg.getAddress(),"/",true);
-                
-        for(int i=0;i<address.size();i++){
-            
-            if(p) {
-                if(address[i]==p->getEscapedName()){
-                    if(p->type()==typeid(ofParameterGroup).name()){
-                        if(address.size()>=i+1){
-                            p = &static_cast<ofParameterGroup*>(p)->get(address[i+1]);
-                        }
-                    }else if(p->type()==typeid(ofParameter<int>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
-                        p->cast<int>() = msg.getArgAsInt32(0);
-                    }else if(p->type()==typeid(ofParameter<float>).name() && msg.getArgType(0)==OFXOSC_TYPE_FLOAT){
-                        p->cast<float>() = msg.getArgAsFloat(0);
-                    }else if(p->type()==typeid(ofParameter<bool>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
-                        p->cast<bool>() = msg.getArgAsInt32(0);
-                    }else if(msg.getArgType(0)==OFXOSC_TYPE_STRING){
-                        p->fromString(msg.getArgAsString(0));
-                    }
-                }
-            }
-        }
+        getParameter(msg, parameter);
 	}
 	return true;
 }
 
+void ofxOscReceiver::getParameter(ofxOscMessage & msg, ofAbstractParameter & parameter){
+	ofAbstractParameter * p = &parameter;
+	vector<string> address = ofSplitString(msg.getAddress(),"/",true);
+
+	for(int i=0;i<(int)address.size();i++){
+
+		if(p) {
+			if(address[i]==p->getEscapedName()){
+				if(p->type()==typeid(ofParameterGroup).name()){
+					ofParameterGroup * group = static_cast<ofParameterGroup*>(p);
+					if(i+1<(int)address.size() && group->contains(address[i+1])){
+						p = &group->get(address[i+1]);
+					}else{
+						p = NULL;
+					}
+				}else if(p->type()==typeid(ofParameter<int>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
+					p->cast<int>() = msg.getArgAsInt32(0);
+				}else if(p->type()==typeid(ofParameter<float>).name() && msg.getArgType(0)==OFXOSC_TYPE_FLOAT){
+					p->cast<float>() = msg.getArgAsFloat(0);
+				}else if(p->type()==typeid(ofParameter<bool>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
+					p->cast<bool>() = msg.getArgAsInt32(0);
+				}else if(msg.getArgType(0)==OFXOSC_TYPE_STRING){
+					p->fromString(msg.getArgAsString(0));
+				}
+			}
+		}
+	}
+}
+
 void ofxOscReceiver::grabMutex()
 {
 #ifdef TARGET_WIN32
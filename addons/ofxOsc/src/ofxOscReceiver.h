@@ -64,6 +64,8 @@ public:
 	bool getNextMessage( ofxOscMessage* );
 
 	bool getParameter(ofAbstractParameter & parameter);
+	/// sets the parameter inside parameter, usually a group, that msg is addressed to
+	void getParameter(ofxOscMessage & msg, ofAbstractParameter & parameter);
 
 protected:
 	/// process an incoming osc message and add it to the queue
@@ -100,18 +100,63 @@ void ofxOscSender::sendParameter( const ofAbstractParameter & parameter){
 		appendParameter(bundle,parameter,address);
 		sendBundle(bundle);
 	}else{
-		string address = "";
-		const vector<string> hierarchy = parameter.getGroupHierarchyNames();
-		for(int i=0;i<(int)hierarchy.size()-1;i++){
-			address+= "/" + hierarchy[i];
-		}
-		if(address.length()) address += "/";
 		ofxOscMessage msg;
-		appendParameter(msg,parameter,address);
+		appendParameter(msg,parameter,getParameterAddress(parameter));
 		sendMessage(msg);
 	}
 }
 
+string ofxOscSender::getParameterAddress( const ofAbstractParameter & parameter ){
+	string address = "";
+	const vector<string> hierarchy = parameter.getGroupHierarchyNames();
+	for(int i=0;i<(int)hierarchy.size()-1;i++){
+		address+= "/" + hierarchy[i];
+	}
+	if(address.length()) address += "/";
+	return address;
+}
+
+ofxOscMessage ofxOscSender::getParameterMessage( const ofAbstractParameter & parameter ){
+	ofxOscMessage msg;
+	appendParameter(msg,parameter,getParameterAddress(parameter));
+	return msg;
+}
+
+int ofxOscSender::sendMessages( vector<ofxOscMessage> & messages, int maxPacketSize ){
+	static const int OUTPUT_BUFFER_SIZE = 32768;
+	// the size of every element goes before it in the bundle
+	static const int ELEMENT_HEADER_SIZE = 4;
+	char buffer[OUTPUT_BUFFER_SIZE];
+	char messageBuffer[OUTPUT_BUFFER_SIZE];
+
+	osc::OutboundPacketStream p( buffer, OUTPUT_BUFFER_SIZE );
+	int numPackets = 0;
+	int numInBundle = 0;
+	for(int i=0;i<(int)messages.size();i++){
+		// measure the message alone to know if it fits in the current bundle
+		osc::OutboundPacketStream measure( messageBuffer, OUTPUT_BUFFER_SIZE );
+		appendMessage( messages[i], measure );
+		int messageSize = ELEMENT_HEADER_SIZE + measure.Size();
+		if(numInBundle>0 && (int)p.Size() + messageSize > maxPacketSize){
+			p << osc::EndBundle;
+			socket->Send( p.Data(), p.Size() );
+			numPackets++;
+			p.Clear();
+			numInBundle = 0;
+		}
+		if(numInBundle==0){
+			p << osc::BeginBundleImmediate;
+		}
+		appendMessage( messages[i], p );
+		numInBundle++;
+	}
+	if(numInBundle>0){
+		p << osc::EndBundle;
+		socket->Send( p.Data(), p.Size() );
+		numPackets++;
+	}
+	return numPackets;
+}
 
 void ofxOscSender::appendParameter( ofxOscBundle & _bundle, const ofAbstractParameter & parameter, string address){
 	if(parameter.type()==typeid(ofParameterGroup).name()){
@@ -174,6 +219,11 @@ void ofxOscSender::appendMessage( ofxOscMessage& message, osc::OutboundPacketStr
 			p << message.getArgAsFloat( i );
 		else if ( message.getArgType( i ) == OFXOSC_TYPE_STRING )
 			p << message.getArgAsString( i ).c_str();
+		else if ( message.getArgType( i ) == OFXOSC_TYPE_BLOB )
+		{
+			ofBuffer blob = message.getArgAsBlob( i );
+			p << osc::Blob( blob.getBinaryBuffer(), blob.size() );
+		}
 		else
 		{
 			ofLogError("ofxOscSender") << "appendMessage(): bad argument type " << message.getArgType( i );
@@ -62,6 +62,13 @@ public:
 	void sendBundle( ofxOscBundle& bundle );
 	/// creates a message using an ofParameter
 	void sendParameter( const ofAbstractParameter & parameter);
+	/// the message sendParameter() sends for a parameter that isn't a group
+	ofxOscMessage getParameterMessage( const ofAbstractParameter & parameter );
+	/// sends several messages in bundles, packing as many as fit in
+	/// maxPacketSize bytes in every bundle. the default fits in an
+	/// ethernet frame so the datagrams are never fragmented.
+	/// returns the number of packets sent
+	int sendMessages( vector<ofxOscMessage> & messages, int maxPacketSize = 1472 );
 
 
 private:
@@ -72,6 +79,7 @@ private:
 	void appendMessage( ofxOscMessage& message, osc::OutboundPacketStream& p );
 	void appendParameter( ofxOscBundle & bundle, const ofAbstractParameter & parameter, string address);
 	void appendParameter( ofxOscMessage & msg, const ofAbstractParameter & parameter, string address);
+	string getParameterAddress( const ofAbstractParameter & parameter );
 
 	UdpTransmitSocket* socket;
 };
@@ -32,7 +32,8 @@ static vector<string> tokenize(const string & str, const string & delim)
 
 //----------------------------------------
 ofxXmlSettings::ofxXmlSettings():
-    storedHandle(NULL)
+    storedHandle(NULL),
+    bTagIndex(false)
 {
 	level			= 0;
 	//we do this so that we have a valid handle
@@ -42,7 +43,8 @@ ofxXmlSettings::ofxXmlSettings():
 
 //----------------------------------------
 ofxXmlSettings::ofxXmlSettings(const string& xmlFile):
-    storedHandle(NULL)
+    storedHandle(NULL),
+    bTagIndex(false)
 {
 	level			= 0;
 	//we do this so that we have a valid handle
@@ -69,6 +71,7 @@ void ofxXmlSettings::clear(){
 	//node - including the node itself!
 
 	storedHandle.ToNode()->Clear();
+	invalidateTagIndex();
 }
 
 //---------------------------------------------------------
@@ -77,6 +80,7 @@ bool ofxXmlSettings::loadFile(const string& xmlFile){
 	string fullXmlFile = ofToDataPath(xmlFile);
 
 	bool loadOkay = doc.LoadFile(fullXmlFile);
+	invalidateTagIndex();
 
 	//theo removed bool check as it would
 	//return false if the file exists but was
@@ -138,7 +142,7 @@ void ofxXmlSettings::removeTag(const string& tag, int which){
 		//with same name at root level
 		if(x > 0) which = 0;
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlHandle isRealHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 
 		if ( !isRealHandle.ToNode() ) break;
 		else{
@@ -146,6 +150,7 @@ void ofxXmlSettings::removeTag(const string& tag, int which){
 				//if we are at the last tag and it exists
 				//we use its parent to remove it - haha
 				tagHandle.ToNode()->RemoveChild( isRealHandle.ToNode() );
+				invalidateTagIndex();
 			}
 			tagHandle = isRealHandle;
 		}
@@ -179,6 +184,55 @@ string ofxXmlSettings::getValue(const string& tag, const string& defaultValue, i
 	return defaultValue;
 }
 
+//---------------------------------------------------------
+int ofxXmlSettings::getValues(const string& tag, vector<int>& values, int defaultValue){
+	return readValues(tag, values, defaultValue);
+}
+
+//---------------------------------------------------------
+int ofxXmlSettings::getValues(const string& tag, vector<double>& values, double defaultValue){
+	return readValues(tag, values, defaultValue);
+}
+
+//---------------------------------------------------------
+int ofxXmlSettings::getValues(const string& tag, vector<string>& values, const string& defaultValue){
+	return readValues(tag, values, defaultValue);
+}
+
+//---------------------------------------------------------
+static void fromText(const char * text, int & value){
+	value = ofToInt(text);
+}
+
+static void fromText(const char * text, double & value){
+	value = ofToFloat(text);
+}
+
+static void fromText(const char * text, string & value){
+	value = text;
+}
+
+//---------------------------------------------------------
+template<typename T>
+int ofxXmlSettings::readValues(const string& tag, vector<T>& values, const T& defaultValue){
+	values.clear();
+	vector<string> tokens = tokenize(tag,":");
+	if(tokens.empty()) return 0;
+
+	// walk the sibling list once instead of looking up every which
+	TiXmlElement* child = storedHandle.FirstChildElement( tokens.at(0) ).ToElement();
+	for (; child; child = child->NextSiblingElement( tokens.at(0) )){
+		TiXmlHandle tagHandle(child);
+		for(int x=1;x<(int)tokens.size();x++){
+			tagHandle = tagHandle.FirstChildElement( tokens.at(x) );
+		}
+		TiXmlText* text = tagHandle.Child( 0 ).ToText();
+		values.push_back(defaultValue);
+		if(text) fromText(text->Value(), values.back());
+	}
+	return values.size();
+}
+
 //---------------------------------------------------------
 bool ofxXmlSettings::readTag(const string&  tag, TiXmlHandle& valHandle, int which){
 
@@ -186,7 +240,7 @@ bool ofxXmlSettings::readTag(const string&  tag, TiXmlHandle& valHandle, int whi
 
 	TiXmlHandle tagHandle = storedHandle;
 	for(int x=0;x<(int)tokens.size();x++){
-		if(x == 0)tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+		if(x == 0)tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else tagHandle = tagHandle.FirstChildElement( tokens.at(x) );
 	}
 
@@ -205,7 +259,7 @@ bool ofxXmlSettings::pushTag(const string&  tag, int which){
     string tagToFind((pos > 0) ? tag.substr(0,pos) :tag);
 
 	//we only allow to push one tag at a time.
-	TiXmlHandle isRealHandle = storedHandle.ChildElement(tagToFind, which);
+	TiXmlHandle isRealHandle = TiXmlHandle(getChildElement(storedHandle.ToNode(), tagToFind, which));
 
 	if( isRealHandle.ToNode() ){
 		storedHandle = isRealHandle;
@@ -257,7 +311,7 @@ bool ofxXmlSettings::tagExists(const string& tag, int which){
 		//with same name at root level
 		if(x > 0) which = 0;
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlHandle isRealHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 
 		//as soon as we find a tag that doesn't exist
 		//we return false;
@@ -288,6 +342,10 @@ int ofxXmlSettings::getNumTags(const string&  tag){
 	//normally this is the doc but could be a pushed node
 	//TiXmlHandle tagHandle = storedHandle;
 
+	if(bTagIndex){
+		return getIndexedChildren(storedHandle.ToNode(), tagToFind).size();
+	}
+
 	int count = 0;
 
 	//ripped from tinyXML as doing this ourselves once is a LOT! faster
@@ -333,7 +391,7 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 			addNewTag = false;
 		}
 
-		TiXmlHandle isRealHandle = tagHandle.ChildElement( tokens.at(x), which);
+		TiXmlHandle isRealHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 
 		if ( !isRealHandle.ToNode() ||  addNewTag){
 
@@ -346,6 +404,7 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 			}
 
 			tagHandle.ToNode()->InsertEndChild(elements[x]);
+			invalidateTagIndex(tagHandle.ToNode());
 
 			break;
 
@@ -353,6 +412,8 @@ int ofxXmlSettings::writeTag(const string&  tag, const string& valueStr, int whi
 			 tagHandle = isRealHandle;
 			 if (x == (int)tokens.size()-1){
 				// what we want to change : TiXmlHandle valHandle = tagHandle.Child( 0 );
+				// removing tags inside it leaves their indices pointing to deleted tags
+				if(tagHandle.ToNode()->FirstChildElement()) invalidateTagIndex();
 				tagHandle.ToNode()->Clear();
 				tagHandle.ToNode()->InsertEndChild(Value);
 			}
@@ -415,6 +476,58 @@ int ofxXmlSettings::addTag(const string& tag){
 	return tagID;
 }
 
+//---------------------------------------------------------
+void ofxXmlSettings::enableTagIndex(){
+	bTagIndex = true;
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::disableTagIndex(){
+	bTagIndex = false;
+	tagIndex.clear();
+}
+
+//---------------------------------------------------------
+bool ofxXmlSettings::getUsingTagIndex(){
+	return bTagIndex;
+}
+
+//---------------------------------------------------------
+TiXmlElement* ofxXmlSettings::getChildElement(TiXmlNode* parent, const string& tag, int which){
+	if(!parent) return NULL;
+	if(!bTagIndex){
+		return TiXmlHandle(parent).ChildElement(tag, which).ToElement();
+	}
+	const vector<TiXmlElement*> & children = getIndexedChildren(parent, tag);
+	if(which < 0) which = 0;
+	if(which >= (int)children.size()) return NULL;
+	return children[which];
+}
+
+//---------------------------------------------------------
+const vector<TiXmlElement*> & ofxXmlSettings::getIndexedChildren(TiXmlNode* parent, const string& tag){
+	map<TiXmlNode*, TagIndex>::iterator it = tagIndex.find(parent);
+	if(it == tagIndex.end()){
+		// index all the tags of this level in one pass
+		TagIndex & index = tagIndex[parent];
+		for(TiXmlElement* child = parent->FirstChildElement(); child; child = child->NextSiblingElement()){
+			index[child->ValueStr()].push_back(child);
+		}
+		it = tagIndex.find(parent);
+	}
+	return it->second[tag];
+}
+
+//---------------------------------------------------------
+void ofxXmlSettings::invalidateTagIndex(TiXmlNode* parent){
+	if(tagIndex.empty()) return;
+	if(parent){
+		tagIndex.erase(parent);
+	}else{
+		tagIndex.clear();
+	}
+}
+
 void ofxXmlSettings::serialize(const ofAbstractParameter & parameter){
 	if(!parameter.isSerializable()) return;
 	string name = parameter.getEscapedName();
@@ -509,7 +622,7 @@ void ofxXmlSettings::removeAttribute(const string& tag, const string& attribute,
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else
 			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
 	}
@@ -534,7 +647,7 @@ int ofxXmlSettings::getNumAttributes(const string& tag, int which){
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else
 			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
 	}
@@ -560,7 +673,7 @@ bool ofxXmlSettings::attributeExists(const string& tag, const string& attribute,
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else
 			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
 	}
@@ -583,7 +696,7 @@ bool ofxXmlSettings::getAttributeNames(const string& tag, vector<string>& outNam
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else
 			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
 	}
@@ -647,7 +760,7 @@ TiXmlElement* ofxXmlSettings::getElementForAttribute(const string& tag, int whic
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else
 			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
 	}
@@ -694,7 +807,7 @@ int ofxXmlSettings::writeAttribute(const string& tag, const string& attribute, c
 	TiXmlHandle tagHandle = storedHandle;
 	for (int x = 0; x < (int)tokens.size(); x++) {
 		if (x == 0)
-			tagHandle = tagHandle.ChildElement(tokens.at(x), which);
+			tagHandle = TiXmlHandle(getChildElement(tagHandle.ToNode(), tokens.at(x), which));
 		else
 			tagHandle = tagHandle.FirstChildElement(tokens.at(x));
 	}
@@ -723,6 +836,7 @@ bool ofxXmlSettings::loadFromBuffer( string buffer )
     int size = buffer.size();
 
     bool loadOkay = doc.ReadFromMemory( buffer.c_str(), size);//, TiXmlEncoding encoding = TIXML_DEFAULT_ENCODING);
+    invalidateTagIndex();
 
     return loadOkay;
 
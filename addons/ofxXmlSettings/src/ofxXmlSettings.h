@@ -78,6 +78,14 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		int 	setValue(const string&  tag, double         value, int which = 0);
 		int 	setValue(const string&  tag, const string& 	value, int which = 0);
 
+		//-- getValues
+		//reads the value of every tag with the same name at the current
+		//level in one pass, values[which] is the same as getValue(tag, defaultValue, which)
+		//tags without a value get defaultValue. returns the number of tags
+		int		getValues(const string&  tag, vector<int>&    values, int           defaultValue = 0);
+		int		getValues(const string&  tag, vector<double>& values, double        defaultValue = 0);
+		int		getValues(const string&  tag, vector<string>& values, const string& defaultValue = "");
+
 		//advanced
 
 		//-- pushTag/popTag
@@ -113,6 +121,17 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 
 		int		addTag(const string& tag); //adds an empty tag at the current level
 
+		//-- tag index
+		//looking up a tag by which walks all the tags before it, so reading
+		//thousands of tags with the same name by index is quadratic.
+		//with the index enabled the tags of every level are indexed by name
+		//the first time that level is read and lookups take constant time.
+		//writes through this class keep it up to date, if you modify doc
+		//directly disable and enable it again to rebuild it
+		void	enableTagIndex();
+		void	disableTagIndex();
+		bool	getUsingTagIndex();
+
 		void serialize(const ofAbstractParameter & parameter);
 		void deserialize(ofAbstractParameter & parameter);
 
@@ -158,6 +177,16 @@ class ofxXmlSettings: public ofBaseFileSerializer{
 		TiXmlHandle     storedHandle;
 		int             level;
 
+		typedef map<string, vector<TiXmlElement*> > TagIndex;
+		map<TiXmlNode*, TagIndex> tagIndex;
+		bool            bTagIndex;
+
+		TiXmlElement*	getChildElement(TiXmlNode* parent, const string& tag, int which);
+		const vector<TiXmlElement*> & getIndexedChildren(TiXmlNode* parent, const string& tag);
+		void			invalidateTagIndex(TiXmlNode* parent = NULL);
+		template<typename T>
+		int				readValues(const string& tag, vector<T>& values, const T& defaultValue);
+
 
 		int 	writeTag(const string&  tag, const string& valueString, int which = 0);
 		bool 	readTag(const string&  tag, TiXmlHandle& valHandle, int which = 0);	// max 1024 chars...
@@ -0,0 +1,13 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+
+	// the benchmark doesn't draw anything, it runs in setup and exits
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window, 1024,768, OF_WINDOW);
+	ofRunApp( new ofApp());
+
+}
@@ -0,0 +1,208 @@
+#include "ofApp.h"
+#include "assimp.h"
+#include "aiScene.h"
+#include "aiPostProcess.h"
+
+static const int numFrames = 100;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	bFailed = false;
+	modelPath = ofToDataPath("../../../../../examples/addons/assimpExample/bin/data/astroBoy_walk.dae",true);
+
+	ofLogNotice("assimpSkinningBenchmark") << ofxAssimpSkinningPool::getPool().getNumThreads() << " skinning threads";
+	benchmark(1);
+	benchmark(10);
+	benchmark(50);
+
+	ofLogNotice("assimpSkinningBenchmark") << (bFailed ? "FAILED" : "passed");
+	ofExit(bFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+bool ofApp::loadModels(int numModels){
+	clearModels();
+	// every model needs its own scene, the animations write the nodes
+	unsigned int flags = aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_Triangulate | aiProcess_FlipUVs;
+	for(int i=0;i<numModels;i++){
+		const aiScene * scene = aiImportFile(modelPath.c_str(), flags);
+		if(!scene || !scene->mNumAnimations){
+			ofLogError("assimpSkinningBenchmark") << "couldn't load an animated model from " << modelPath;
+			if(scene) aiReleaseImport(scene);
+			return false;
+		}
+		Model * model = new Model;
+		model->scene = scene;
+		model->meshes.resize(scene->mNumMeshes);
+		for(unsigned int j=0;j<scene->mNumMeshes;j++){
+			ofxAssimpMeshHelper & mesh = model->meshes[j];
+			mesh.mesh = scene->mMeshes[j];
+			mesh.animatedPos.resize(mesh.mesh->mNumVertices);
+			if(mesh.mesh->HasNormals()){
+				mesh.animatedNorm.resize(mesh.mesh->mNumVertices);
+			}
+			mesh.setupSkinning(scene);
+		}
+		for(unsigned int j=0;j<scene->mNumAnimations;j++){
+			model->animations.push_back(ofxAssimpAnimation(scene, scene->mAnimations[j]));
+		}
+		models.push_back(model);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofApp::clearModels(){
+	for(int i=0;i<(int)models.size();i++){
+		aiReleaseImport(models[i]->scene);
+		delete models[i];
+	}
+	models.clear();
+}
+
+//--------------------------------------------------------------
+void ofApp::animate(float position){
+	// every model in a different pose
+	for(int i=0;i<(int)models.size();i++){
+		models[i]->animations[0].setPosition(fmod(position + i/(float)models.size(), 1.f));
+	}
+}
+
+//--------------------------------------------------------------
+// the skinning of ofxAssimpModelLoader before the per vertex kernel:
+// every vertex is transformed once for every bone that affects it
+static void skinPerBoneWeight(ofxAssimpMeshHelper & meshHelper){
+	const aiMesh * mesh = meshHelper.mesh;
+	meshHelper.animatedPos.assign(meshHelper.animatedPos.size(),aiVector3D(0,0,0));
+	meshHelper.animatedNorm.assign(meshHelper.animatedNorm.size(),aiVector3D(0,0,0));
+	for(unsigned int a=0; a<mesh->mNumBones; ++a){
+		const aiBone * bone = mesh->mBones[a];
+		const float * m = &meshHelper.boneMatrices[a*12];
+		aiMatrix4x4 posTrafo(m[0],m[1],m[2],m[3],
+							 m[4],m[5],m[6],m[7],
+							 m[8],m[9],m[10],m[11],
+							 0,0,0,1);
+		for(unsigned int b=0; b<bone->mNumWeights; ++b){
+			const aiVertexWeight & weight = bone->mWeights[b];
+			meshHelper.animatedPos[weight.mVertexId] += weight.mWeight * (posTrafo * mesh->mVertices[weight.mVertexId]);
+		}
+		if(mesh->HasNormals()){
+			aiMatrix3x3 normTrafo = aiMatrix3x3(posTrafo);
+			for(unsigned int b=0; b<bone->mNumWeights; ++b){
+				const aiVertexWeight & weight = bone->mWeights[b];
+				meshHelper.animatedNorm[weight.mVertexId] += weight.mWeight * (normTrafo * mesh->mNormals[weight.mVertexId]);
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::skin(Mode mode){
+	for(int i=0;i<(int)models.size();i++){
+		Model & model = *models[i];
+		for(int j=0;j<(int)model.meshes.size();j++){
+			ofxAssimpMeshHelper & mesh = model.meshes[j];
+			if(mesh.skinningWeights.empty()) continue;
+			mesh.updateBoneMatrices();
+			switch(mode){
+			case PerBoneWeight:
+				skinPerBoneWeight(mesh);
+				break;
+			case PerVertex:
+				ofxAssimpSkinVertices(mesh.mesh,
+									  mesh.skinningWeights,
+									  &mesh.boneMatrices[0],
+									  &mesh.animatedPos[0],
+									  mesh.animatedNorm.empty() ? NULL : &mesh.animatedNorm[0],
+									  0, mesh.mesh->mNumVertices);
+				break;
+			case Threaded:
+				ofxAssimpSkinningPool::getPool().submit(&mesh, model.batch);
+				break;
+			}
+		}
+	}
+	// ofxAssimpModelLoader waits for the threads on the next update so
+	// the skinning overlaps with the rest of the frame, here there's
+	// nothing else to do so this is the worst case
+	if(mode==Threaded){
+		for(int i=0;i<(int)models.size();i++){
+			ofxAssimpSkinningPool::getPool().wait(models[i]->batch);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+bool ofApp::checkResults(){
+	// the same pose skinned with the old code, the kernel and the threads
+	animate(0.3);
+	skin(PerBoneWeight);
+	reference.clear();
+	float size = 0;
+	for(int i=0;i<(int)models.size();i++){
+		for(int j=0;j<(int)models[i]->meshes.size();j++){
+			const vector<aiVector3D> & pos = models[i]->meshes[j].animatedPos;
+			reference.push_back(pos);
+			for(int v=0;v<(int)pos.size();v++){
+				size = max(size,pos[v].Length());
+			}
+		}
+	}
+
+	skin(PerVertex);
+	skin(Threaded);
+	float maxErrorPerVertex = 0, maxErrorThreaded = 0;
+	int k = 0;
+	for(int i=0;i<(int)models.size();i++){
+		for(int j=0;j<(int)models[i]->meshes.size();j++,k++){
+			ofxAssimpMeshHelper & mesh = models[i]->meshes[j];
+			if(mesh.skinningWeights.empty()) continue;
+			for(int v=0;v<(int)mesh.animatedPos.size();v++){
+				maxErrorPerVertex = max(maxErrorPerVertex,(mesh.animatedPos[v]-reference[k][v]).Length());
+				maxErrorThreaded = max(maxErrorThreaded,(mesh.animatedPosBack[v]-reference[k][v]).Length());
+			}
+		}
+	}
+
+	// the kernel blends the matrices before transforming, the results
+	// only differ in the rounding
+	bool bOk = maxErrorPerVertex<=size*1e-4 && maxErrorThreaded<=size*1e-4;
+	if(!bOk){
+		ofLogError("assimpSkinningBenchmark") << "skinned vertices differ from the per bone weight skinning: "
+				<< maxErrorPerVertex << " per vertex, " << maxErrorThreaded << " threaded, model size " << size;
+	}
+	return bOk;
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(int numModels){
+	if(!loadModels(numModels)){
+		bFailed = true;
+		return;
+	}
+	int numVertices = 0;
+	for(int j=0;j<(int)models[0]->meshes.size();j++){
+		if(!models[0]->meshes[j].skinningWeights.empty()){
+			numVertices += models[0]->meshes[j].mesh->mNumVertices;
+		}
+	}
+
+	bFailed |= !checkResults();
+
+	const char * names[] = {"per bone weight", "per vertex", "threaded"};
+	Mode modes[] = {PerBoneWeight, PerVertex, Threaded};
+	for(int m=0;m<3;m++){
+		unsigned long long elapsed = 0;
+		for(int frame=0;frame<numFrames;frame++){
+			// only the skinning is timed, the animation is the same for every mode
+			animate(frame/(float)numFrames);
+			unsigned long long start = ofGetElapsedTimeMicros();
+			skin(modes[m]);
+			elapsed += ofGetElapsedTimeMicros() - start;
+		}
+		ofLogNotice("assimpSkinningBenchmark") << numModels << " models, "
+				<< numVertices*numModels << " skinned vertices, " << names[m] << ": "
+				<< elapsed/1000./numFrames << "ms per frame";
+	}
+	clearModels();
+}
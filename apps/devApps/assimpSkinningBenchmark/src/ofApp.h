@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxAssimpMeshHelper.h"
+#include "ofxAssimpAnimation.h"
+#include "ofxAssimpSkinning.h"
+
+// skins N copies of an animated model the way ofxAssimpModelLoader does
+// and compares the time per frame of the old per bone weight skinning,
+// the per vertex kernel and the kernel on the skinning threads.
+// ofxAssimpModelLoader can't be used without a gl context, so every copy
+// is loaded with assimp and the mesh helpers are setup without vbos
+
+class ofApp : public ofBaseApp{
+
+	public:
+		struct Model{
+			const aiScene * scene;
+			vector<ofxAssimpMeshHelper> meshes;
+			vector<ofxAssimpAnimation> animations;
+			ofxAssimpSkinningPool::Batch batch;
+		};
+
+		enum Mode{
+			PerBoneWeight,
+			PerVertex,
+			Threaded
+		};
+
+		void setup();
+
+		bool loadModels(int numModels);
+		void clearModels();
+		void animate(float position);
+		void skin(Mode mode);
+		void benchmark(int numModels);
+		bool checkResults();
+
+		string modelPath;
+		vector<Model*> models;
+		vector< vector<aiVector3D> > reference;
+		bool bFailed;
+};
@@ -0,0 +1,198 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	// at the origin looking down -z, the viewport is passed explicitly
+	// so the results don't depend on the window
+	viewport.set(0,0,800,600);
+	camera.setFov(60);
+	camera.setNearClip(1);
+	camera.setFarClip(1000);
+
+	testBoundingBox();
+	testFrustumPlanes();
+	testBoxes();
+	testNodeGraph();
+	testDefaultClipPlanes();
+
+	ofLogNotice("cullingTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("cullingTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+static bool isNear(const ofVec3f & a, const ofVec3f & b){
+	return a.distance(b) < 0.001;
+}
+
+//--------------------------------------------------------------
+void ofApp::testBoundingBox(){
+	ofBoundingBox empty;
+	check(empty.isEmpty(),"a default box is empty");
+	empty.add(ofVec3f(1,2,3));
+	check(!empty.isEmpty() && isNear(empty.getMin(),ofVec3f(1,2,3)) && isNear(empty.getMax(),ofVec3f(1,2,3)),"a box with one point");
+
+	ofBoundingBox cube(ofVec3f(-1,-1,-1),ofVec3f(1,1,1));
+	check(isNear(cube.getCenter(),ofVec3f(0,0,0)) && isNear(cube.getSize(),ofVec3f(2,2,2)),"center and size");
+	check(fabs(cube.getRadius()-sqrt(3.f))<0.001,"radius");
+
+	// rotated 45 degrees around z the corners stick out sqrt(2) in x and y
+	ofMatrix4x4 m;
+	m.makeRotationMatrix(45,0,0,1);
+	m.postMultTranslate(5,0,0);
+	ofBoundingBox rotated = cube.getTransformed(m);
+	float r2 = sqrt(2.f);
+	check(isNear(rotated.getMin(),ofVec3f(5-r2,-r2,-1)) && isNear(rotated.getMax(),ofVec3f(5+r2,r2,1)),"rotated and translated box");
+
+	ofMatrix4x4 scale;
+	scale.makeScaleMatrix(2,3,4);
+	ofBoundingBox scaled = cube.getTransformed(scale);
+	check(isNear(scaled.getMin(),ofVec3f(-2,-3,-4)) && isNear(scaled.getMax(),ofVec3f(2,3,4)),"scaled box");
+
+	check(cube.intersects(rotated)==false,"boxes apart don't intersect");
+	check(cube.intersects(scaled),"boxes that overlap intersect");
+	check(cube.inside(ofVec3f(0.5,-0.5,0.9)) && !cube.inside(ofVec3f(0,0,1.1)),"points inside and outside");
+}
+
+//--------------------------------------------------------------
+bool ofApp::isPointVisible(const ofVec3f & p){
+	return camera.isVisible(ofBoundingBox(p,p),viewport);
+}
+
+//--------------------------------------------------------------
+void ofApp::testFrustumPlanes(){
+	// every plane is tested with a point just inside and one just outside
+	const float e = 0.01;
+	check(isPointVisible(ofVec3f(0,0,-1-e)),"point after the near plane");
+	check(!isPointVisible(ofVec3f(0,0,-1+e)),"point before the near plane");
+	check(isPointVisible(ofVec3f(0,0,-1000+e)),"point before the far plane");
+	check(!isPointVisible(ofVec3f(0,0,-1000-e)),"point after the far plane");
+
+	// at distance 10 the vertical fov of 60 covers 10*tan(30) up and down
+	// and the aspect ratio times that to the sides
+	float halfHeight = 10 * tan(ofDegToRad(30));
+	float halfWidth = halfHeight * viewport.width / viewport.height;
+	check(isPointVisible(ofVec3f(0,halfHeight-e,-10)),"point below the top plane");
+	check(!isPointVisible(ofVec3f(0,halfHeight+e,-10)),"point above the top plane");
+	check(isPointVisible(ofVec3f(0,-halfHeight+e,-10)),"point above the bottom plane");
+	check(!isPointVisible(ofVec3f(0,-halfHeight-e,-10)),"point below the bottom plane");
+	check(isPointVisible(ofVec3f(halfWidth-e,0,-10)),"point left of the right plane");
+	check(!isPointVisible(ofVec3f(halfWidth+e,0,-10)),"point right of the right plane");
+	check(isPointVisible(ofVec3f(-halfWidth+e,0,-10)),"point right of the left plane");
+	check(!isPointVisible(ofVec3f(-halfWidth-e,0,-10)),"point left of the left plane");
+	check(!isPointVisible(ofVec3f(0,0,10)),"point behind the camera");
+}
+
+//--------------------------------------------------------------
+void ofApp::testBoxes(){
+	ofBoundingBox box(ofVec3f(-1,-1,-1),ofVec3f(1,1,1));
+	ofMatrix4x4 m;
+
+	m.makeTranslationMatrix(0,0,-10);
+	check(camera.isVisible(box.getTransformed(m),viewport),"box in front of the camera");
+	m.makeTranslationMatrix(0,0,10);
+	check(!camera.isVisible(box.getTransformed(m),viewport),"box behind the camera");
+	m.makeTranslationMatrix(100,0,-10);
+	check(!camera.isVisible(box.getTransformed(m),viewport),"box to the right");
+
+	// only a corner of the box is inside the frustum
+	float halfHeight = 10 * tan(ofDegToRad(30));
+	float halfWidth = halfHeight * viewport.width / viewport.height;
+	m.makeTranslationMatrix(halfWidth+0.9,0,-10);
+	check(camera.isVisible(box.getTransformed(m),viewport),"box crossing the right plane");
+
+	// rotating the box makes it reach the frustum
+	m.makeRotationMatrix(45,0,1,0);
+	m.postMultTranslate(halfWidth+1.2,0,-10);
+	check(camera.isVisible(box.getTransformed(m),viewport),"rotated box crossing the right plane");
+
+	check(!camera.isVisible(ofBoundingBox(),viewport),"empty box");
+
+	// moving the camera moves the frustum
+	ofCamera moved = camera;
+	moved.setPosition(100,0,0);
+	m.makeTranslationMatrix(100,0,-10);
+	check(moved.isVisible(box.getTransformed(m),viewport),"box in front of a moved camera");
+	moved.lookAt(ofVec3f(100,0,10));
+	check(!moved.isVisible(box.getTransformed(m),viewport),"box behind a camera that turned around");
+}
+
+//--------------------------------------------------------------
+void ofApp::testNodeGraph(){
+	ofNodeGraph graph;
+	BoxNode parent, visibleChild, culledChild;
+	ofNode empty;
+
+	// the parent is behind the camera but its children aren't
+	parent.setPosition(0,0,10);
+	visibleChild.setParent(parent);
+	visibleChild.setPosition(0,0,-20);
+	culledChild.setParent(parent);
+	culledChild.setPosition(100,0,-20);
+	// nodes without geometry are culled by their position
+	empty.setPosition(0,0,-50);
+
+	graph.add(parent);
+	graph.add(visibleChild);
+	graph.add(culledChild);
+	graph.add(empty);
+
+	check(!camera.isVisible(parent,viewport),"node behind the camera");
+	check(camera.isVisible(visibleChild,viewport),"child in front of the camera");
+	check(!camera.isVisible(culledChild,viewport),"child to the right");
+
+	vector<ofNode*> visible = camera.getVisibleNodes(graph,viewport);
+	check(visible.size()==2 && find(visible.begin(),visible.end(),&visibleChild)!=visible.end() && find(visible.begin(),visible.end(),&empty)!=visible.end(),"visible nodes in the graph");
+
+	vector<ofNode*> nodes;
+	nodes.push_back(&parent);
+	nodes.push_back(&visibleChild);
+	nodes.push_back(&culledChild);
+	nodes.push_back(&empty);
+	check(camera.getVisibleNodes(nodes,viewport).size()==2,"visible nodes in a list");
+
+	// moving the parent moves the children
+	parent.setPosition(0,0,-10);
+	check(camera.getVisibleNodes(graph,viewport).size()==3,"visible nodes after moving the parent");
+}
+
+//--------------------------------------------------------------
+void ofApp::testDefaultClipPlanes(){
+	// a camera without clip planes uses the ones begin() would set:
+	// 1/100 and 10 times the image plane distance
+	ofNodeGraph graph;
+	ofCamera defaultCamera;
+	defaultCamera.setFov(60);
+	BoxNode tooNear, inside, tooFar;
+	float dist = defaultCamera.getImagePlaneDistance(viewport);
+	tooNear.setPosition(0,0,2 - dist/100);
+	tooNear.setParent(defaultCamera);
+	inside.setPosition(0,0,-dist);
+	tooFar.setPosition(0,0,-dist*10 - 2);
+
+	// the camera is in the graph too, culling with it must not change it
+	graph.add(defaultCamera);
+	graph.add(tooNear);
+	graph.add(inside);
+	graph.add(tooFar);
+	graph.update();
+
+	bool bOk = true;
+	for(int i=0;i<3;i++){
+		vector<ofNode*> visible = camera.getVisibleNodes(graph,viewport);
+		visible = defaultCamera.getVisibleNodes(graph,viewport);
+		bOk &= visible.size()==1 && visible[0]==&inside;
+		bOk &= graph.size()==4 && graph.isUpToDate();
+	}
+	check(bOk,"visible nodes with the default clip planes of a camera in the graph");
+	check(defaultCamera.getNearClip()==0 && defaultCamera.getFarClip()==0,"culling doesn't set the clip planes");
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks the frustum culling of ofCamera and the transformation of
+// ofBoundingBox against cases with known results
+
+// a node that draws a 2x2x2 cube around its position
+class BoxNode: public ofNode{
+public:
+	ofBoundingBox getLocalBoundingBox() const{
+		return ofBoundingBox(ofVec3f(-1,-1,-1),ofVec3f(1,1,1));
+	}
+};
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void testBoundingBox();
+		void testFrustumPlanes();
+		void testBoxes();
+		void testNodeGraph();
+		void testDefaultClipPlanes();
+
+		bool isPointVisible(const ofVec3f & p);
+		void check(bool bOk, string test);
+
+		ofCamera camera;
+		ofRectangle viewport;
+		int numFailed;
+};
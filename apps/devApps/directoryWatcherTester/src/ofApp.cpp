@@ -0,0 +1,168 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	watched = ofToDataPath("watched",true);
+	outside = ofToDataPath("outside",true);
+	removeDirectory(watched);
+	removeDirectory(outside);
+	ofDirectory::createDirectory(watched,false,true);
+	ofDirectory::createDirectory(outside,false,true);
+
+	ofAddListener(watcher.fileCreated,this,&ofApp::fileEvent);
+	ofAddListener(watcher.fileModified,this,&ofApp::fileEvent);
+	ofAddListener(watcher.fileDeleted,this,&ofApp::fileEvent);
+	if(!watcher.setup(watched)){
+		check(false,"setup");
+	}else{
+		ofLogNotice("directoryWatcherTester") << (watcher.isPolling() ? "polling" : "native notifications");
+		testCreate();
+		testModify();
+		testMoveIn();
+		testMoveDirectoryIn();
+		testMoveOut();
+		testDelete();
+		testHidden();
+	}
+	watcher.close();
+
+	removeDirectory(watched);
+	removeDirectory(outside);
+
+	ofLogNotice("directoryWatcherTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::fileEvent(ofDirectoryWatcherEventArgs & args){
+	events.push_back(args);
+}
+
+//--------------------------------------------------------------
+void ofApp::waitForEvents(){
+	// a bit more than the polling interval, the notifications come sooner
+	events.clear();
+	int timeoutMs = watcher.isPolling() ? 1500 : 300;
+	unsigned long long start = ofGetElapsedTimeMillis();
+	while(ofGetElapsedTimeMillis() - start < (unsigned long long)timeoutMs){
+		ofSleepMillis(10);
+		ofEventArgs args;
+		ofNotifyEvent(ofEvents().update,args);
+	}
+}
+
+//--------------------------------------------------------------
+bool ofApp::received(ofDirectoryWatcherEventArgs::Type type, string path){
+	for(int i=0;i<(int)events.size();i++){
+		if(events[i].type==type && ofFilePath::getAbsolutePath(events[i].path,false)==ofFilePath::join(watched,path)){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void ofApp::writeFile(string path, string contents){
+	ofBuffer buffer(contents);
+	ofBufferToFile(path,buffer);
+}
+
+//--------------------------------------------------------------
+void ofApp::moveFile(string from, string to){
+	// ofFile::moveFromTo copies and removes, a file manager or an editor
+	// saving through a temporary file renames
+	if(rename(from.c_str(),to.c_str())!=0){
+		ofLogError("directoryWatcherTester") << "couldn't move " << from << " to " << to;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::removeDirectory(string path){
+	if(ofDirectory::doesDirectoryExist(path,false)){
+		ofDirectory::removeDirectory(path,true,false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("directoryWatcherTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::testCreate(){
+	writeFile(ofFilePath::join(watched,"created.txt"),"created");
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Created,"created.txt"),"a new file is created");
+	check(received(ofDirectoryWatcherEventArgs::Modified,"created.txt"),"a new file is modified");
+}
+
+//--------------------------------------------------------------
+void ofApp::testModify(){
+	writeFile(ofFilePath::join(watched,"created.txt"),"modified");
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Modified,"created.txt"),"a written file is modified");
+	check(!received(ofDirectoryWatcherEventArgs::Created,"created.txt"),"a written file is not created again");
+}
+
+//--------------------------------------------------------------
+void ofApp::testMoveIn(){
+	writeFile(ofFilePath::join(outside,"moved.txt"),"moved");
+	waitForEvents();
+	check(events.empty(),"files outside the directory aren't notified");
+
+	moveFile(ofFilePath::join(outside,"moved.txt"),ofFilePath::join(watched,"moved.txt"));
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Created,"moved.txt"),"a file moved in is created");
+	check(received(ofDirectoryWatcherEventArgs::Modified,"moved.txt"),"a file moved in is modified, like a new file");
+}
+
+//--------------------------------------------------------------
+void ofApp::testMoveDirectoryIn(){
+	ofDirectory::createDirectory(ofFilePath::join(outside,"dir"),false);
+	writeFile(ofFilePath::join(outside,"dir/inside.txt"),"inside");
+	moveFile(ofFilePath::join(outside,"dir"),ofFilePath::join(watched,"dir"));
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Created,"dir"),"a directory moved in is created");
+	check(!received(ofDirectoryWatcherEventArgs::Modified,"dir"),"directories are never modified");
+	check(received(ofDirectoryWatcherEventArgs::Created,"dir/inside.txt"),"the files in a directory moved in are created");
+	check(received(ofDirectoryWatcherEventArgs::Modified,"dir/inside.txt"),"the files in a directory moved in are modified");
+
+	writeFile(ofFilePath::join(watched,"dir/inside.txt"),"modified");
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Modified,"dir/inside.txt"),"a directory moved in is watched");
+}
+
+//--------------------------------------------------------------
+void ofApp::testMoveOut(){
+	moveFile(ofFilePath::join(watched,"moved.txt"),ofFilePath::join(outside,"moved.txt"));
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Deleted,"moved.txt"),"a file moved out is deleted");
+
+	moveFile(ofFilePath::join(watched,"dir"),ofFilePath::join(outside,"dir"));
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Deleted,"dir"),"a directory moved out is deleted");
+
+	writeFile(ofFilePath::join(outside,"dir/inside.txt"),"outside");
+	waitForEvents();
+	check(events.empty(),"a directory moved out isn't watched anymore");
+}
+
+//--------------------------------------------------------------
+void ofApp::testDelete(){
+	ofFile::removeFile(ofFilePath::join(watched,"created.txt"),false);
+	waitForEvents();
+	check(received(ofDirectoryWatcherEventArgs::Deleted,"created.txt"),"a removed file is deleted");
+	check(events.size()==1,"a removed file is only deleted");
+}
+
+//--------------------------------------------------------------
+void ofApp::testHidden(){
+	writeFile(ofFilePath::join(watched,".hidden.swp"),"hidden");
+	waitForEvents();
+	check(events.empty(),"hidden files are ignored");
+}
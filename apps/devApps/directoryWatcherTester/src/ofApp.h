@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks the events of ofDirectoryWatcher when files and directories are
+// created, written, moved in and out and deleted. the events arrive in
+// update so the tests notify the update event themselves while they wait
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void testCreate();
+		void testModify();
+		void testMoveIn();
+		void testMoveDirectoryIn();
+		void testMoveOut();
+		void testDelete();
+		void testHidden();
+
+		void waitForEvents();
+		bool received(ofDirectoryWatcherEventArgs::Type type, string path);
+		void writeFile(string path, string contents);
+		void moveFile(string from, string to);
+		void removeDirectory(string path);
+		void check(bool bOk, string test);
+
+		void fileEvent(ofDirectoryWatcherEventArgs & args);
+
+		ofDirectoryWatcher watcher;
+		vector<ofDirectoryWatcherEventArgs> events;
+		string watched, outside;
+		int numFailed;
+};
@@ -0,0 +1,86 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	testCircle(4,4);
+	testCircle(10.3,8);
+	testCircle(30.7,8);
+	testCircle(50,16);
+
+	ofLogNotice("distanceFieldTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("distanceFieldTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::rasterizeCircle(ofPixels & coverage, const ofPoint & center, float radius){
+	// the coverage of every pixel is estimated with 16x16 samples
+	const int samples = 16;
+	for(int y=0;y<(int)coverage.getHeight();y++){
+		for(int x=0;x<(int)coverage.getWidth();x++){
+			int inside = 0;
+			for(int sy=0;sy<samples;sy++){
+				for(int sx=0;sx<samples;sx++){
+					ofPoint p(x + (sx+0.5)/samples, y + (sy+0.5)/samples);
+					if(p.distance(center)<radius) inside++;
+				}
+			}
+			coverage.getPixels()[y*coverage.getWidth()+x] = ofClamp(inside * 255.f / (samples*samples) + 0.5f, 0, 255);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::testCircle(float radius, int spread){
+	// spread pixels of margin so the field is complete around the circle
+	int size = ceil(radius*2) + spread*2 + 2;
+	ofPoint center(size*0.5 + 0.25, size*0.5 - 0.125);
+	ofPixels coverage, field;
+	coverage.allocate(size,size,1);
+	rasterizeCircle(coverage,center,radius);
+	ofComputeDistanceField(coverage,field,spread);
+
+	check(field.getWidth()==coverage.getWidth() && field.getHeight()==coverage.getHeight() && field.getNumChannels()==1,
+			"the field has the size of the coverage");
+
+	// 128 is the outline, every step is spread/127.5 pixels
+	float maxError = 0, sumError = 0;
+	int numPixels = 0;
+	bool bSaturated = true;
+	for(int y=0;y<size;y++){
+		for(int x=0;x<size;x++){
+			float expected = radius - ofPoint(x+0.5,y+0.5).distance(center);
+			if(fabs(expected)>spread-1){
+				// clamped to 0 or 255 far from the outline
+				if(fabs(expected)>spread+1){
+					unsigned char value = field.getPixels()[y*size+x];
+					bSaturated &= expected>0 ? value==255 : value==0;
+				}
+				continue;
+			}
+			float distance = (field.getPixels()[y*size+x] - 127.5f) * spread / 127.5f;
+			float error = fabs(distance - expected);
+			maxError = max(maxError,error);
+			sumError += error;
+			numPixels++;
+		}
+	}
+	float meanError = sumError / numPixels;
+
+	string name = "circle of radius " + ofToString(radius) + " with spread " + ofToString(spread);
+	ofLogNotice("distanceFieldTester") << name << ": max error " << maxError << " mean error " << meanError << " pixels";
+	// the distances are between pixel centers, so up to about half a
+	// pixel off, but the average should be much closer
+	check(maxError<0.75,name + ": max error too big");
+	check(meanError<0.3,name + ": mean error too big");
+	check(bSaturated,name + ": the field isn't clamped outside the spread");
+}
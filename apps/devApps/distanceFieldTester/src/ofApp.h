@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks ofComputeDistanceField on the cpu against shapes with a known
+// distance: antialiased circles of different sizes are rasterized and
+// the distance read back from the field is compared with the analytic
+// distance to the circle in every pixel that isn't clamped by the spread
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void testCircle(float radius, int spread);
+		void rasterizeCircle(ofPixels & coverage, const ofPoint & center, float radius);
+		void check(bool bOk, string test);
+
+		int numFailed;
+};
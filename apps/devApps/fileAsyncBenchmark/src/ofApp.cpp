@@ -0,0 +1,156 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+	folder = ofToDataPath("fileAsyncBenchmark",true);
+	if(ofDirectory::doesDirectoryExist(folder,false)){
+		ofDirectory::removeDirectory(folder,true,false);
+	}
+	ofDirectory::createDirectory(folder,false,true);
+
+	benchmark("small files",2000,4*1024);
+	benchmark("large files",4,64*1024*1024);
+	testConcurrentWrites();
+
+	ofDirectory::removeDirectory(folder,true,false);
+	ofLogNotice("fileAsyncBenchmark") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("fileAsyncBenchmark") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+static bool isEqual(const ofBuffer & a, const ofBuffer & b){
+	return a.size()==b.size() && memcmp(a.getBinaryBuffer(),b.getBinaryBuffer(),a.size())==0;
+}
+
+//--------------------------------------------------------------
+static ofBuffer makeContents(int size, int seed){
+	string data(size,0);
+	for(int i=0;i<size;i++){
+		data[i] = (i*31 + seed*17 + i/256) & 0xff;
+	}
+	return ofBuffer(data.c_str(),data.size());
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(string name, int numFiles, int fileSize){
+	vector<string> paths;
+	vector<ofBuffer> contents;
+	for(int i=0;i<numFiles;i++){
+		paths.push_back(ofFilePath::join(folder,name.substr(0,5) + ofToString(i) + ".bin"));
+		contents.push_back(makeContents(fileSize,i));
+	}
+	double megabytes = numFiles * (double)fileSize / (1024*1024);
+	ofLogNotice("fileAsyncBenchmark") << numFiles << " " << name << " of " << fileSize/1024 << "KB";
+
+	const int threads[] = {1,2,4,8};
+	for(int t=-1;t<4;t++){
+		string mode = t==-1 ? "synchronous" : ofToString(threads[t]) + " threads";
+
+		// the main thread is blocked for the whole synchronous calls
+		// but only while adding the requests for the asynchronous ones
+		unsigned long long start = ofGetElapsedTimeMicros();
+		bool bWritten = t==-1 ? writeSync(paths,contents) : writeAsync(threads[t],paths,contents);
+		double writeSeconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+		double writeBlocked = t==-1 ? writeSeconds : submitSeconds;
+
+		start = ofGetElapsedTimeMicros();
+		bool bRead = t==-1 ? readSync(paths,contents) : readAsync(threads[t],paths,contents);
+		double readSeconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+		double readBlocked = t==-1 ? readSeconds : submitSeconds;
+
+		check(bWritten,name + ", " + mode + ": couldn't write the files");
+		check(bRead,name + ", " + mode + ": the files read back are different");
+		ofLogNotice("fileAsyncBenchmark") << "  " << mode << ": write "
+				<< megabytes/writeSeconds << "MB/s " << numFiles/writeSeconds << " files/s, main thread blocked "
+				<< writeBlocked*1000 << "ms. read " << megabytes/readSeconds << "MB/s " << numFiles/readSeconds
+				<< " files/s, main thread blocked " << readBlocked*1000 << "ms";
+	}
+}
+
+//--------------------------------------------------------------
+bool ofApp::writeSync(const vector<string> & paths, vector<ofBuffer> & contents){
+	bool bOk = true;
+	for(int i=0;i<(int)paths.size();i++){
+		bOk &= ofBufferToFile(paths[i],contents[i],true);
+	}
+	return bOk;
+}
+
+//--------------------------------------------------------------
+bool ofApp::readSync(const vector<string> & paths, const vector<ofBuffer> & contents){
+	bool bOk = true;
+	for(int i=0;i<(int)paths.size();i++){
+		bOk &= isEqual(ofBufferFromFile(paths[i],true),contents[i]);
+	}
+	return bOk;
+}
+
+//--------------------------------------------------------------
+bool ofApp::writeAsync(int numThreads, const vector<string> & paths, const vector<ofBuffer> & contents){
+	ofFileAsync fileAsync;
+	fileAsync.setNumThreads(numThreads);
+	vector<ofPtr<ofFileAsyncResult> > results;
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(int i=0;i<(int)paths.size();i++){
+		results.push_back(fileAsync.write(paths[i],contents[i],true));
+	}
+	submitSeconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+	fileAsync.waitForAll();
+	bool bOk = true;
+	for(int i=0;i<(int)results.size();i++){
+		bOk &= results[i]->isOk();
+	}
+	return bOk;
+}
+
+//--------------------------------------------------------------
+bool ofApp::readAsync(int numThreads, const vector<string> & paths, const vector<ofBuffer> & contents){
+	ofFileAsync fileAsync;
+	fileAsync.setNumThreads(numThreads);
+	vector<ofPtr<ofFileAsyncResult> > results;
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(int i=0;i<(int)paths.size();i++){
+		results.push_back(fileAsync.read(paths[i],true));
+	}
+	submitSeconds = (ofGetElapsedTimeMicros() - start) / 1000000.;
+	fileAsync.waitForAll();
+	bool bOk = true;
+	for(int i=0;i<(int)results.size();i++){
+		bOk &= results[i]->isOk() && isEqual(results[i]->getBuffer(),contents[i]);
+	}
+	return bOk;
+}
+
+//--------------------------------------------------------------
+void ofApp::testConcurrentWrites(){
+	// every write has a different size so a mix of them is detected
+	string path = ofFilePath::join(folder,"concurrent.bin");
+	vector<ofBuffer> contents;
+	ofFileAsync fileAsync;
+	fileAsync.setNumThreads(8);
+	for(int i=0;i<50;i++){
+		contents.push_back(makeContents(64*1024 + i*4096,i));
+		fileAsync.write(path,contents.back(),true);
+	}
+	fileAsync.waitForAll();
+
+	ofBuffer result = ofBufferFromFile(path,true);
+	bool bComplete = false;
+	for(int i=0;i<(int)contents.size();i++){
+		bComplete |= isEqual(result,contents[i]);
+	}
+	check(bComplete,"concurrent writes to the same file left it different from all of them");
+
+	ofDirectory dir(folder);
+	dir.allowExt("tmp");
+	check(dir.listDir()==0,"concurrent writes left temporary files");
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofFileAsync.h"
+
+// writes and reads back many small files and a few large ones with
+// ofBufferToFile/ofBufferFromFile and with ofFileAsync using different
+// numbers of threads, checks that every file has the right contents and
+// prints the throughput of each and how long the main thread is blocked.
+// the asynchronous writes replace the files atomically, which costs
+// more than overwriting them like ofBufferToFile does. the files are read right after being
+// written so the reads come from the os cache, the writes are what a
+// disk limits most
+//
+// it also checks that concurrent writes to the same file leave one of
+// them complete and no temporary files behind
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void benchmark(string name, int numFiles, int fileSize);
+		bool writeSync(const vector<string> & paths, vector<ofBuffer> & contents);
+		bool readSync(const vector<string> & paths, const vector<ofBuffer> & contents);
+		bool writeAsync(int numThreads, const vector<string> & paths, const vector<ofBuffer> & contents);
+		bool readAsync(int numThreads, const vector<string> & paths, const vector<ofBuffer> & contents);
+		void testConcurrentWrites();
+		void check(bool bOk, string test);
+
+		string folder;
+		double submitSeconds;
+		int numFailed;
+};
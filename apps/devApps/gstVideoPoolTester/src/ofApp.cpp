@@ -0,0 +1,75 @@
+#include "ofApp.h"
+
+static const int framerate = 30;
+static const int numBuffers = 60;
+static const int numUpdates = 150;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	for(int i=0;i<numVideos;i++){
+#if GST_VERSION_MAJOR==0
+		string caps = "video/x-raw-rgb,framerate=" + ofToString(framerate) + "/1";
+#else
+		string caps = "video/x-raw,framerate=" + ofToString(framerate) + "/1";
+#endif
+		string pipeline = "videotestsrc pattern=" + ofToString(i) + " num-buffers=" + ofToString(numBuffers) + " ! " + caps;
+		bool bLoaded = videos[i].setPipeline(pipeline,24,false,160,120) && videos[i].startPipeline();
+		check(bLoaded,"couldn't start " + pipeline);
+		if(!bLoaded || !pool.add(videos[i])){
+			ofLogNotice("gstVideoPoolTester") << "FAILED";
+			ofExit(1);
+			return;
+		}
+	}
+	pool.setLoopState(OF_LOOP_NORMAL);
+	pool.play();
+
+	// a sink can deliver its frame a bit after the others so at the
+	// boundary between frames the videos can differ in one frame
+	const int64_t frameDuration = GST_SECOND / framerate;
+	int numUnsynced = 0, numOutOfSync = 0, numChanged = 0, numNewFrames = 0, numLoops = 0;
+	int64_t prevTimestamp = -1;
+	for(int i=0;i<numUpdates;i++){
+		ofSleepMillis(1000/framerate);
+		pool.update();
+		if(pool.isFrameNew()) numNewFrames++;
+
+		int64_t timestamp = videos[0].getFrameTimestampNanos();
+		for(int j=0;j<numVideos;j++){
+			int64_t videoTimestamp = videos[j].getFrameTimestampNanos();
+			if(videoTimestamp!=timestamp) numUnsynced++;
+			int64_t difference = videoTimestamp - timestamp;
+			if(videoTimestamp==-1 || difference>frameDuration || difference<-frameDuration) numOutOfSync++;
+
+			// what ofGstVideoPlayer::update() does every frame
+			videos[j].update();
+			if(videos[j].getFrameTimestampNanos()!=videoTimestamp) numChanged++;
+		}
+
+		if(timestamp<prevTimestamp) numLoops++;
+		prevTimestamp = timestamp;
+	}
+	pool.stop();
+	pool.clear();
+
+	ofLogNotice("gstVideoPoolTester") << numVideos << " videos, " << numUpdates << " updates: " << numNewFrames
+			<< " with new frames, " << numUnsynced << " frames differing in one video, " << numLoops << " loops";
+	check(numOutOfSync==0,"videos more than a frame apart " + ofToString(numOutOfSync) + " times");
+	check(numUnsynced<=numUpdates*numVideos/10,"videos showing different frames " + ofToString(numUnsynced) + " times");
+	check(numChanged==0,"updating a video changed the frame chosen by the pool " + ofToString(numChanged) + " times");
+	check(numNewFrames>numUpdates/2,"the pool only had new frames in " + ofToString(numNewFrames) + " updates");
+	check(numLoops>0,"the pool never looped");
+
+	ofLogNotice("gstVideoPoolTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("gstVideoPoolTester") << test;
+		numFailed++;
+	}
+}
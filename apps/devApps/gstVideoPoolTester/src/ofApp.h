@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofGstVideoPool.h"
+
+// plays several videotestsrc pipelines of 2 seconds in an ofGstVideoPool
+// for 5 seconds and checks after every update that all of them show the
+// frame with the same timestamp, that updating them afterwards like
+// ofVideoPlayer does doesn't change the frame the pool chose, and that
+// the pool loops. needs gstreamer, so it only runs on linux
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void check(bool bOk, string test);
+
+		static const int numVideos = 4;
+		ofGstVideoUtils videos[numVideos];
+		ofGstVideoPool pool;
+		int numFailed;
+};
@@ -0,0 +1,99 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	parameters.setName("parameters");
+	for(int i=0;i<4;i++){
+		parameters.add(floats[i].set("float"+ofToString(i),0.5,0,1));
+	}
+	parameters.add(toggle.set("toggle",false));
+
+	directPanel.setup(parameters,"settings.xml",10,10);
+	directPanel.add(directMarker.setup("marker",""));
+
+	fboPanel.setup(parameters,"settings.xml",10,10);
+	fboPanel.add(fboMarker.setup("marker",""));
+	fboPanel.enableCache(ofxPanel::CACHE_FBO);
+
+	pixelsPanel.setup(parameters,"settings.xml",10,10);
+	pixelsPanel.add(pixelsMarker.setup("marker",""));
+	pixelsPanel.enableCache(ofxPanel::CACHE_PIXELS);
+
+	numFrames = 0;
+	numFailed = 0;
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	// a couple of values change every frame so most redraws are partial
+	floats[numFrames%4] = ofRandom(1);
+	if(numFrames%5==0){
+		toggle = !toggle;
+	}
+
+	if(numFrames==30){
+		ofLogNotice("guiCacheTester") << "not flipped";
+		ofSetOrientation(OF_ORIENTATION_DEFAULT,false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::drawPanel(ofxPanel & panel, ofImage & screen){
+	// a colored background so wrong alpha in the cache shows up
+	ofBackground(200,120,40);
+	panel.draw();
+	screen.grabScreen(0,0,ofGetWidth(),ofGetHeight());
+}
+
+//--------------------------------------------------------------
+int ofApp::countDifferentPixels(ofImage & a, ofImage & b){
+	// the fbo cache rounds the colors when premultiplying
+	const int tolerance = 3;
+	int numDifferent = 0;
+	ofPixels & pa = a.getPixelsRef();
+	ofPixels & pb = b.getPixelsRef();
+	for(int i=0;i<pa.size();i+=pa.getNumChannels()){
+		for(int c=0;c<pa.getNumChannels();c++){
+			if(abs(pa[i+c]-pb[i+c])>tolerance){
+				numDifferent++;
+				break;
+			}
+		}
+	}
+	return numDifferent;
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("guiCacheTester") << "frame " << numFrames << ": " << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	drawPanel(directPanel,directScreen);
+	drawPanel(fboPanel,fboScreen);
+	check(countDifferentPixels(directScreen,fboScreen)==0,"the fbo cache is different from the panel drawn directly");
+
+	// the pixels are rendered with cairo, the text is different so
+	// only the element that can't be batched is checked
+	pixelsPanel.draw();
+	ofPixels & pixels = pixelsPanel.getCachePixels();
+	ofRectangle marker = pixelsMarker.getShape();
+	ofPoint center = marker.getCenter() - pixelsPanel.getCacheArea().getPosition();
+	check(pixels.isAllocated() && pixels.getColor(center.x,center.y)==ofColor(255,0,0),"the pixels cache doesn't contain the element that can't be batched");
+
+	numFrames++;
+	if(numFrames==60){
+		check(fboPanel.getNumCachePartialRedraws()>0,"the fbo cache was never partially redrawn");
+		check(pixelsPanel.getNumCachePartialRedraws()>0,"the pixels cache was never partially redrawn");
+		ofLogNotice("guiCacheTester") << "fbo cache: " << fboPanel.getNumCacheFullRedraws() << " full and "
+				<< fboPanel.getNumCachePartialRedraws() << " partial redraws";
+		ofLogNotice("guiCacheTester") << "pixels cache: " << pixelsPanel.getNumCacheFullRedraws() << " full and "
+				<< pixelsPanel.getNumCachePartialRedraws() << " partial redraws";
+		ofLogNotice("guiCacheTester") << (numFailed ? "FAILED" : "passed");
+		ofExit(numFailed ? 1 : 0);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxGui.h"
+
+// draws the same parameters with a panel without cache and with panels
+// cached in an fbo and in pixels, changing some values every frame, and
+// checks that the cached panels look the same as the one drawn directly.
+// the fbo cache is checked with the screen vertically flipped, the
+// default, and not flipped, so the scissor used for the partial redraws
+// and the premultiplied alpha of the cache are tested in both
+
+// an element that can't be batched, the cached panels have to draw it
+// apart from the rest
+class MarkerLabel: public ofxLabel{
+protected:
+	void render(){
+		ofPushStyle();
+		ofSetColor(255,0,0);
+		ofFill();
+		ofRect(b);
+		ofPopStyle();
+	}
+	bool isBatchable(){
+		return false;
+	}
+};
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+		void update();
+		void draw();
+
+		void drawPanel(ofxPanel & panel, ofImage & screen);
+		int countDifferentPixels(ofImage & a, ofImage & b);
+		void check(bool bOk, string test);
+
+		ofParameterGroup parameters;
+		ofParameter<float> floats[4];
+		ofParameter<bool> toggle;
+
+		ofxPanel directPanel, fboPanel, pixelsPanel;
+		MarkerLabel directMarker, fboMarker, pixelsMarker;
+		ofImage directScreen, fboScreen;
+
+		int numFrames;
+		int numFailed;
+};
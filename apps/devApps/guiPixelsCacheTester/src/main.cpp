@@ -0,0 +1,13 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+
+	// the tests don't draw anything, they run in setup and exit
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window, 1024,768, OF_WINDOW);
+	ofRunApp( new ofApp());
+
+}
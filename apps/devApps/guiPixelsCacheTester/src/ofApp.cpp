@@ -0,0 +1,62 @@
+#include "ofApp.h"
+
+static const int numFrames = 60;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	parameters.setName("parameters");
+	for(int i=0;i<4;i++){
+		parameters.add(floats[i].set("float"+ofToString(i),0.5,0,1));
+	}
+	parameters.add(toggle.set("toggle",false));
+
+	partialPanel.setup(parameters,"settings.xml",10,10);
+	partialPanel.add(partialMarker.setup("marker",""));
+	partialPanel.enableCache(ofxPanel::CACHE_PIXELS);
+
+	fullPanel.setup(parameters,"settings.xml",10,10);
+	fullPanel.add(fullMarker.setup("marker",""));
+
+	for(int frame=0;frame<numFrames;frame++){
+		// a couple of values change every frame so most redraws are partial
+		floats[frame%4] = ofRandom(1);
+		if(frame%5==0){
+			toggle = !toggle;
+		}
+
+		partialPanel.draw();
+		// enabling the cache again always redraws all of it
+		fullPanel.disableCache();
+		fullPanel.enableCache(ofxPanel::CACHE_PIXELS);
+		fullPanel.draw();
+
+		ofPixels & partial = partialPanel.getCachePixels();
+		ofPixels & full = fullPanel.getCachePixels();
+		bool bEqual = partial.isAllocated() && full.isAllocated()
+				&& partial.getWidth()==full.getWidth() && partial.getHeight()==full.getHeight()
+				&& memcmp(partial.getPixels(),full.getPixels(),partial.size())==0;
+		check(bEqual,"frame " + ofToString(frame) + ": the partially redrawn pixels are different from the full redraw");
+
+		ofPoint center = partialMarker.getShape().getCenter() - partialPanel.getCacheArea().getPosition();
+		check(partial.isAllocated() && partial.getColor(center.x,center.y)==ofColor(255,0,0),
+				"frame " + ofToString(frame) + ": the pixels don't contain the element that can't be batched");
+	}
+
+	check(partialPanel.getNumCacheFullRedraws()==1,"the pixels were completely redrawn more than once");
+	check(partialPanel.getNumCachePartialRedraws()>0,"the pixels were never partially redrawn");
+	ofLogNotice("guiPixelsCacheTester") << numFrames << " frames: " << partialPanel.getNumCacheFullRedraws() << " full and "
+			<< partialPanel.getNumCachePartialRedraws() << " partial redraws";
+
+	ofLogNotice("guiPixelsCacheTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("guiPixelsCacheTester") << test;
+		numFailed++;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxGui.h"
+
+// checks the CACHE_PIXELS mode of ofxPanel without a gl context: a panel
+// whose cache is only partially redrawn when some values change has to
+// end with the same pixels as a panel whose cache is redrawn completely
+// every frame
+
+// an element that can't be batched, it's drawn into the pixels through
+// the cairo renderer of the cache
+class MarkerLabel: public ofxLabel{
+protected:
+	void render(){
+		ofPushStyle();
+		ofSetColor(255,0,0);
+		ofFill();
+		ofRect(b);
+		ofPopStyle();
+	}
+	bool isBatchable(){
+		return false;
+	}
+};
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void check(bool bOk, string test);
+
+		ofParameterGroup parameters;
+		ofParameter<float> floats[4];
+		ofParameter<bool> toggle;
+
+		ofxPanel partialPanel, fullPanel;
+		MarkerLabel partialMarker, fullMarker;
+
+		int numFailed;
+};
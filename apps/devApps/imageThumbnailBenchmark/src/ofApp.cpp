@@ -0,0 +1,101 @@
+#include "ofApp.h"
+
+static const int thumbnailSize = 256;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	bFailed = false;
+
+	ofDirectory dir("images");
+	dir.allowExt("jpg");
+	dir.allowExt("jpeg");
+	if(!dir.exists() || dir.listDir()==0){
+		generateImages(dir.getAbsolutePath(),4);
+		dir.listDir();
+	}
+
+	unsigned long long elapsedFull = 0, elapsedScaled = 0;
+	float maxDifference = 0;
+	for(int i=0;i<(int)dir.size();i++){
+		ofPixels full, scaled;
+
+		unsigned long long start = ofGetElapsedTimeMicros();
+		bool bLoaded = makeThumbnail(dir.getPath(i),false,full);
+		elapsedFull += ofGetElapsedTimeMicros() - start;
+
+		start = ofGetElapsedTimeMicros();
+		bLoaded &= makeThumbnail(dir.getPath(i),true,scaled);
+		elapsedScaled += ofGetElapsedTimeMicros() - start;
+
+		if(!bLoaded){
+			ofLogError("imageThumbnailBenchmark") << "couldn't load " << dir.getPath(i);
+			bFailed = true;
+			continue;
+		}
+
+		// the rounding of the scaled size can make them differ in a pixel
+		if(scaled.getWidth()!=full.getWidth() || scaled.getHeight()!=full.getHeight()){
+			scaled.resize(full.getWidth(),full.getHeight());
+		}
+
+		// the full decode skips pixels instead of averaging them so the
+		// thumbnails are not equal
+		float difference = 0;
+		int numValues = full.getWidth()*full.getHeight()*full.getNumChannels();
+		for(int j=0;j<numValues;j++){
+			difference += abs(full[j]-scaled[j]);
+		}
+		maxDifference = max(maxDifference,difference/numValues);
+	}
+
+	if(dir.size()){
+		ofLogNotice("imageThumbnailBenchmark") << dir.size() << " images to " << thumbnailSize << "px thumbnails";
+		ofLogNotice("imageThumbnailBenchmark") << "full decode and resize: " << elapsedFull/1000./dir.size() << "ms per image";
+		ofLogNotice("imageThumbnailBenchmark") << "scaled decode: " << elapsedScaled/1000./dir.size() << "ms per image";
+		ofLogNotice("imageThumbnailBenchmark") << "mean difference between the thumbnails: " << maxDifference << " at most";
+	}
+
+	ofLogNotice("imageThumbnailBenchmark") << (bFailed ? "FAILED" : "passed");
+	ofExit(bFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::generateImages(string path, int numImages){
+	ofLogNotice("imageThumbnailBenchmark") << "generating " << numImages << " 6000x4000 images in " << path;
+	ofDirectory::createDirectory(path,false,true);
+	ofPixels pix;
+	pix.allocate(6000,4000,OF_PIXELS_RGB);
+	for(int i=0;i<numImages;i++){
+		// smooth gradients with some noise compress like a photo
+		for(int y=0;y<pix.getHeight();y++){
+			for(int x=0;x<pix.getWidth();x++){
+				int idx = (y*pix.getWidth()+x)*3;
+				pix[idx]   = ofClamp(127 + 100*sin(x*0.002f + i) + ofRandom(-10,10), 0, 255);
+				pix[idx+1] = ofClamp(127 + 100*cos(y*0.003f - i) + ofRandom(-10,10), 0, 255);
+				pix[idx+2] = ofClamp(127 + 100*sin((x+y)*0.001f) + ofRandom(-10,10), 0, 255);
+			}
+		}
+		ofSaveImage(pix,ofFilePath::join(path,"generated" + ofToString(i) + ".jpg"),OF_IMAGE_QUALITY_HIGH);
+	}
+}
+
+//--------------------------------------------------------------
+bool ofApp::makeThumbnail(string path, bool bScaledLoad, ofPixels & thumbnail){
+	bool bLoaded;
+	if(bScaledLoad){
+		bLoaded = ofLoadImage(thumbnail,path,thumbnailSize,thumbnailSize);
+		// the scaled image fits in the size but can be up to half of it
+		if(bLoaded && (thumbnail.getWidth()>thumbnailSize || thumbnail.getHeight()>thumbnailSize
+				|| max(thumbnail.getWidth(),thumbnail.getHeight())<thumbnailSize/2)){
+			ofLogError("imageThumbnailBenchmark") << path << " loaded at " << thumbnail.getWidth() << "x" << thumbnail.getHeight()
+					<< " to fit in " << thumbnailSize << "x" << thumbnailSize;
+			bFailed = true;
+		}
+	}else{
+		bLoaded = ofLoadImage(thumbnail,path);
+	}
+	if(!bLoaded) return false;
+
+	float scale = min(thumbnailSize/(float)thumbnail.getWidth(), thumbnailSize/(float)thumbnail.getHeight());
+	return thumbnail.resize(thumbnail.getWidth()*scale, thumbnail.getHeight()*scale);
+}
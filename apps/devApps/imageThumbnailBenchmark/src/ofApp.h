@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ofMain.h"
+
+// makes thumbnails of every jpeg in bin/data/images, decoding the whole
+// image and resizing it vs loading it scaled down with ofLoadImage.
+// if the folder has no images a few 24MP ones are generated first
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void generateImages(string path, int numImages);
+		bool makeThumbnail(string path, bool bScaledLoad, ofPixels & thumbnail);
+
+		bool bFailed;
+};
@@ -0,0 +1,154 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	testHierarchy();
+	testCopies();
+	testAssignment();
+	testExternalParent();
+
+	ofLogNotice("nodeGraphTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("nodeGraphTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+static bool isNear(const ofVec3f & a, const ofVec3f & b){
+	return a.distance(b) < 0.001;
+}
+
+//--------------------------------------------------------------
+// the global position walking up the parents, without the graph
+static ofVec3f getRecursivePosition(const ofNode & node){
+	ofMatrix4x4 m = node.getLocalTransformMatrix();
+	for(ofNode * parent = node.getParent(); parent; parent = parent->getParent()){
+		m = m * parent->getLocalTransformMatrix();
+	}
+	return m.getTranslation();
+}
+
+//--------------------------------------------------------------
+void ofApp::testHierarchy(){
+	ofNodeGraph graph;
+	ofNode nodes[10];
+	// added from the leaf up so the graph has to sort them
+	for(int i=9;i>=0;i--){
+		if(i>0) nodes[i].setParent(nodes[i-1]);
+		nodes[i].setPosition(1,0,0);
+		nodes[i].roll(10);
+		graph.add(nodes[i]);
+	}
+	graph.update();
+	check(graph.size()==10,"every node is in the graph");
+	check(isNear(nodes[9].getGlobalPosition(),getRecursivePosition(nodes[9])),"global position of a leaf");
+
+	nodes[0].setPosition(0,5,0);
+	check(isNear(nodes[9].getGlobalPosition(),getRecursivePosition(nodes[9])),"global position after moving the root without updating");
+	graph.update();
+	check(isNear(nodes[9].getGlobalPosition(),getRecursivePosition(nodes[9])),"global position after moving the root");
+}
+
+//--------------------------------------------------------------
+void ofApp::testCopies(){
+	// a vector copies its nodes every time it grows, so they are added
+	// to the graph once it's filled
+	ofNodeGraph graph;
+	ofNode root;
+	root.setPosition(0,0,-10);
+	graph.add(root);
+	vector<ofNode> nodes;
+	for(int i=0;i<100;i++){
+		ofNode node;
+		node.setParent(root);
+		node.setPosition(i,0,0);
+		nodes.push_back(node);
+	}
+	graph.update();
+	check(graph.size()==1,"copies are not added to the graph");
+	for(int i=0;i<(int)nodes.size();i++){
+		graph.add(nodes[i]);
+	}
+	graph.update();
+	check(graph.size()==101,"nodes in a vector are in the graph");
+
+	bool bAllNear = true;
+	for(int i=0;i<(int)nodes.size();i++){
+		bAllNear &= isNear(nodes[i].getGlobalPosition(),ofVec3f(i,0,-10));
+	}
+	check(bAllNear,"global position of the nodes in a vector");
+
+	root.setPosition(0,0,10);
+	graph.update();
+	check(isNear(nodes[50].getGlobalPosition(),ofVec3f(50,0,10)),"nodes in a vector are updated with the graph");
+
+	// temporary copies don't change the graph
+	{
+		ofNode copy(nodes[10]);
+		check(isNear(copy.getGlobalPosition(),ofVec3f(10,0,10)),"global position of a copy");
+	}
+	check(graph.isUpToDate() && graph.size()==101,"a temporary copy leaves the graph up to date");
+}
+
+//--------------------------------------------------------------
+void ofApp::testAssignment(){
+	ofNodeGraph graph, other;
+	ofNode a, b, c;
+	graph.add(a);
+	other.add(b);
+
+	// an assigned node keeps its graph
+	b.setPosition(1,2,3);
+	a = b;
+	graph.update();
+	other.update();
+	check(graph.size()==1 && other.size()==1,"an assigned node stays in its graph");
+	check(isNear(a.getGlobalPosition(),ofVec3f(1,2,3)),"global position of an assigned node");
+
+	// and doesn't join the graph of the other node if it wasn't in any
+	c = b;
+	check(other.size()==1 && other.isUpToDate(),"an assigned node without graph stays out of the graph of the other");
+}
+
+//--------------------------------------------------------------
+void ofApp::testExternalParent(){
+	ofNodeGraph graph, parentGraph;
+	ofNode parent, grandParent, child;
+	parent.setParent(grandParent);
+	child.setParent(parent);
+	child.setPosition(1,0,0);
+	parentGraph.add(parent);
+	graph.add(child);
+	graph.update();
+	parentGraph.update();
+
+	// the graph only contains the nodes added to it
+	check(graph.size()==1 && parentGraph.size()==1,"parents are not pulled into the graph of their children");
+
+	// the parents can change without the graph knowing
+	grandParent.setPosition(0,10,0);
+	check(isNear(child.getGlobalPosition(),ofVec3f(1,10,0)),"global position after moving a parent outside of the graph");
+	parentGraph.update();
+	graph.update();
+	check(isNear(child.getGlobalPosition(),ofVec3f(1,10,0)),"global position after updating the graphs");
+
+	// removing a parent from the graph leaves its children out of the cache
+	ofNode inside;
+	graph.add(parent);
+	graph.add(inside);
+	inside.setParent(parent);
+	graph.update();
+	check(parentGraph.size()==0 && graph.size()==3,"a node added to another graph leaves the first one");
+	graph.remove(parent);
+	graph.update();
+	parent.setPosition(0,0,5);
+	check(isNear(inside.getGlobalPosition(),ofVec3f(0,10,5)),"global position after removing the parent from the graph");
+}
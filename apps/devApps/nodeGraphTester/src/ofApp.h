@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks that the global matrices cached by ofNodeGraph are the same as
+// the ones computed walking up the parents, for copies of nodes and
+// hierarchies that are only partly in the graph
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void testHierarchy();
+		void testCopies();
+		void testAssignment();
+		void testExternalParent();
+
+		void check(bool bOk, string test);
+
+		int numFailed;
+};
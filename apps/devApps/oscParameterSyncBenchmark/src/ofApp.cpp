@@ -0,0 +1,102 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	port = 6666;
+	bFailed = false;
+
+	benchmarkDrag();
+	benchmarkPreset(256,false);
+	benchmarkPreset(256,true);
+	// the snapshot doesn't fit in a packet, it has to fall back to bundles
+	benchmarkPreset(2000,true);
+	// bigger packets than ofxOscReceiver reads are clamped so the
+	// snapshot still arrives
+	benchmarkPreset(800,true,65536);
+
+	ofLogNotice("oscParameterSyncBenchmark") << (bFailed ? "FAILED" : "all values received");
+	ofExit(bFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::setupSync(int numParams){
+	localSync.reset();
+	remoteSync.reset();
+
+	localGroup.clear();
+	remoteGroup.clear();
+	localGroup.setName("sync");
+	remoteGroup.setName("sync");
+	// every parameter is created on its own, copies would share the value
+	for(int i=0;i<numParams;i++){
+		ofParameter<float> local, remote;
+		localGroup.add(local.set("p"+ofToString(i),0,0,1));
+		remoteGroup.add(remote.set("p"+ofToString(i),0,0,1));
+	}
+
+	// new ports every time so the sockets of the previous case don't interfere
+	localSync = ofPtr<ofxOscParameterSync>(new ofxOscParameterSync);
+	remoteSync = ofPtr<ofxOscParameterSync>(new ofxOscParameterSync);
+	localSync->setup(localGroup,port,"localhost",port+1);
+	remoteSync->setup(remoteGroup,port+1,"localhost",port);
+	port += 2;
+}
+
+//--------------------------------------------------------------
+bool ofApp::waitForRemote(int timeoutMs){
+	unsigned long long start = ofGetElapsedTimeMillis();
+	while(ofGetElapsedTimeMillis() - start < (unsigned long long)timeoutMs){
+		remoteSync->update();
+		bool bEqual = true;
+		for(int i=0;i<localGroup.size() && bEqual;i++){
+			bEqual = localGroup[i].cast<float>().get()==remoteGroup[i].cast<float>().get();
+		}
+		if(bEqual) return true;
+		ofSleepMillis(1);
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void ofApp::report(string name, int numChanges, bool bReceived){
+	ofLogNotice("oscParameterSyncBenchmark") << name << ": "
+			<< numChanges << " changes, "
+			<< localSync->getNumParametersSent() << " parameters sent in "
+			<< localSync->getNumPacketsSent() << " packets"
+			<< (bReceived ? "" : ", the other side didn't receive all the values");
+	bFailed |= !bReceived;
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkDrag(){
+	// a slider dragged for a second changes several times per frame,
+	// the changes have to go through the parameter in the group so
+	// the group is notified
+	setupSync(64);
+	ofParameter<float> & dragged = localGroup[0].cast<float>();
+	int numChanges = 0;
+	for(int frame=0;frame<60;frame++){
+		for(int i=0;i<10;i++){
+			dragged = ofRandom(1);
+			numChanges++;
+		}
+		localSync->update();
+	}
+	report("drag",numChanges,waitForRemote(1000));
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkPreset(int numParams, bool bSnapshots, int maxPacketSize){
+	// loading a preset changes every parameter in the same frame
+	setupSync(numParams);
+	localSync->setMaxPacketSize(maxPacketSize);
+	if(bSnapshots){
+		localSync->enableSnapshots();
+	}
+	for(int i=0;i<numParams;i++){
+		localGroup[i].cast<float>() = ofRandom(1);
+	}
+	localSync->update();
+	report("preset " + ofToString(numParams) + (bSnapshots ? " with snapshots" : "")
+			+ " in " + ofToString(localSync->getMaxPacketSize()) + " byte packets",numParams,waitForRemote(2000));
+}
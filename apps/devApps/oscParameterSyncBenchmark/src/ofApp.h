@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+#include "ofxOscParameterSync.h"
+
+// sends parameter changes between two ofxOscParameterSync in the same
+// app through the loopback interface and counts the packets needed for
+// some typical cases, checking that the other side ends up with the
+// same values
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void setupSync(int numParams);
+		bool waitForRemote(int timeoutMs);
+		void report(string name, int numChanges, bool bReceived);
+
+		void benchmarkDrag();
+		void benchmarkPreset(int numParams, bool bSnapshots, int maxPacketSize = 1472);
+
+		ofParameterGroup localGroup, remoteGroup;
+		ofPtr<ofxOscParameterSync> localSync, remoteSync;
+		int port;
+		bool bFailed;
+};
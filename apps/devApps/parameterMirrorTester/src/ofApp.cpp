@@ -0,0 +1,120 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void MirrorReader::threadedFunction(){
+	// the writer only increases the value and sets the 3 coordinates to
+	// the same number, anything else is a value copied while being written
+	float last = mirror.get().x;
+	while(isThreadRunning()){
+		if(mirror.update()){
+			const ofVec3f & v = mirror.get();
+			numChanges++;
+			if(v.x!=v.y || v.x!=v.z) numTorn++;
+			if(v.x<=last) numOlder++;
+			last = v.x;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	group.setName("group");
+	group.add(value.set("value",0,0,1));
+	group.add(position.set("position",ofVec3f(0),ofVec3f(0),ofVec3f(1000000)));
+
+	testCoalescing();
+	testPublish();
+	testClose();
+	testThreads();
+
+	ofLogNotice("parameterMirrorTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("parameterMirrorTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::testCoalescing(){
+	value = 0.25;
+	ofParameterMirror<float> mirror;
+	mirror.setup(value);
+	check(mirror==0.25f,"the mirror starts with the value of the parameter");
+	check(!mirror.update(),"no changes before the parameter changes");
+
+	value = 0.5;
+	value = 0.75;
+	value = 1;
+	check(mirror==0.25f,"the mirror only changes in update()");
+	check(mirror.update(),"update() after several changes");
+	check(mirror==1.f,"update() takes the last value");
+	check(!mirror.update(),"all the changes are taken in one update()");
+
+	value = 0.5;
+	value = 1;
+	check(!mirror.update(),"changes back to the same value are not a change");
+}
+
+//--------------------------------------------------------------
+void ofApp::testPublish(){
+	value = 0;
+	ofParameterSnapshot snapshot;
+	group.getSnapshot(snapshot);
+	value = 1;
+
+	ofParameterMirror<float> mirror;
+	mirror.setup(value);
+	group.setSnapshot(snapshot);
+	check(!mirror.update() && mirror==1.f,"a snapshot applied without events isn't seen");
+	mirror.publish();
+	check(mirror.update() && mirror==0.f,"publish() after applying the snapshot");
+}
+
+//--------------------------------------------------------------
+void ofApp::testClose(){
+	value = 0;
+	ofParameterMirror<float> mirror;
+	mirror.setup(value);
+	mirror.close();
+	value = 1;
+	check(!mirror.update() && mirror==0.f,"a closed mirror doesn't see changes");
+
+	mirror.setup(value);
+	check(mirror==1.f,"setup() again takes the current value");
+}
+
+//--------------------------------------------------------------
+void ofApp::testThreads(){
+	position = ofVec3f(0);
+	MirrorReader reader;
+	reader.numChanges = 0;
+	reader.numTorn = 0;
+	reader.numOlder = 0;
+	reader.mirror.setup(position);
+	reader.startThread(false,false);
+
+	int numWrites = 200000;
+	for(int i=1;i<=numWrites;i++){
+		position = ofVec3f(i);
+		// give the reader a chance to run on machines with only one core
+		if(i%1000==0) ofSleepMillis(1);
+	}
+	reader.waitForThread(true);
+
+	ofLogNotice("parameterMirrorTester") << numWrites << " changes written, "
+			<< reader.numChanges << " read in the other thread";
+	check(reader.numChanges>0,"the reading thread sees the changes");
+	check(reader.numTorn==0,"the reading thread never sees a value while it's written");
+	check(reader.numOlder==0,"the reading thread never goes back to an older value");
+
+	// the reading thread is stopped so this thread can read the mirror now
+	reader.mirror.update();
+	check(reader.mirror.get()==ofVec3f(numWrites),"the mirror ends with the last value");
+}
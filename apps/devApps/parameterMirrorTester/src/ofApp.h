@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks ofParameterMirror: that update() coalesces the changes, that
+// changes made without events need publish() and that a mirror read from
+// another thread while the parameter changes never sees a torn or an
+// older value
+
+class MirrorReader : public ofThread{
+	public:
+		void threadedFunction();
+
+		ofParameterMirror<ofVec3f> mirror;
+		int numChanges;
+		int numTorn;
+		int numOlder;
+};
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void testCoalescing();
+		void testPublish();
+		void testClose();
+		void testThreads();
+
+		void check(bool bOk, string test);
+
+		ofParameter<float> value;
+		ofParameter<ofVec3f> position;
+		ofParameterGroup group;
+
+		int numFailed;
+};
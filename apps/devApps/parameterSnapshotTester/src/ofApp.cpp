@@ -0,0 +1,158 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+	numSnapshotsApplied = 0;
+	numFloatsChanged = 0;
+
+	group.setName("group");
+	for(int i=0;i<3;i++){
+		group.add(floats[i].set("float"+ofToString(i),0,0,1));
+	}
+	for(int i=0;i<2;i++){
+		group.add(ints[i].set("int"+ofToString(i),0,0,10));
+	}
+	group.add(text.set("text","a"));
+	subgroup.setName("subgroup");
+	subgroup.add(subFloat.set("float",0,0,1));
+	group.add(subgroup);
+
+	group.addSnapshotListener(this,&ofApp::snapshotApplied);
+	floats[0].addListener(this,&ofApp::floatChanged);
+
+	testApply();
+	testLerp();
+	testBinary();
+	testCopies();
+	testLayoutChanges();
+
+	ofLogNotice("parameterSnapshotTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+void ofApp::snapshotApplied(ofParameterGroup & group){
+	numSnapshotsApplied++;
+}
+
+//--------------------------------------------------------------
+void ofApp::floatChanged(float & value){
+	numFloatsChanged++;
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("parameterSnapshotTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::testApply(){
+	check(group.getNumNumericParameters()==6,"3 floats, 2 ints and the float of the subgroup are numeric");
+
+	floats[0] = 0.25;
+	ints[1] = 7;
+	text = "b";
+	subFloat = 0.5;
+	ofParameterSnapshot snapshot;
+	group.getSnapshot(snapshot);
+
+	floats[0] = 1;
+	ints[1] = 0;
+	text = "c";
+	subFloat = 0;
+	numSnapshotsApplied = 0;
+	numFloatsChanged = 0;
+	check(group.setSnapshot(snapshot),"a snapshot applies to the group it was taken from");
+	check(floats[0]==0.25f && ints[1]==7 && text.get()=="b" && subFloat==0.5f,"values after applying a snapshot");
+	check(numSnapshotsApplied==1 && numFloatsChanged==0,"applying a snapshot notifies once and not the parameters");
+
+	group.setSnapshot(snapshot);
+	check(numSnapshotsApplied==1,"applying a snapshot that changes nothing doesn't notify");
+
+	floats[0] = 1;
+	numFloatsChanged = 0;
+	group.setSnapshot(snapshot,true);
+	check(numFloatsChanged==1,"applying a snapshot notifying the parameters");
+}
+
+//--------------------------------------------------------------
+void ofApp::testLerp(){
+	ofParameterSnapshot from, to;
+	floats[1] = 0;
+	ints[0] = 0;
+	group.getSnapshot(from);
+	floats[1] = 1;
+	ints[0] = 3;
+	group.getSnapshot(to);
+
+	numSnapshotsApplied = 0;
+	check(group.lerp(from,to,0.5),"interpolating snapshots of the group");
+	check(fabs(floats[1]-0.5f)<0.0001 && ints[0]==2,"interpolated values, ints are rounded");
+	check(numSnapshotsApplied==1,"interpolating notifies once");
+}
+
+//--------------------------------------------------------------
+void ofApp::testBinary(){
+	ofParameterSnapshot snapshot, loaded;
+	group.getSnapshot(snapshot);
+	ofBuffer buffer;
+	snapshot.saveToBuffer(buffer);
+	check(loaded.loadFromBuffer(buffer),"loading a saved snapshot");
+	check(loaded.getValues()==snapshot.getValues() && loaded.getLayoutHash()==snapshot.getLayoutHash(),"a loaded snapshot is equal to the saved one");
+
+	ofBuffer truncated(buffer.getBinaryBuffer(),buffer.size()-1);
+	check(!loaded.loadFromBuffer(truncated),"a truncated snapshot doesn't load");
+}
+
+//--------------------------------------------------------------
+void ofApp::testCopies(){
+	// guis and getGroup() work with copies of the group, the listeners
+	// of the original have to be notified anyway
+	ofParameterSnapshot snapshot;
+	group.getSnapshot(snapshot);
+	floats[2] = floats[2]>0.5 ? 0 : 1;
+
+	numSnapshotsApplied = 0;
+	ofParameterGroup copy = group;
+	copy.setSnapshot(snapshot);
+	check(numSnapshotsApplied==1,"applying a snapshot to a copy notifies the listeners of the original");
+
+	int numSubgroupApplied = numSnapshotsApplied;
+	subgroup.addSnapshotListener(this,&ofApp::snapshotApplied);
+	ofParameterSnapshot subSnapshot;
+	subgroup.getSnapshot(subSnapshot);
+	subFloat = subFloat>0.5 ? 0 : 1;
+	group.getGroup("subgroup").setSnapshot(subSnapshot);
+	check(numSnapshotsApplied==numSubgroupApplied+1,"applying a snapshot to a group returned by getGroup() notifies the listeners of the subgroup");
+	subgroup.removeSnapshotListener(this,&ofApp::snapshotApplied);
+}
+
+//--------------------------------------------------------------
+void ofApp::testLayoutChanges(){
+	// snapshots taken before the layout changes don't apply anymore
+	ofParameterSnapshot before, after;
+	group.getSnapshot(before);
+
+	floats[1].setName("renamed");
+	group.getSnapshot(after);
+	check(after.getLayoutHash()!=before.getLayoutHash(),"renaming a parameter changes the layout");
+	check(!group.setSnapshot(before),"a snapshot from before renaming a parameter doesn't apply");
+
+	group.getSnapshot(before);
+	subgroup.setName("renamedSubgroup");
+	group.getSnapshot(after);
+	check(after.getLayoutHash()!=before.getLayoutHash(),"renaming a subgroup changes the layout");
+
+	int numNumeric = group.getNumNumericParameters();
+	floats[2].setSerializable(false);
+	check(group.getNumNumericParameters()==numNumeric-1,"parameters that aren't serializable are not in the snapshots");
+	subgroup.setSerializable(false);
+	check(group.getNumNumericParameters()==numNumeric-2,"subgroups that aren't serializable are not in the snapshots");
+	floats[2].setSerializable(true);
+	subgroup.setSerializable(true);
+	check(group.getNumNumericParameters()==numNumeric,"parameters made serializable again are in the snapshots");
+}
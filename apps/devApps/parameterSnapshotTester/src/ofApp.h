@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks ofParameterSnapshot and the snapshot methods of ofParameterGroup:
+// applying, interpolating and serializing snapshots, the notification of
+// the listeners through copies of the group and that renaming parameters
+// or changing if they are serializable changes the layout of the group
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		void testApply();
+		void testLerp();
+		void testBinary();
+		void testCopies();
+		void testLayoutChanges();
+
+		void snapshotApplied(ofParameterGroup & group);
+		void floatChanged(float & value);
+		void check(bool bOk, string test);
+
+		ofParameterGroup group, subgroup;
+		ofParameter<float> floats[3];
+		ofParameter<int> ints[2];
+		ofParameter<string> text;
+		ofParameter<float> subFloat;
+
+		int numSnapshotsApplied;
+		int numFloatsChanged;
+		int numFailed;
+};
@@ -0,0 +1,184 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	testPaths();
+	testSetters();
+	testReader();
+	testStop();
+	benchmark(50000);
+
+	ofLogNotice("xmlPathTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+string ofApp::makeScene(int numObjects){
+	string xml = "<scene><camera fov=\"60\"><near>0.1</near><far>1000</far></camera><objects>";
+	for(int i=0;i<numObjects;i++){
+		xml += "<object id=\"o" + ofToString(i) + "\"><pos>" + ofToString(i) + "</pos><mesh>m" + ofToString(i%10) + "</mesh></object>";
+	}
+	xml += "</objects></scene>";
+	return xml;
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("xmlPathTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::testPaths(){
+	ofXml xml;
+	xml.loadFromBuffer(makeScene(4));
+
+	const char * paths[] = {
+		"camera/far",
+		"objects/object/pos",
+		"objects/object[2]/pos",
+		"objects/object[@id='o3']/pos",
+		"objects/object[@id]",
+		"camera[@fov]",
+	};
+	for(int i=0;i<6;i++){
+		ofXmlPath path(paths[i]);
+		check(path.isValid(),string(paths[i]) + " is valid");
+		check(xml.exists(path),string(paths[i]) + " exists");
+		string value = path.selectsAttribute() ? xml.getAttribute(path) : xml.getValue(path);
+		string expected = path.selectsAttribute() ? xml.getAttribute(paths[i]) : xml.getValue(paths[i]);
+		check(value==expected,string(paths[i]) + ": " + value + " with the compiled path, " + expected + " with the string");
+	}
+
+	check(xml.getIntValue(ofXmlPath("objects/object[@id='o3']/pos"))==3,"filter by attribute value");
+	check(xml.getAttribute(ofXmlPath("objects/object[1]/@id"))=="o1","attribute as the last step");
+	check(xml.getValue(ofXmlPath("//mesh"))=="m0","recursive path");
+	check(xml.getFloatValue(ofXmlPath("camera/near"))==0.1f,"float value");
+	check(!xml.exists(ofXmlPath("objects/object[4]")),"index past the last element");
+	check(!xml.exists(ofXmlPath("objects/light")),"missing element");
+	check(!ofXmlPath("objects/object[").isValid(),"unfinished index is invalid");
+
+	ofXml object = xml;
+	check(object.setTo(ofXmlPath("objects/object[2]")),"setTo");
+	check(object.getName()=="object" && object.getAttribute("id")=="o2","setTo moves to the element");
+	check(object.getValue(ofXmlPath("pos"))=="2","paths are relative to the current element");
+}
+
+//--------------------------------------------------------------
+void ofApp::testSetters(){
+	ofXml xml;
+	xml.loadFromBuffer(makeScene(4));
+
+	ofXmlPath fov("camera/@fov");
+	check(xml.setAttribute(fov,"90") && xml.getAttribute("camera[@fov]")=="90","set an attribute");
+	ofXmlPath pos("objects/object[@id='o1']/pos");
+	check(xml.setValue(pos,"10") && xml.getValue("objects/object[1]/pos")=="10","set a value");
+	check(!xml.setValue(ofXmlPath("objects/light"),"1"),"setting a missing element fails");
+}
+
+//--------------------------------------------------------------
+void ofApp::objectRead(ofXmlReaderEventArgs & args){
+	objectIds.push_back(args.xml.getAttribute("[@id]"));
+	// every object is a small document with only that element
+	if(args.path!=elementPath || args.xml.getName()!="object" || args.xml.getIntValue("pos")!=(int)objectIds.size()-1){
+		numObjectErrors++;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::stopReading(ofXmlReaderEventArgs & args){
+	objectIds.push_back(args.xml.getAttribute("[@id]"));
+	if(objectIds.size()==2){
+		reader.stop();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::testReader(){
+	reader.clearPaths();
+	int far = reader.addPath("camera/far");
+	int fov = reader.addPath("camera/@fov");
+	int positions = reader.addPath("objects/object/pos");
+	int meshes = reader.addPath("//mesh");
+	int third = reader.addPath("objects/object[2]/pos");
+	int filtered = reader.addPath("objects/object[@id='o3']/mesh");
+	int missing = reader.addPath("objects/light");
+	elementPath = reader.addElementPath("objects/object");
+
+	objectIds.clear();
+	numObjectErrors = 0;
+	ofAddListener(reader.elementRead,this,&ofApp::objectRead);
+	check(reader.loadFromBuffer(makeScene(5)),"read the scene");
+	ofRemoveListener(reader.elementRead,this,&ofApp::objectRead);
+
+	check(reader.getValue(far)=="1000","element value");
+	check(reader.getValue(fov)=="60","attribute value");
+	check(reader.getNumValues(positions)==5,"all the matches are collected");
+	bool bInOrder = reader.getNumValues(positions)==5;
+	for(int i=0;i<reader.getNumValues(positions) && bInOrder;i++){
+		bInOrder = reader.getValues(positions)[i]==ofToString(i);
+	}
+	check(bInOrder,"the matches are in document order");
+	check(reader.getNumValues(meshes)==5,"recursive path");
+	check(reader.getNumValues(third)==1 && reader.getValue(third)=="2","index");
+	check(reader.getNumValues(filtered)==1 && reader.getValue(filtered)=="m3","filter by attribute value");
+	check(reader.getNumValues(missing)==0 && reader.getValue(missing)=="","missing element");
+	check(objectIds.size()==5 && objectIds[4]=="o4" && numObjectErrors==0,"element paths notify every element");
+
+	check(!reader.loadFromBuffer("<scene><camera></scene>"),"malformed xml fails");
+}
+
+//--------------------------------------------------------------
+void ofApp::testStop(){
+	reader.clearPaths();
+	int positions = reader.addPath("objects/object/pos");
+	reader.addElementPath("objects/object");
+
+	objectIds.clear();
+	ofAddListener(reader.elementRead,this,&ofApp::stopReading);
+	reader.loadFromBuffer(makeScene(5));
+	ofRemoveListener(reader.elementRead,this,&ofApp::stopReading);
+
+	check(objectIds.size()==2,"stop() from a listener ends the read");
+	check(reader.getNumValues(positions)==2,"values after the stop aren't collected");
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(int numObjects){
+	string scene = makeScene(numObjects);
+	ofLogNotice("xmlPathTester") << numObjects << " objects, " << scene.size()/1024 << "KB";
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	ofXml xml;
+	xml.loadFromBuffer(scene);
+	ofLogNotice("xmlPathTester") << "load the document: " << (ofGetElapsedTimeMicros()-start)/1000. << "ms";
+
+	start = ofGetElapsedTimeMicros();
+	reader.clearPaths();
+	int positions = reader.addPath("objects/object/pos");
+	reader.loadFromBuffer(scene);
+	ofLogNotice("xmlPathTester") << "read every position with ofXmlReader: " << (ofGetElapsedTimeMicros()-start)/1000. << "ms";
+	check(reader.getNumValues(positions)==numObjects,"the reader finds every object");
+
+	int numLookups = 100000;
+	float sumString = 0, sumCompiled = 0;
+	start = ofGetElapsedTimeMicros();
+	for(int i=0;i<numLookups;i++){
+		sumString += xml.getFloatValue("camera/far");
+	}
+	unsigned long long elapsedString = ofGetElapsedTimeMicros()-start;
+
+	ofXmlPath far("camera/far");
+	start = ofGetElapsedTimeMicros();
+	for(int i=0;i<numLookups;i++){
+		sumCompiled += xml.getFloatValue(far);
+	}
+	unsigned long long elapsedCompiled = ofGetElapsedTimeMicros()-start;
+
+	ofLogNotice("xmlPathTester") << numLookups << " lookups of camera/far, string path: " << elapsedString/1000. << "ms, compiled path: " << elapsedCompiled/1000. << "ms";
+	check(sumString==sumCompiled,"the same values with string and compiled paths");
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "ofMain.h"
+
+// checks that ofXmlPath finds the same nodes as the string paths of ofXml
+// and that ofXmlReader collects the same values without building the
+// document, then times both against the string paths and the full load
+// with a generated scene
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		string makeScene(int numObjects);
+
+		void testPaths();
+		void testSetters();
+		void testReader();
+		void testStop();
+		void benchmark(int numObjects);
+
+		void objectRead(ofXmlReaderEventArgs & args);
+		void stopReading(ofXmlReaderEventArgs & args);
+		void check(bool bOk, string test);
+
+		ofXmlReader reader;
+		int elementPath;
+		vector<string> objectIds;
+		int numObjectErrors;
+		int numFailed;
+};
@@ -0,0 +1,184 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	numFailed = 0;
+
+	indexed.enableTagIndex();
+	check(indexed.getUsingTagIndex() && !plain.getUsingTagIndex(),"the index is disabled by default");
+
+	testReads();
+	testWrites();
+	testGetValues();
+	benchmark(5000);
+
+	ofLogNotice("xmlSettingsIndexTester") << (numFailed ? "FAILED" : "passed");
+	ofExit(numFailed ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+string ofApp::makePoints(int numPoints){
+	string xml = "<points>";
+	for(int i=0;i<numPoints;i++){
+		xml += "<point id=\"p" + ofToString(i) + "\">" + ofToString(i) + "</point>";
+		// other tags in between so the indices of each name differ
+		if(i%3==0) xml += "<label>l" + ofToString(i) + "</label>";
+	}
+	xml += "</points>";
+	return xml;
+}
+
+//--------------------------------------------------------------
+void ofApp::check(bool bOk, string test){
+	if(!bOk){
+		ofLogError("xmlSettingsIndexTester") << test;
+		numFailed++;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofApp::equal(ofxXmlSettings & a, ofxXmlSettings & b){
+	if(a.getNumTags("points")!=b.getNumTags("points")) return false;
+	if(!a.pushTag("points") || !b.pushTag("points")) return false;
+	bool bEqual = true;
+	const char * tags[] = {"point","label"};
+	for(int t=0;t<2 && bEqual;t++){
+		int numTags = a.getNumTags(tags[t]);
+		bEqual = numTags==b.getNumTags(tags[t]);
+		// one past the last one too, it doesn't exist in either
+		for(int i=0;i<=numTags && bEqual;i++){
+			bEqual = a.tagExists(tags[t],i)==b.tagExists(tags[t],i)
+					&& a.getValue(tags[t],"none",i)==b.getValue(tags[t],"none",i)
+					&& a.getAttribute(tags[t],"id","none",i)==b.getAttribute(tags[t],"id","none",i)
+					&& a.getNumAttributes(tags[t],i)==b.getNumAttributes(tags[t],i);
+		}
+	}
+	a.popTag();
+	b.popTag();
+	return bEqual;
+}
+
+//--------------------------------------------------------------
+void ofApp::testReads(){
+	plain.loadFromBuffer(makePoints(10));
+	indexed.loadFromBuffer(makePoints(10));
+	check(equal(plain,indexed),"after loading");
+
+	indexed.pushTag("points");
+	check(indexed.getValue("point",-1,7)==7,"read by index");
+	check(indexed.getValue("label","",2)=="l6","read a tag with another name");
+	check(indexed.getAttribute("point","id","",9)=="p9","read an attribute");
+	check(!indexed.tagExists("point",10),"past the last tag");
+	check(indexed.pushTag("point",4) && indexed.getPushLevel()==2,"push a tag");
+	indexed.popTag();
+	indexed.popTag();
+}
+
+//--------------------------------------------------------------
+void ofApp::testWrites(){
+	ofxXmlSettings * both[] = {&plain,&indexed};
+	for(int i=0;i<2;i++){
+		both[i]->loadFromBuffer(makePoints(10));
+		both[i]->pushTag("points");
+		// read everything first so the index is built before the writes
+		both[i]->getValue("point",0,9);
+		both[i]->getValue("label",0,3);
+		both[i]->addValue("point",10);
+		both[i]->setValue("point",20,2);
+		both[i]->setAttribute("point","id","changed",5);
+		both[i]->addAttribute("point","extra",1,6);
+		both[i]->popTag();
+	}
+	check(equal(plain,indexed),"after adding and changing tags");
+	indexed.pushTag("points");
+	check(indexed.getValue("point",-1,10)==10 && indexed.getNumTags("point")==11,"an added tag is indexed");
+	indexed.popTag();
+
+	for(int i=0;i<2;i++){
+		both[i]->pushTag("points");
+		both[i]->removeTag("point",3);
+		both[i]->removeTag("label",0);
+		both[i]->clearTagContents("point",1);
+		both[i]->popTag();
+	}
+	check(equal(plain,indexed),"after removing tags");
+	indexed.pushTag("points");
+	check(indexed.getValue("point",-1,3)==4,"the tags after a removed one move back");
+	indexed.popTag();
+
+	for(int i=0;i<2;i++){
+		both[i]->pushTag("points");
+		both[i]->clear();
+		both[i]->addValue("point",100);
+		both[i]->addTag("label");
+		both[i]->popTag();
+	}
+	check(equal(plain,indexed),"after clearing a level");
+
+	plain.loadFromBuffer(makePoints(4));
+	indexed.loadFromBuffer(makePoints(4));
+	check(equal(plain,indexed),"after loading another document");
+
+	indexed.disableTagIndex();
+	indexed.pushTag("points");
+	indexed.addValue("point",4);
+	indexed.popTag();
+	indexed.enableTagIndex();
+	plain.pushTag("points");
+	plain.addValue("point",4);
+	plain.popTag();
+	check(equal(plain,indexed),"enabling the index again rebuilds it");
+}
+
+//--------------------------------------------------------------
+void ofApp::testGetValues(){
+	ofxXmlSettings * both[] = {&plain,&indexed};
+	for(int i=0;i<2;i++){
+		both[i]->loadFromBuffer(makePoints(10));
+		both[i]->pushTag("points");
+		both[i]->addTag("point");
+		vector<int> values;
+		vector<string> labels;
+		check(both[i]->getValues("point",values,-1)==11 && values.size()==11,"getValues returns every tag");
+		bool bSame = true;
+		for(int j=0;j<(int)values.size();j++){
+			bSame &= values[j]==both[i]->getValue("point",-1,j);
+		}
+		check(bSame,"getValues reads the same values as getValue");
+		vector<int> missing;
+		both[i]->getValues("point:x",missing,-1);
+		check(missing.size()==11 && missing[0]==-1,"tags without a value get the default value");
+		check(both[i]->getValues("label",labels)==4 && labels[3]=="l9","getValues with strings");
+		both[i]->popTag();
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmark(int numPoints){
+	string points = makePoints(numPoints);
+	ofxXmlSettings * both[] = {&plain,&indexed};
+	const char * names[] = {"getValue by index", "getValue by index with the tag index"};
+	long sums[3] = {0,0,0};
+	for(int i=0;i<2;i++){
+		both[i]->loadFromBuffer(points);
+		both[i]->pushTag("points");
+		unsigned long long start = ofGetElapsedTimeMicros();
+		for(int j=0;j<numPoints;j++){
+			sums[i] += both[i]->getValue("point",0,j);
+		}
+		ofLogNotice("xmlSettingsIndexTester") << numPoints << " points, " << names[i] << ": " << (ofGetElapsedTimeMicros()-start)/1000. << "ms";
+		both[i]->popTag();
+	}
+
+	plain.pushTag("points");
+	unsigned long long start = ofGetElapsedTimeMicros();
+	vector<int> values;
+	plain.getValues("point",values);
+	for(int j=0;j<(int)values.size();j++){
+		sums[2] += values[j];
+	}
+	ofLogNotice("xmlSettingsIndexTester") << numPoints << " points, getValues: " << (ofGetElapsedTimeMicros()-start)/1000. << "ms";
+	plain.popTag();
+
+	check(sums[0]==sums[1] && sums[0]==sums[2],"the same values with every method");
+}
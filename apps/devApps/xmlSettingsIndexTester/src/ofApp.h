@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxXmlSettings.h"
+
+// applies the same reads and writes to two ofxXmlSettings, one with the
+// tag index enabled, and checks that they always read the same values,
+// then times reading thousands of repeated tags by index with and without
+// the tag index and with getValues
+
+class ofApp : public ofBaseApp{
+
+	public:
+		void setup();
+
+		string makePoints(int numPoints);
+
+		void testReads();
+		void testWrites();
+		void testGetValues();
+		void benchmark(int numPoints);
+
+		bool equal(ofxXmlSettings & a, ofxXmlSettings & b);
+		void check(bool bOk, string test);
+
+		ofxXmlSettings plain, indexed;
+		int numFailed;
+};
@@ -53,6 +53,11 @@ ofMesh& of3dPrimitive::getMesh() {
     return *mesh;
 }
 
+//----------------------------------------------------------
+ofBoundingBox of3dPrimitive::getLocalBoundingBox() const {
+    return mesh->getBoundingBox();
+}
+
 //----------------------------------------------------------
 ofVec4f* of3dPrimitive::getTexCoordsPtr() {
     return& texCoords;
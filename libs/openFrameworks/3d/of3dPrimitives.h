@@ -43,6 +43,8 @@ public:
     ofMesh* getMeshPtr();
     ofMesh& getMesh();
     
+    ofBoundingBox getLocalBoundingBox() const;
+    
     ofVec4f* getTexCoordsPtr();
     ofVec4f& getTexCoords();
     
@@ -0,0 +1,110 @@
+#include "ofBoundingBox.h"
+
+//----------------------------------------
+ofBoundingBox::ofBoundingBox()
+:bEmpty(true){
+}
+
+//----------------------------------------
+ofBoundingBox::ofBoundingBox(const ofVec3f & min, const ofVec3f & max)
+:bEmpty(true){
+	add(min);
+	add(max);
+}
+
+//----------------------------------------
+void ofBoundingBox::clear(){
+	min.set(0,0,0);
+	max.set(0,0,0);
+	bEmpty = true;
+}
+
+//----------------------------------------
+bool ofBoundingBox::isEmpty() const{
+	return bEmpty;
+}
+
+//----------------------------------------
+void ofBoundingBox::add(const ofVec3f & p){
+	if(bEmpty){
+		min = p;
+		max = p;
+		bEmpty = false;
+		return;
+	}
+	if(p.x<min.x) min.x = p.x;
+	if(p.y<min.y) min.y = p.y;
+	if(p.z<min.z) min.z = p.z;
+	if(p.x>max.x) max.x = p.x;
+	if(p.y>max.y) max.y = p.y;
+	if(p.z>max.z) max.z = p.z;
+}
+
+//----------------------------------------
+void ofBoundingBox::add(const ofBoundingBox & box){
+	if(box.bEmpty) return;
+	add(box.min);
+	add(box.max);
+}
+
+//----------------------------------------
+void ofBoundingBox::add(const vector<ofVec3f> & points){
+	for(int i=0;i<(int)points.size();i++){
+		add(points[i]);
+	}
+}
+
+//----------------------------------------
+const ofVec3f & ofBoundingBox::getMin() const{
+	return min;
+}
+
+//----------------------------------------
+const ofVec3f & ofBoundingBox::getMax() const{
+	return max;
+}
+
+//----------------------------------------
+ofVec3f ofBoundingBox::getCenter() const{
+	return (min + max) * 0.5;
+}
+
+//----------------------------------------
+ofVec3f ofBoundingBox::getSize() const{
+	return max - min;
+}
+
+//----------------------------------------
+float ofBoundingBox::getRadius() const{
+	return getSize().length() * 0.5;
+}
+
+//----------------------------------------
+bool ofBoundingBox::inside(const ofVec3f & p) const{
+	return !bEmpty &&
+			p.x>=min.x && p.y>=min.y && p.z>=min.z &&
+			p.x<=max.x && p.y<=max.y && p.z<=max.z;
+}
+
+//----------------------------------------
+bool ofBoundingBox::intersects(const ofBoundingBox & box) const{
+	return !bEmpty && !box.bEmpty &&
+			min.x<=box.max.x && max.x>=box.min.x &&
+			min.y<=box.max.y && max.y>=box.min.y &&
+			min.z<=box.max.z && max.z>=box.min.z;
+}
+
+//----------------------------------------
+ofBoundingBox ofBoundingBox::getTransformed(const ofMatrix4x4 & m) const{
+	if(bEmpty) return ofBoundingBox();
+
+	// transform the center and project the half size on every axis
+	// instead of transforming the 8 corners
+	ofVec3f center = getCenter() * m;
+	ofVec3f extent = getSize() * 0.5;
+	ofVec3f newExtent;
+	for(int j=0;j<3;j++){
+		newExtent[j] = fabs(m(0,j)) * extent.x + fabs(m(1,j)) * extent.y + fabs(m(2,j)) * extent.z;
+	}
+	return ofBoundingBox(center - newExtent, center + newExtent);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ofVectorMath.h"
+
+// axis aligned box used as bounding volume for meshes and nodes.
+// a default constructed box is empty and adding points or other
+// boxes to it grows it to contain them.
+
+class ofBoundingBox {
+public:
+	ofBoundingBox();
+	ofBoundingBox(const ofVec3f & min, const ofVec3f & max);
+
+	void clear();
+	bool isEmpty() const;
+
+	void add(const ofVec3f & p);
+	void add(const ofBoundingBox & box);
+	void add(const vector<ofVec3f> & points);
+
+	const ofVec3f & getMin() const;
+	const ofVec3f & getMax() const;
+	ofVec3f getCenter() const;
+	ofVec3f getSize() const;
+
+	// radius of the bounding sphere centered at getCenter()
+	float getRadius() const;
+
+	bool inside(const ofVec3f & p) const;
+	bool intersects(const ofBoundingBox & box) const;
+
+	// box containing this one after transforming it by m
+	ofBoundingBox getTransformed(const ofMatrix4x4 & m) const;
+
+private:
+	ofVec3f min;
+	ofVec3f max;
+	bool bEmpty;
+};
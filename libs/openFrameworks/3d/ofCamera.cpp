@@ -162,12 +162,17 @@ void ofCamera::end() {
 
 //----------------------------------------
 ofMatrix4x4 ofCamera::getProjectionMatrix(ofRectangle viewport) const {
+	return getProjectionMatrix(viewport, nearClip, farClip);
+}
+
+//----------------------------------------
+ofMatrix4x4 ofCamera::getProjectionMatrix(ofRectangle viewport, float nearDist, float farDist) const {
 	if(isOrtho) {
-		return ofMatrix4x4::newOrthoMatrix(0, viewport.width, 0, viewport.height, nearClip, farClip);
+		return ofMatrix4x4::newOrthoMatrix(0, viewport.width, 0, viewport.height, nearDist, farDist);
 	}else{
 		float aspect = forceAspectRatio ? aspectRatio : viewport.width/viewport.height;
 		ofMatrix4x4 matProjection;
-		matProjection.makePerspectiveMatrix(fov, aspect, nearClip, farClip);
+		matProjection.makePerspectiveMatrix(fov, aspect, nearDist, farDist);
 		matProjection.translate(-lensOffset.x, -lensOffset.y, 0);
 		return matProjection;
 	}
@@ -233,9 +238,106 @@ ofVec3f ofCamera::cameraToWorld(ofVec3f CameraXYZ, ofRectangle viewport) const {
 //----------------------------------------
 void ofCamera::calcClipPlanes(ofRectangle viewport) {
 	// autocalculate near/far clip planes if not set by user
-	if(nearClip == 0 || farClip == 0) {
+	getClipPlanes(viewport, nearClip, farClip);
+}
+
+//----------------------------------------
+void ofCamera::getClipPlanes(ofRectangle viewport, float & nearDist, float & farDist) const {
+	nearDist = nearClip;
+	farDist = farClip;
+	if(nearDist == 0 || farDist == 0) {
 		float dist = getImagePlaneDistance(viewport);
-		nearClip = (nearClip == 0) ? dist / 100.0f : nearClip;
-		farClip = (farClip == 0) ? dist * 10.0f : farClip;
+		nearDist = (nearDist == 0) ? dist / 100.0f : nearDist;
+		farDist = (farDist == 0) ? dist * 10.0f : farDist;
+	}
+}
+
+//----------------------------------------
+void ofCamera::calcFrustumPlanes(ofVec4f planes[6], ofRectangle viewport) const {
+	// the clip planes are only calculated on begin() if not set, so use
+	// the same ones here even if the camera hasn't been used yet
+	float nearDist, farDist;
+	getClipPlanes(viewport, nearDist, farDist);
+	ofMatrix4x4 m = getModelViewMatrix() * getProjectionMatrix(viewport, nearDist, farDist);
+
+	// a point is inside when -w <= x,y,z <= w in clip space, each of
+	// those conditions is a plane in world space
+	for(int i=0; i<3; i++) {
+		planes[i*2].set(m(0,3) + m(0,i), m(1,3) + m(1,i), m(2,3) + m(2,i), m(3,3) + m(3,i));
+		planes[i*2+1].set(m(0,3) - m(0,i), m(1,3) - m(1,i), m(2,3) - m(2,i), m(3,3) - m(3,i));
+	}
+}
+
+//----------------------------------------
+static bool isInsideFrustum(const ofVec4f planes[6], const ofBoundingBox & box) {
+	const ofVec3f & min = box.getMin();
+	const ofVec3f & max = box.getMax();
+	for(int i=0; i<6; i++) {
+		// test the corner furthest along the plane normal
+		const ofVec4f & p = planes[i];
+		float d = p.x * (p.x > 0 ? max.x : min.x) +
+				  p.y * (p.y > 0 ? max.y : min.y) +
+				  p.z * (p.z > 0 ? max.z : min.z) + p.w;
+		if(d < 0) return false;
+	}
+	return true;
+}
+
+//----------------------------------------
+static ofBoundingBox getCullingBox(const ofNode & node) {
+	ofBoundingBox box = node.getGlobalBoundingBox();
+	if(box.isEmpty()) {
+		ofVec3f position = node.getGlobalPosition();
+		box = ofBoundingBox(position, position);
+	}
+	return box;
+}
+
+//----------------------------------------
+bool ofCamera::isVisible(const ofBoundingBox & box, ofRectangle viewport) const {
+	if(box.isEmpty()) return false;
+	ofVec4f planes[6];
+	calcFrustumPlanes(planes, viewport);
+	return isInsideFrustum(planes, box);
+}
+
+//----------------------------------------
+bool ofCamera::isVisible(const ofNode & node, ofRectangle viewport) const {
+	return isVisible(getCullingBox(node), viewport);
+}
+
+//----------------------------------------
+vector<ofNode*> ofCamera::getVisibleNodes(const vector<ofNode*> & nodes, ofRectangle viewport) const {
+	ofVec4f planes[6];
+	calcFrustumPlanes(planes, viewport);
+	vector<ofNode*> visible;
+	for(int i=0; i<(int)nodes.size(); i++) {
+		if(isInsideFrustum(planes, getCullingBox(*nodes[i]))) {
+			visible.push_back(nodes[i]);
+		}
+	}
+	return visible;
+}
+
+//----------------------------------------
+vector<ofNode*> ofCamera::getVisibleNodes(ofNodeGraph & graph, ofRectangle viewport) const {
+	graph.updateBoundingBoxes();
+	ofVec4f planes[6];
+	calcFrustumPlanes(planes, viewport);
+
+	// parents are always before their children in the graph so when a
+	// node is reached we already know if its parent hierarchy was culled.
+	// nodes added or removed since the boxes were updated are skipped
+	const int numNodes = graph.hierarchyBoxes.size();
+	vector<char> culled(numNodes, 0);
+	vector<ofNode*> visible;
+	for(int i=0; i<numNodes; i++) {
+		const int parent = graph.parents[i];
+		if((parent != -1 && culled[parent]) || !isInsideFrustum(planes, graph.hierarchyBoxes[i])) {
+			culled[i] = 1;
+		}else if(graph.nodes[i] && isInsideFrustum(planes, graph.globalBoxes[i])) {
+			visible.push_back(graph.nodes[i]);
+		}
 	}
+	return visible;
 }
@@ -17,6 +17,7 @@
 #include "ofRectangle.h"
 #include "ofAppRunner.h"
 #include "ofNode.h"
+#include "ofNodeGraph.h"
 
 // Use the public API of ofNode for all transformations
 //class ofCamera : public ofNodeWithTarget {
@@ -66,9 +67,22 @@ public:
 	ofVec3f worldToCamera(ofVec3f WorldXYZ, ofRectangle viewport = ofGetCurrentViewport()) const;
 	ofVec3f cameraToWorld(ofVec3f CameraXYZ, ofRectangle viewport = ofGetCurrentViewport()) const;
 	
+	// frustum culling, boxes are in world coordinates. nodes are tested
+	// with their global bounding box or their position if they have none
+	bool isVisible(const ofBoundingBox & box, ofRectangle viewport = ofGetCurrentViewport()) const;
+	bool isVisible(const ofNode & node, ofRectangle viewport = ofGetCurrentViewport()) const;
+	vector<ofNode*> getVisibleNodes(const vector<ofNode*> & nodes, ofRectangle viewport = ofGetCurrentViewport()) const;
+	
+	// updates the bounding boxes of the graph and skips the children
+	// of any node whose hierarchy is completely outside of the frustum
+	vector<ofNode*> getVisibleNodes(ofNodeGraph & graph, ofRectangle viewport = ofGetCurrentViewport()) const;
+	
 	
 protected:
 	void calcClipPlanes(ofRectangle viewport);
+	void getClipPlanes(ofRectangle viewport, float & nearDist, float & farDist) const;
+	ofMatrix4x4 getProjectionMatrix(ofRectangle viewport, float nearDist, float farDist) const;
+	void calcFrustumPlanes(ofVec4f planes[6], ofRectangle viewport) const;
 	
 	bool isOrtho;
 	float fov;
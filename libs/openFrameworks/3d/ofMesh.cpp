@@ -2,6 +2,99 @@
 #include "ofGraphics.h"
 #include <map>
 
+// past this many separate ranges the tracking costs more than it saves,
+// so they get collapsed into one range covering all of them
+static const int OF_MESH_MAX_DIRTY_RANGES = 16;
+
+//--------------------------------------------------------------
+ofMeshDirtyRanges::ofMeshDirtyRanges(){
+	bAll = false;
+}
+
+//--------------------------------------------------------------
+void ofMeshDirtyRanges::add(int first, int count){
+	if(bAll || count<=0) return;
+	int end = first + count;
+
+	// most common case: consecutive calls to setVertex/addVertex...
+	if(!ranges.empty() && ranges.back().first<=first && ranges.back().second>=first){
+		ranges.back().second = max(ranges.back().second,end);
+		return;
+	}
+
+	// ranges are kept sorted and non overlapping, merge every range
+	// that touches the new one
+	unsigned int i = 0;
+	while(i<ranges.size() && ranges[i].second<first){
+		i++;
+	}
+	unsigned int j = i;
+	while(j<ranges.size() && ranges[j].first<=end){
+		first = min(first,ranges[j].first);
+		end = max(end,ranges[j].second);
+		j++;
+	}
+	ranges.erase(ranges.begin()+i,ranges.begin()+j);
+	ranges.insert(ranges.begin()+i,make_pair(first,end));
+
+	if((int)ranges.size()>OF_MESH_MAX_DIRTY_RANGES){
+		ranges.front().second = ranges.back().second;
+		ranges.resize(1);
+	}
+}
+
+//--------------------------------------------------------------
+void ofMeshDirtyRanges::addAll(){
+	bAll = true;
+	ranges.clear();
+}
+
+//--------------------------------------------------------------
+void ofMeshDirtyRanges::clear(){
+	bAll = false;
+	ranges.clear();
+}
+
+//--------------------------------------------------------------
+bool ofMeshDirtyRanges::isAll() const{
+	return bAll;
+}
+
+//--------------------------------------------------------------
+bool ofMeshDirtyRanges::empty() const{
+	return !bAll && ranges.empty();
+}
+
+//--------------------------------------------------------------
+int ofMeshDirtyRanges::getNumRanges() const{
+	return ranges.size();
+}
+
+//--------------------------------------------------------------
+int ofMeshDirtyRanges::getFirst(int range) const{
+	return ranges[range].first;
+}
+
+//--------------------------------------------------------------
+int ofMeshDirtyRanges::getCount(int range) const{
+	return ranges[range].second - ranges[range].first;
+}
+
+//--------------------------------------------------------------
+int ofMeshDirtyRanges::getTotalCount() const{
+	int total = 0;
+	for(unsigned int i=0;i<ranges.size();i++){
+		total += ranges[i].second - ranges[i].first;
+	}
+	return total;
+}
+
+//--------------------------------------------------------------
+void ofMeshDirtyRanges::swap(ofMeshDirtyRanges & other){
+	ranges.swap(other.ranges);
+	std::swap(bAll,other.bAll);
+}
+
 //--------------------------------------------------------------
 ofMesh::ofMesh(){
 	mode = OF_PRIMITIVE_TRIANGLES;
@@ -11,6 +104,7 @@ ofMesh::ofMesh(){
 	bTexCoordsChanged = false;
 	bIndicesChanged = false;
 	bFacesDirty = false;
+	bBoundingBoxDirty = false;
     useColors = true;
     useTextures = true;
     useNormals = true;
@@ -20,6 +114,17 @@ ofMesh::ofMesh(){
 
 //--------------------------------------------------------------
 ofMesh::ofMesh(ofPrimitiveMode mode, const vector<ofVec3f>& verts){
+	bVertsChanged = false;
+	bColorsChanged = false;
+	bNormalsChanged = false;
+	bTexCoordsChanged = false;
+	bIndicesChanged = false;
+	bFacesDirty = false;
+	bBoundingBoxDirty = false;
+	useColors = true;
+	useTextures = true;
+	useNormals = true;
+	useIndices = true;
 	setMode(mode);
 	addVertices(verts);
 }
@@ -32,22 +137,28 @@ ofMesh::~ofMesh(){
 void ofMesh::clear(){
 	if(!vertices.empty()){
 		bVertsChanged = true;
+		vertsDirty.addAll();
+		bBoundingBoxDirty = true;
 		vertices.clear();
 	}
 	if(!colors.empty()){
 		bColorsChanged = true;
+		colorsDirty.addAll();
 		colors.clear();
 	}
 	if(!normals.empty()){
 		bNormalsChanged = true;
+		normalsDirty.addAll();
 		normals.clear();
 	}
 	if(!texCoords.empty()){
 		bTexCoordsChanged = true;
+		texCoordsDirty.addAll();
 		texCoords.clear();
 	}
 	if(!indices.empty()){
 		bIndicesChanged = true;
+		indicesDirty.addAll();
 		indices.clear();
 	}
 	bFacesDirty = true;
@@ -57,6 +168,19 @@ void ofMesh::clear(){
 bool ofMesh::haveVertsChanged(){
 	if(bVertsChanged){
 		bVertsChanged = false;
+		vertsDirty.clear();
+		return true;
+	}else{
+		return false;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofMesh::haveVertsChanged(ofMeshDirtyRanges & changed){
+	changed.clear();
+	if(bVertsChanged){
+		bVertsChanged = false;
+		changed.swap(vertsDirty);
 		return true;
 	}else{
 		return false;
@@ -67,6 +191,19 @@ bool ofMesh::haveVertsChanged(){
 bool ofMesh::haveColorsChanged(){
 	if(bColorsChanged){
 		bColorsChanged = false;
+		colorsDirty.clear();
+		return true;
+	}else{
+		return false;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofMesh::haveColorsChanged(ofMeshDirtyRanges & changed){
+	changed.clear();
+	if(bColorsChanged){
+		bColorsChanged = false;
+		changed.swap(colorsDirty);
 		return true;
 	}else{
 		return false;
@@ -77,6 +214,19 @@ bool ofMesh::haveColorsChanged(){
 bool ofMesh::haveNormalsChanged(){
 	if(bNormalsChanged){
 		bNormalsChanged = false;
+		normalsDirty.clear();
+		return true;
+	}else{
+		return false;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofMesh::haveNormalsChanged(ofMeshDirtyRanges & changed){
+	changed.clear();
+	if(bNormalsChanged){
+		bNormalsChanged = false;
+		changed.swap(normalsDirty);
 		return true;
 	}else{
 		return false;
@@ -87,6 +237,19 @@ bool ofMesh::haveNormalsChanged(){
 bool ofMesh::haveTexCoordsChanged(){
 	if(bTexCoordsChanged){
 		bTexCoordsChanged = false;
+		texCoordsDirty.clear();
+		return true;
+	}else{
+		return false;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofMesh::haveTexCoordsChanged(ofMeshDirtyRanges & changed){
+	changed.clear();
+	if(bTexCoordsChanged){
+		bTexCoordsChanged = false;
+		changed.swap(texCoordsDirty);
 		return true;
 	}else{
 		return false;
@@ -97,6 +260,19 @@ bool ofMesh::haveTexCoordsChanged(){
 bool ofMesh::haveIndicesChanged(){
 	if(bIndicesChanged){
 		bIndicesChanged = false;
+		indicesDirty.clear();
+		return true;
+	}else{
+		return false;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofMesh::haveIndicesChanged(ofMeshDirtyRanges & changed){
+	changed.clear();
+	if(bIndicesChanged){
+		bIndicesChanged = false;
+		changed.swap(indicesDirty);
 		return true;
 	}else{
 		return false;
@@ -135,6 +311,8 @@ bool ofMesh::hasIndices() const{
 void ofMesh::addVertex(const ofVec3f& v){
 	vertices.push_back(v);
 	bVertsChanged = true;
+	vertsDirty.add(vertices.size()-1,1);
+	bBoundingBoxDirty = true;
 	bFacesDirty = true;
 }
 
@@ -142,6 +320,8 @@ void ofMesh::addVertex(const ofVec3f& v){
 void ofMesh::addVertices(const vector<ofVec3f>& verts){
 	vertices.insert(vertices.end(),verts.begin(),verts.end());
 	bVertsChanged = true;
+	vertsDirty.add(vertices.size()-verts.size(),verts.size());
+	bBoundingBoxDirty = true;
 	bFacesDirty = true;
 }
 
@@ -149,6 +329,8 @@ void ofMesh::addVertices(const vector<ofVec3f>& verts){
 void ofMesh::addVertices(const ofVec3f* verts, int amt){
 	vertices.insert(vertices.end(),verts,verts+amt);
 	bVertsChanged = true;
+	vertsDirty.add(vertices.size()-amt,amt);
+	bBoundingBoxDirty = true;
 	bFacesDirty = true;
 }
 
@@ -156,6 +338,7 @@ void ofMesh::addVertices(const ofVec3f* verts, int amt){
 void ofMesh::addColor(const ofFloatColor& c){
 	colors.push_back(c);
 	bColorsChanged = true;
+	colorsDirty.add(colors.size()-1,1);
 	bFacesDirty = true;
 }
 
@@ -163,6 +346,7 @@ void ofMesh::addColor(const ofFloatColor& c){
 void ofMesh::addColors(const vector<ofFloatColor>& cols){
 	colors.insert(colors.end(),cols.begin(),cols.end());
 	bColorsChanged = true;
+	colorsDirty.add(colors.size()-cols.size(),cols.size());
 	bFacesDirty = true;
 }
 
@@ -170,6 +354,7 @@ void ofMesh::addColors(const vector<ofFloatColor>& cols){
 void ofMesh::addColors(const ofFloatColor* cols, int amt){
 	colors.insert(colors.end(),cols,cols+amt);
 	bColorsChanged = true;
+	colorsDirty.add(colors.size()-amt,amt);
 	bFacesDirty = true;
 }
 
@@ -177,6 +362,7 @@ void ofMesh::addColors(const ofFloatColor* cols, int amt){
 void ofMesh::addNormal(const ofVec3f& n){
 	normals.push_back(n);
 	bNormalsChanged = true;
+	normalsDirty.add(normals.size()-1,1);
 	bFacesDirty = true;
 }
 
@@ -184,6 +370,7 @@ void ofMesh::addNormal(const ofVec3f& n){
 void ofMesh::addNormals(const vector<ofVec3f>& norms){
 	normals.insert(normals.end(),norms.begin(),norms.end());
 	bNormalsChanged = true;
+	normalsDirty.add(normals.size()-norms.size(),norms.size());
 	bFacesDirty = true;
 }
 
@@ -191,6 +378,7 @@ void ofMesh::addNormals(const vector<ofVec3f>& norms){
 void ofMesh::addNormals(const ofVec3f* norms, int amt){
 	normals.insert(normals.end(),norms,norms+amt);
 	bNormalsChanged = true;
+	normalsDirty.add(normals.size()-amt,amt);
 	bFacesDirty = true;
 }
 
@@ -199,6 +387,7 @@ void ofMesh::addTexCoord(const ofVec2f& t){
 	//TODO: figure out if we add to all other arrays to match
 	texCoords.push_back(t);
 	bTexCoordsChanged = true;
+	texCoordsDirty.add(texCoords.size()-1,1);
 	bFacesDirty = true;
 }
 
@@ -206,6 +395,7 @@ void ofMesh::addTexCoord(const ofVec2f& t){
 void ofMesh::addTexCoords(const vector<ofVec2f>& tCoords){
 	texCoords.insert(texCoords.end(),tCoords.begin(),tCoords.end());
 	bTexCoordsChanged = true;
+	texCoordsDirty.add(texCoords.size()-tCoords.size(),tCoords.size());
 	bFacesDirty = true;
 }
 
@@ -213,6 +403,7 @@ void ofMesh::addTexCoords(const vector<ofVec2f>& tCoords){
 void ofMesh::addTexCoords(const ofVec2f* tCoords, int amt){
 	texCoords.insert(texCoords.end(),tCoords,tCoords+amt);
 	bTexCoordsChanged = true;
+	texCoordsDirty.add(texCoords.size()-amt,amt);
 	bFacesDirty = true;
 }
 
@@ -225,6 +416,7 @@ ofIndexType ofMesh::getIndex(ofIndexType i) const{
 void ofMesh::addIndex(ofIndexType i){
 	indices.push_back(i);
 	bIndicesChanged = true;
+	indicesDirty.add(indices.size()-1,1);
 	bFacesDirty = true;
 }
 
@@ -232,6 +424,7 @@ void ofMesh::addIndex(ofIndexType i){
 void ofMesh::addIndices(const vector<ofIndexType>& inds){
 	indices.insert(indices.end(),inds.begin(),inds.end());
 	bIndicesChanged = true;
+	indicesDirty.add(indices.size()-inds.size(),inds.size());
 	bFacesDirty = true;
 }
 
@@ -239,6 +432,7 @@ void ofMesh::addIndices(const vector<ofIndexType>& inds){
 void ofMesh::addIndices(const ofIndexType* inds, int amt){
 	indices.insert(indices.end(),inds,inds+amt);
 	bIndicesChanged = true;
+	indicesDirty.add(indices.size()-amt,amt);
 	bFacesDirty = true;
 }
 
@@ -257,6 +451,8 @@ void ofMesh::removeVertex(ofIndexType index){
   }else{
     vertices.erase(vertices.begin() + index);
     bVertsChanged = true;
+    vertsDirty.add(index,vertices.size()-index);
+    bBoundingBoxDirty = true;
 	bFacesDirty = true;
   }
 }
@@ -268,6 +464,7 @@ void ofMesh::removeNormal(ofIndexType index){
   }else{
     normals.erase(normals.begin() + index);
     bNormalsChanged = true;
+    normalsDirty.add(index,normals.size()-index);
 	bFacesDirty = true;
   }
 }
@@ -279,6 +476,7 @@ void ofMesh::removeColor(ofIndexType index){
   }else{
     colors.erase(colors.begin() + index);
     bColorsChanged = true;
+    colorsDirty.add(index,colors.size()-index);
 	bFacesDirty = true;
   }
 }
@@ -290,6 +488,7 @@ void ofMesh::removeTexCoord(ofIndexType index){
   }else{
     texCoords.erase(texCoords.begin() + index);
     bTexCoordsChanged = true;
+    texCoordsDirty.add(index,texCoords.size()-index);
 	bFacesDirty = true;
   }
 }
@@ -301,6 +500,7 @@ void ofMesh::removeIndex(ofIndexType index){
   }else{
     indices.erase(indices.begin() + index);
     bIndicesChanged = true;
+    indicesDirty.add(index,indices.size()-index);
 	bFacesDirty = true;
   }
 }
@@ -371,6 +571,8 @@ int ofPrimitive::getNumIndicesWire(){
 
 //--------------------------------------------------------------
 ofVec3f* ofMesh::getVerticesPointer(){
+	// the vertices can be modified through the pointer
+	bBoundingBoxDirty = true;
 #ifdef TARGET_OSX
 	return &vertices[0];
 #else
@@ -462,30 +664,36 @@ const ofIndexType * ofMesh::getIndexPointer() const{
 
 vector<ofVec3f> & ofMesh::getVertices(){
 	bVertsChanged = true;
+	vertsDirty.addAll();
+	bBoundingBoxDirty = true;
 	bFacesDirty = true;
 	return vertices;
 }
 
 vector<ofFloatColor> & ofMesh::getColors(){
 	bColorsChanged = true;
+	colorsDirty.addAll();
 	bFacesDirty = true;
 	return colors;
 }
 
 vector<ofVec3f> & ofMesh::getNormals(){
 	bNormalsChanged = true;
+	normalsDirty.addAll();
 	bFacesDirty = true;
 	return normals;
 }
 
 vector<ofVec2f> & ofMesh::getTexCoords(){
 	bTexCoordsChanged = true;
+	texCoordsDirty.addAll();
 	bFacesDirty = true;
 	return texCoords;
 }
 
 vector<ofIndexType> & ofMesh::getIndices(){
 	bIndicesChanged = true;
+	indicesDirty.addAll();
 	bFacesDirty = true;
 	return indices;
 }
@@ -569,6 +777,16 @@ ofVec3f ofMesh::getCentroid() const {
 	return sum;
 }
 
+//--------------------------------------------------------------
+const ofBoundingBox & ofMesh::getBoundingBox() const{
+	if(bBoundingBoxDirty){
+		boundingBox.clear();
+		boundingBox.add(vertices);
+		bBoundingBoxDirty = false;
+	}
+	return boundingBox;
+}
+
 //SETTERS
 //--------------------------------------------------------------
 void ofMesh::setMode(ofPrimitiveMode m){
@@ -580,7 +798,8 @@ void ofMesh::setMode(ofPrimitiveMode m){
 void ofMesh::setVertex(ofIndexType index, const ofVec3f& v){
 	vertices[index] = v;
 	bVertsChanged = true;
-	bIndicesChanged = true;
+	vertsDirty.add(index,1);
+	bBoundingBoxDirty = true;
 	bFacesDirty = true;
 }
 
@@ -588,6 +807,7 @@ void ofMesh::setVertex(ofIndexType index, const ofVec3f& v){
 void ofMesh::setNormal(ofIndexType index, const ofVec3f& n){
 	normals[index] = n;
 	bNormalsChanged = true;
+	normalsDirty.add(index,1);
 	bFacesDirty = true;
 }
 
@@ -595,6 +815,7 @@ void ofMesh::setNormal(ofIndexType index, const ofVec3f& n){
 void ofMesh::setColor(ofIndexType index, const ofFloatColor& c){
 	colors[index] = c;
 	bColorsChanged = true;
+	colorsDirty.add(index,1);
 	bFacesDirty = true;
 }
 
@@ -602,6 +823,7 @@ void ofMesh::setColor(ofIndexType index, const ofFloatColor& c){
 void ofMesh::setTexCoord(ofIndexType index, const ofVec2f& t){
 	texCoords[index] = t;
 	bTexCoordsChanged = true;
+	texCoordsDirty.add(index,1);
 	bFacesDirty = true;
 }
 
@@ -609,12 +831,14 @@ void ofMesh::setTexCoord(ofIndexType index, const ofVec2f& t){
 void ofMesh::setIndex(ofIndexType index, ofIndexType  val){
 	indices[index] = val;
 	bIndicesChanged = true;
+	indicesDirty.add(index,1);
 	bFacesDirty = true;
 }
 
 //--------------------------------------------------------------
 void ofMesh::setupIndicesAuto(){
 	bIndicesChanged = true;
+	indicesDirty.addAll();
 	bFacesDirty = true;
 	indices.resize(vertices.size());
 	for(int i = 0; i < (int)vertices.size();i++){
@@ -628,12 +852,15 @@ void ofMesh::setupIndicesAuto(){
 void ofMesh::clearVertices(){
 	vertices.clear();
 	bVertsChanged=true;
+	vertsDirty.addAll();
+	bBoundingBoxDirty = true;
 }
 
 //--------------------------------------------------------------
 void ofMesh::clearNormals(){
 	normals.clear();
 	bNormalsChanged=true;
+	normalsDirty.addAll();
 	bFacesDirty = true;
 }
 
@@ -641,6 +868,7 @@ void ofMesh::clearNormals(){
 void ofMesh::clearColors(){
 	colors.clear();
 	bColorsChanged=true;
+	colorsDirty.addAll();
 	bFacesDirty = true;
 }
 
@@ -648,6 +876,7 @@ void ofMesh::clearColors(){
 void ofMesh::clearTexCoords(){
 	texCoords.clear();
 	bTexCoordsChanged=true;
+	texCoordsDirty.addAll();
 	bFacesDirty = true;
 }
 
@@ -655,6 +884,7 @@ void ofMesh::clearTexCoords(){
 void ofMesh::clearIndices(){
 	indices.clear();
 	bIndicesChanged = true;
+	indicesDirty.addAll();
 	bFacesDirty = true;
 }
 
@@ -765,6 +995,28 @@ void ofMesh::append(ofMesh & mesh){
 			indices.push_back(mesh.getIndex(i)+prevNumVertices);
 		}
 	}
+	if(mesh.getNumVertices()){
+		bVertsChanged = true;
+		vertsDirty.add(prevNumVertices,mesh.getNumVertices());
+		bBoundingBoxDirty = true;
+	}
+	if(mesh.getNumTexCoords()){
+		bTexCoordsChanged = true;
+		texCoordsDirty.add(texCoords.size()-mesh.getNumTexCoords(),mesh.getNumTexCoords());
+	}
+	if(mesh.getNumColors()){
+		bColorsChanged = true;
+		colorsDirty.add(colors.size()-mesh.getNumColors(),mesh.getNumColors());
+	}
+	if(mesh.getNumNormals()){
+		bNormalsChanged = true;
+		normalsDirty.add(normals.size()-mesh.getNumNormals(),mesh.getNumNormals());
+	}
+	if(mesh.getNumIndices()){
+		bIndicesChanged = true;
+		indicesDirty.add(indices.size()-mesh.getNumIndices(),mesh.getNumIndices());
+	}
+	bFacesDirty = true;
 }
 
 
@@ -1388,10 +1640,16 @@ void ofMesh::setFromTriangles( const vector<ofMeshFace>& tris, bool bUseFaceNorm
     
     setupIndicesAuto();
     bVertsChanged = true;
+    vertsDirty.addAll();
+    bBoundingBoxDirty = true;
     bIndicesChanged = true;
+    indicesDirty.addAll();
     bNormalsChanged = true;
+    normalsDirty.addAll();
     bColorsChanged = true;
+    colorsDirty.addAll();
     bTexCoordsChanged = true;
+    texCoordsDirty.addAll();
 
     bFacesDirty = false;
     faces = tris;
@@ -10,9 +10,35 @@
 #include "ofUtils.h"
 #include "ofConstants.h"
 #include "ofGLUtils.h"
+#include "ofBoundingBox.h"
 
 class ofMeshFace;
 
+// ranges of elements of one of the mesh arrays that changed since it was
+// last uploaded, used by ofVboMesh to update only those parts of the vbo
+class ofMeshDirtyRanges{
+public:
+	ofMeshDirtyRanges();
+
+	void add(int first, int count);
+	void addAll();
+	void clear();
+
+	bool isAll() const;
+	bool empty() const;
+
+	int getNumRanges() const;
+	int getFirst(int range) const;
+	int getCount(int range) const;
+	int getTotalCount() const;
+
+	void swap(ofMeshDirtyRanges & other);
+
+private:
+	vector<pair<int,int> > ranges;
+	bool bAll;
+};
+
 class ofMesh{
 public:
 	
@@ -103,11 +129,22 @@ public:
 	
 	ofVec3f getCentroid() const;
 
+	// box containing all the vertices, cached until they change
+	const ofBoundingBox & getBoundingBox() const;
+
 	bool haveVertsChanged();
 	bool haveColorsChanged();
 	bool haveNormalsChanged();
 	bool haveTexCoordsChanged();
 	bool haveIndicesChanged();
+
+	// same as the above but also return which elements changed,
+	// if changed.isAll() is true the whole array needs to be updated
+	bool haveVertsChanged(ofMeshDirtyRanges & changed);
+	bool haveColorsChanged(ofMeshDirtyRanges & changed);
+	bool haveNormalsChanged(ofMeshDirtyRanges & changed);
+	bool haveTexCoordsChanged(ofMeshDirtyRanges & changed);
+	bool haveIndicesChanged(ofMeshDirtyRanges & changed);
 	
 	bool hasVertices() const;
 	bool hasColors() const;
@@ -173,8 +210,11 @@ private:
 	// mutable allows to change them from const methods
 	mutable vector<ofMeshFace> faces;
 	mutable bool bFacesDirty;
+	mutable ofBoundingBox boundingBox;
+	mutable bool bBoundingBoxDirty;
 
 	bool bVertsChanged, bColorsChanged, bNormalsChanged, bTexCoordsChanged, bIndicesChanged;
+	ofMeshDirtyRanges vertsDirty, colorsDirty, normalsDirty, texCoordsDirty, indicesDirty;
 	ofPrimitiveMode mode;
     
     bool useColors;
@@ -3,22 +3,64 @@
 #include "ofMath.h"
 #include "ofLog.h"
 #include "of3dGraphics.h"
+#include "ofNodeGraph.h"
 
 ofNode::ofNode() : 
-	parent(NULL) {
+	parent(NULL),
+	graph(NULL),
+	graphIndex(-1) {
 	setPosition(ofVec3f(0, 0, 0));
 	setOrientation(ofVec3f(0, 0, 0));
 	setScale(1);
 }
 
+//----------------------------------------
+// copies are not added to any graph, temporary copies would make the
+// graph sort itself again. nodes are only added with ofNodeGraph::add
+ofNode::ofNode(const ofNode & node) :
+	parent(node.parent),
+	graph(NULL),
+	graphIndex(-1),
+	position(node.position),
+	orientation(node.orientation),
+	scale(node.scale),
+	localTransformMatrix(node.localTransformMatrix) {
+	axis[0] = node.axis[0];
+	axis[1] = node.axis[1];
+	axis[2] = node.axis[2];
+}
+
+//----------------------------------------
+// a node keeps its own graph when assigned, never the other node's
+ofNode & ofNode::operator=(const ofNode & node) {
+	if(&node == this) return *this;
+	parent = node.parent;
+	position = node.position;
+	orientation = node.orientation;
+	scale = node.scale;
+	axis[0] = node.axis[0];
+	axis[1] = node.axis[1];
+	axis[2] = node.axis[2];
+	localTransformMatrix = node.localTransformMatrix;
+	if(graph) graph->topologyChanged();
+	return *this;
+}
+
+//----------------------------------------
+ofNode::~ofNode() {
+	if(graph) graph->remove(*this);
+}
+
 //----------------------------------------
 void ofNode::setParent(ofNode& parent, bool bMaintainGlobalTransform) {
     if(bMaintainGlobalTransform) {
         ofMatrix4x4 globalTransform(getGlobalTransformMatrix());
         this->parent = &parent;
+        if(graph) graph->topologyChanged();
         setTransformMatrix(globalTransform);
     } else {
         this->parent = &parent;
+        if(graph) graph->topologyChanged();
     }
 }
 
@@ -27,9 +69,11 @@ void ofNode::clearParent(bool bMaintainGlobalTransform) {
     if(bMaintainGlobalTransform) {
         ofMatrix4x4 globalTransform(getGlobalTransformMatrix());
         this->parent = NULL;
+        if(graph) graph->topologyChanged();
         setTransformMatrix(globalTransform);
     } else {
         this->parent = NULL;
+        if(graph) graph->topologyChanged();
     }
 }
 
@@ -44,6 +88,7 @@ void ofNode::setTransformMatrix(const ofMatrix4x4 &m44) {
 
 	ofQuaternion so;
 	localTransformMatrix.decompose(position, orientation, scale, so);
+	localTransformChanged();
 	
 	onPositionChanged();
 	onOrientationChanged();
@@ -59,6 +104,7 @@ void ofNode::setPosition(float px, float py, float pz) {
 void ofNode::setPosition(const ofVec3f& p) {
 	position = p;
 	localTransformMatrix.setTranslation(position);
+	localTransformChanged();
 	onPositionChanged();
 }
 
@@ -160,6 +206,7 @@ void ofNode::move(float x, float y, float z) {
 void ofNode::move(const ofVec3f& offset) {
 	position += offset;
 	localTransformMatrix.setTranslation(position);
+	localTransformChanged();
 	onPositionChanged();
 }
 
@@ -301,6 +348,7 @@ const ofMatrix4x4& ofNode::getLocalTransformMatrix() const {
 
 //----------------------------------------
 ofMatrix4x4 ofNode::getGlobalTransformMatrix() const {
+	if(graph && graph->isUpToDate() && graph->isCached(*this)) return graph->getGlobalTransformMatrix(*this);
 	if(parent) return getLocalTransformMatrix() * parent->getGlobalTransformMatrix();
 	else return getLocalTransformMatrix();
 }
@@ -321,6 +369,16 @@ ofVec3f ofNode::getGlobalScale() const {
 	else return getScale();
 }
 
+//----------------------------------------
+ofBoundingBox ofNode::getLocalBoundingBox() const {
+	return ofBoundingBox();
+}
+
+//----------------------------------------
+ofBoundingBox ofNode::getGlobalBoundingBox() const {
+	return getLocalBoundingBox().getTransformed(getGlobalTransformMatrix());
+}
+
 //----------------------------------------
 void ofNode::orbit(float longitude, float latitude, float radius, const ofVec3f& centerPoint) {
 	ofMatrix4x4 m;
@@ -378,10 +436,14 @@ void ofNode::createMatrix() {
 	localTransformMatrix.makeScaleMatrix(scale);
 	localTransformMatrix.rotate(orientation);
 	localTransformMatrix.setTranslation(position);
+	localTransformChanged();
 	
 	if(scale[0]>0) axis[0] = getLocalTransformMatrix().getRowAsVec3f(0)/scale[0];
 	if(scale[1]>0) axis[1] = getLocalTransformMatrix().getRowAsVec3f(1)/scale[1];
 	if(scale[2]>0) axis[2] = getLocalTransformMatrix().getRowAsVec3f(2)/scale[2];
 }
 
-
+//----------------------------------------
+void ofNode::localTransformChanged() {
+	if(graph) graph->nodeChanged(graphIndex);
+}
@@ -4,6 +4,9 @@
 #include "ofVectorMath.h"
 #include "of3dUtils.h"
 #include "ofGraphics.h"
+#include "ofBoundingBox.h"
+
+class ofNodeGraph;
 
 
 // a generic 3d object in space with transformation (position, rotation, scale)
@@ -16,13 +19,16 @@
 // All set* methods work in local space unless stated otherwise
 
 // TODO:
-// cache inverseMatrix, local and global
+// cache inverseMatrix and local
+// global is cached when the node is added to an ofNodeGraph
 
 
 class ofNode {
 public:
 	ofNode();
-	virtual ~ofNode() {}
+	ofNode(const ofNode & node);
+	ofNode & operator=(const ofNode & node);
+	virtual ~ofNode();
 
 	// set parent to link nodes
 	// transformations are inherited from parent node
@@ -58,14 +64,19 @@ public:
 
 	const ofMatrix4x4& getLocalTransformMatrix() const;
 	
-	// TODO: optimize and cache these
-	// (parent would need to know about its children so it can inform them 
-	// to update their global matrices if it itself transforms)
+	// the global matrix is returned from the graph cache if the node
+	// is in an ofNodeGraph that is up to date, otherwise it's computed
+	// walking up the parents
 	ofMatrix4x4 getGlobalTransformMatrix() const;
 	ofVec3f getGlobalPosition() const;
 	ofQuaternion getGlobalOrientation() const;
 	ofVec3f getGlobalScale() const;
 
+	// bounds of whatever the node draws in its own coordinates, empty
+	// by default. classes extending ofNode that draw geometry override it
+	virtual ofBoundingBox getLocalBoundingBox() const;
+	ofBoundingBox getGlobalBoundingBox() const;
+
 	
 	
 	// Set Transformations
@@ -157,6 +168,12 @@ protected:
 	virtual void onScaleChanged() {}
 
 private:
+	friend class ofNodeGraph;
+	void localTransformChanged();
+
+	ofNodeGraph * graph;
+	int graphIndex;
+
 	ofVec3f position;
 	ofQuaternion orientation;
 	ofVec3f scale;
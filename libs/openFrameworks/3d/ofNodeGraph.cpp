@@ -0,0 +1,239 @@
+#include "ofNodeGraph.h"
+#include "ofNode.h"
+
+//----------------------------------------
+ofNodeGraph::ofNodeGraph()
+:bChanged(false)
+,bTopologyChanged(false)
+,bExternalParents(false){
+}
+
+//----------------------------------------
+ofNodeGraph::~ofNodeGraph(){
+	clear();
+}
+
+//----------------------------------------
+void ofNodeGraph::add(ofNode & node){
+	if(node.graph == this) return;
+	if(node.graph) node.graph->remove(node);
+
+	node.graph = this;
+	node.graphIndex = nodes.size();
+	nodes.push_back(&node);
+	parents.push_back(-1);
+	globalMatrices.push_back(node.getLocalTransformMatrix());
+	dirty.push_back(1);
+	recomputed.push_back(0);
+	external.push_back(0);
+	topologyChanged();
+}
+
+//----------------------------------------
+void ofNodeGraph::remove(ofNode & node){
+	if(node.graph != this) return;
+
+	// the slot is compacted away the next time the graph is sorted
+	nodes[node.graphIndex] = NULL;
+	node.graph = NULL;
+	node.graphIndex = -1;
+	topologyChanged();
+}
+
+//----------------------------------------
+void ofNodeGraph::clear(){
+	for(int i=0;i<(int)nodes.size();i++){
+		if(nodes[i]){
+			nodes[i]->graph = NULL;
+			nodes[i]->graphIndex = -1;
+		}
+	}
+	nodes.clear();
+	parents.clear();
+	globalMatrices.clear();
+	dirty.clear();
+	recomputed.clear();
+	external.clear();
+	globalBoxes.clear();
+	hierarchyBoxes.clear();
+	bChanged = false;
+	bTopologyChanged = false;
+	bExternalParents = false;
+}
+
+//----------------------------------------
+int ofNodeGraph::size() const{
+	int numNodes = 0;
+	for(int i=0;i<(int)nodes.size();i++){
+		if(nodes[i]) numNodes++;
+	}
+	return numNodes;
+}
+
+//----------------------------------------
+void ofNodeGraph::update(){
+	if(bTopologyChanged){
+		sort();
+	}
+	if(!bChanged && !bExternalParents){
+		return;
+	}
+
+	// parents are always before their children so by the time a node
+	// is reached its parent global matrix is already up to date. the
+	// graph can't know when a parent outside of it changes so those
+	// nodes and their children are always recomputed
+	const int numNodes = nodes.size();
+	for(int i=0;i<numNodes;i++){
+		const int parent = parents[i];
+		if(dirty[i] || external[i] || (parent!=-1 && recomputed[parent])){
+			if(parent==-1 && external[i]){
+				globalMatrices[i] = nodes[i]->getLocalTransformMatrix() * nodes[i]->getParent()->getGlobalTransformMatrix();
+			}else if(parent==-1){
+				globalMatrices[i] = nodes[i]->getLocalTransformMatrix();
+			}else{
+				globalMatrices[i] = nodes[i]->getLocalTransformMatrix() * globalMatrices[parent];
+			}
+			recomputed[i] = 1;
+		}else{
+			recomputed[i] = 0;
+		}
+		dirty[i] = 0;
+	}
+	bChanged = false;
+}
+
+//----------------------------------------
+bool ofNodeGraph::isUpToDate() const{
+	return !bChanged && !bTopologyChanged;
+}
+
+//----------------------------------------
+const ofMatrix4x4 & ofNodeGraph::getGlobalTransformMatrix(const ofNode & node) const{
+	return globalMatrices[node.graphIndex];
+}
+
+//----------------------------------------
+bool ofNodeGraph::isCached(const ofNode & node) const{
+	return !external[node.graphIndex];
+}
+
+//----------------------------------------
+void ofNodeGraph::updateBoundingBoxes(){
+	update();
+
+	// children are always after their parents so walking the graph
+	// backwards every node is complete before it's added to its parent
+	const int numNodes = nodes.size();
+	globalBoxes.resize(numNodes);
+	hierarchyBoxes.resize(numNodes);
+	for(int i=0;i<numNodes;i++){
+		const ofBoundingBox & local = nodes[i]->getLocalBoundingBox();
+		if(local.isEmpty()){
+			ofVec3f position = globalMatrices[i].getTranslation();
+			globalBoxes[i] = ofBoundingBox(position,position);
+		}else{
+			globalBoxes[i] = local.getTransformed(globalMatrices[i]);
+		}
+		hierarchyBoxes[i] = globalBoxes[i];
+	}
+	for(int i=numNodes-1;i>=0;i--){
+		if(parents[i]!=-1){
+			hierarchyBoxes[parents[i]].add(hierarchyBoxes[i]);
+		}
+	}
+}
+
+//----------------------------------------
+const ofBoundingBox & ofNodeGraph::getGlobalBoundingBox(const ofNode & node) const{
+	return globalBoxes[node.graphIndex];
+}
+
+//----------------------------------------
+const ofBoundingBox & ofNodeGraph::getHierarchyBoundingBox(const ofNode & node) const{
+	return hierarchyBoxes[node.graphIndex];
+}
+
+//----------------------------------------
+void ofNodeGraph::nodeChanged(int index){
+	dirty[index] = 1;
+	bChanged = true;
+}
+
+//----------------------------------------
+void ofNodeGraph::topologyChanged(){
+	bTopologyChanged = true;
+	bChanged = true;
+}
+
+//----------------------------------------
+void ofNodeGraph::sort(){
+	// drop removed nodes, only the nodes added to this graph are sorted
+	vector<ofNode*> current;
+	current.swap(nodes);
+	for(int i=0;i<(int)current.size();i++){
+		if(current[i]){
+			current[i]->graphIndex = nodes.size();
+			nodes.push_back(current[i]);
+		}
+	}
+
+	// depth of every node in the hierarchy, walking up only until
+	// reaching a node whose depth is already known or a parent that
+	// is not in this graph
+	const int numNodes = nodes.size();
+	vector<int> depths(numNodes,-1);
+	vector<int> chain;
+	int maxDepth = 0;
+	for(int i=0;i<numNodes;i++){
+		int node = i;
+		while(depths[node]==-1 && nodes[node]->getParent() && nodes[node]->getParent()->graph==this){
+			chain.push_back(node);
+			node = nodes[node]->getParent()->graphIndex;
+		}
+		int depth = depths[node]==-1 ? 0 : depths[node];
+		depths[node] = depth;
+		while(!chain.empty()){
+			depths[chain.back()] = ++depth;
+			chain.pop_back();
+		}
+		maxDepth = max(maxDepth,depth);
+	}
+
+	// counting sort by depth, keeps the insertion order inside each level
+	vector<int> levelStart(maxDepth+2,0);
+	for(int i=0;i<numNodes;i++){
+		levelStart[depths[i]+1]++;
+	}
+	for(int d=0;d<=maxDepth;d++){
+		levelStart[d+1] += levelStart[d];
+	}
+	current.swap(nodes);
+	nodes.resize(numNodes);
+	for(int i=0;i<numNodes;i++){
+		nodes[levelStart[depths[i]]++] = current[i];
+	}
+
+	parents.resize(numNodes);
+	external.resize(numNodes);
+	bExternalParents = false;
+	for(int i=0;i<numNodes;i++){
+		nodes[i]->graphIndex = i;
+	}
+	for(int i=0;i<numNodes;i++){
+		ofNode * parent = nodes[i]->getParent();
+		if(parent && parent->graph==this){
+			parents[i] = parent->graphIndex;
+			external[i] = external[parents[i]];
+		}else{
+			parents[i] = -1;
+			external[i] = parent!=NULL;
+		}
+		bExternalParents |= external[i]!=0;
+	}
+	globalMatrices.resize(numNodes);
+	dirty.assign(numNodes,1);
+	recomputed.assign(numNodes,0);
+	bTopologyChanged = false;
+	bChanged = true;
+}
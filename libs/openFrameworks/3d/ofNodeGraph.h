@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ofVectorMath.h"
+#include "ofConstants.h"
+#include "ofBoundingBox.h"
+
+class ofNode;
+
+// keeps the global transformation of a set of nodes in a flat array
+// sorted so parents always come before their children. calling update()
+// once per frame computes every global matrix in one linear pass, only
+// for the nodes that changed or whose parent changed, and until any of
+// the nodes is modified again ofNode::getGlobalTransformMatrix() returns
+// the cached matrix instead of walking up the parents.
+
+// Info:
+// a node can only be in one graph at a time
+// copies of a node are not in any graph, they have to be added
+// explicitly. nodes stored in a vector have to be added after the
+// vector is filled, when it grows the nodes are copied
+// nodes remove themselves from their graph when destroyed
+// nodes whose parents are not in the graph are recomputed in every
+// update() from the parent and their global matrix is not cached
+
+class ofNodeGraph {
+public:
+	ofNodeGraph();
+	virtual ~ofNodeGraph();
+
+	void add(ofNode & node);
+	void remove(ofNode & node);
+	void clear();
+	int size() const;
+
+	// recomputes the global matrices of all the nodes that changed
+	// since the last call, sorting the graph first if nodes were
+	// added, removed or reparented
+	void update();
+
+	// true if no node in the graph has changed since the last update()
+	bool isUpToDate() const;
+
+	const ofMatrix4x4 & getGlobalTransformMatrix(const ofNode & node) const;
+
+	// updates the graph and the global bounding box of every node and
+	// the box containing each node and all its children in the graph.
+	// nodes without geometry are counted as a point at their position
+	void updateBoundingBoxes();
+	const ofBoundingBox & getGlobalBoundingBox(const ofNode & node) const;
+	const ofBoundingBox & getHierarchyBoundingBox(const ofNode & node) const;
+
+private:
+	ofNodeGraph(const ofNodeGraph &);
+	ofNodeGraph & operator=(const ofNodeGraph &);
+
+	friend class ofNode;
+	friend class ofCamera;
+	void nodeChanged(int index);
+	void topologyChanged();
+	void sort();
+	bool isCached(const ofNode & node) const;
+
+	vector<ofNode*> nodes;
+	vector<int> parents;
+	vector<ofMatrix4x4> globalMatrices;
+	vector<char> dirty;
+	vector<char> recomputed;
+	vector<char> external;
+	vector<ofBoundingBox> globalBoxes;
+	vector<ofBoundingBox> hierarchyBoxes;
+	bool bChanged;
+	bool bTopologyChanged;
+	bool bExternalParents;
+};
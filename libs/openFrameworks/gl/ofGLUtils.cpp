@@ -450,6 +450,10 @@ int ofGetGLInternalFormatFromPixelFormat(ofPixelFormat pixelFormat){
 	#else
 		return GL_RGB5;
 	#endif
+	case OF_PIXELS_I420:
+	case OF_PIXELS_NV12:
+		ofLogError("ofGLUtils") << "ofGetGLInternalFormatFromPixelFormat(): planar yuv formats can't be uploaded to one texture, convert them with ofConvertYuvToRgb(), returning GL_LUMINANCE";
+		return GL_LUMINANCE;
 	default:
 		ofLogError("ofGLUtils") << "ofGetGLInternalFormatFromPixelFormat(): unknown OF pixel format" << pixelFormat << ", returning GL_LUMINANCE";
 		return GL_LUMINANCE;
@@ -476,6 +480,10 @@ int ofGetGLTypeFromPixelFormat(ofPixelFormat pixelFormat){
 #else
         return GL_RGB5;
 #endif
+	case OF_PIXELS_I420:
+	case OF_PIXELS_NV12:
+		ofLogError("ofGLUtils") << "ofGetGLTypeFromPixelFormat(): planar yuv formats can't be uploaded to one texture, convert them with ofConvertYuvToRgb(), returning GL_LUMINANCE";
+		return GL_LUMINANCE;
 	default:
 		ofLogError("ofGLUtils") << "ofGetGLTypeFromPixelFormat(): unknown OF pixel format" << pixelFormat << ", returning GL_LUMINANCE";
 		return GL_LUMINANCE;
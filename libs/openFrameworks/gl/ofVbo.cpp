@@ -89,6 +89,44 @@ static void releaseVAO(GLuint id){
 	}
 }
 
+//--------------------------------------------------------------
+static int uploadFrame = -1;
+static size_t bytesUploadedThisFrame = 0;
+static size_t bytesUploadedLastFrame = 0;
+
+static void updateUploadFrame(){
+	int frame = ofGetFrameNum();
+	if(frame!=uploadFrame){
+		bytesUploadedLastFrame = frame==uploadFrame+1 ? bytesUploadedThisFrame : 0;
+		bytesUploadedThisFrame = 0;
+		uploadFrame = frame;
+	}
+}
+
+static void countUpload(size_t bytes){
+	updateUploadFrame();
+	bytesUploadedThisFrame += bytes;
+}
+
+//--------------------------------------------------------------
+// gives the currently bound buffer new storage of the same size so the
+// driver doesn't need to wait for the gpu to stop using the old one
+static void orphan(GLenum target){
+	GLint size, usage;
+	glGetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+	glGetBufferParameteriv(target, GL_BUFFER_USAGE, &usage);
+	glBufferData(target, size, NULL, usage);
+}
+
+//--------------------------------------------------------------
+static void updateBufferRange(GLuint id, int offset, int size, const void * data, bool bOrphan){
+	glBindBuffer(GL_ARRAY_BUFFER, id);
+	if(bOrphan) orphan(GL_ARRAY_BUFFER);
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	countUpload(size);
+}
+
 #if defined(TARGET_ANDROID) || defined(TARGET_OF_IOS)
 static set<ofVbo*> & allVbos(){
 	static set<ofVbo*> * allVbos = new set<ofVbo*>;
@@ -145,6 +183,7 @@ ofVbo::ofVbo(){
 	vaoChanged 		= false;
 	vaoID			= 0;
 	bBound   = false;
+	bOrphaning = false;
 }
 
 ofVbo::ofVbo(const ofVbo & mom){
@@ -200,6 +239,7 @@ ofVbo::ofVbo(const ofVbo & mom){
 	bAllocated		= mom.bAllocated;
 
 	bBound   = mom.bBound;
+	bOrphaning = mom.bOrphaning;
 }
 
 ofVbo & ofVbo::operator=(const ofVbo& mom){
@@ -252,6 +292,7 @@ ofVbo & ofVbo::operator=(const ofVbo& mom){
 
 	bAllocated		= mom.bAllocated;
 	bBound   = mom.bBound;
+	bOrphaning = mom.bOrphaning;
 	return *this;
 }
 
@@ -352,6 +393,7 @@ void ofVbo::setVertexData(const float * vert0x, int numCoords, int total, int us
 	glBindBuffer(GL_ARRAY_BUFFER, vertId);
 	glBufferData(GL_ARRAY_BUFFER, total * stride, vert0x, usage);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	countUpload(total * stride);
 
 }
 
@@ -373,6 +415,7 @@ void ofVbo::setColorData(const float * color0r, int total, int usage, int stride
 	glBindBuffer(GL_ARRAY_BUFFER, colorId);
 	glBufferData(GL_ARRAY_BUFFER, total * stride, color0r, usage);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	countUpload(total * stride);
 }
 
 //--------------------------------------------------------------
@@ -393,6 +436,7 @@ void ofVbo::setNormalData(const float * normal0x, int total, int usage, int stri
 	glBindBuffer(GL_ARRAY_BUFFER, normalId);
 	glBufferData(GL_ARRAY_BUFFER, total * stride, normal0x, usage);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	countUpload(total * stride);
 }
 
 //--------------------------------------------------------------
@@ -413,6 +457,7 @@ void ofVbo::setTexCoordData(const float * texCoord0x, int total, int usage, int
 	glBindBuffer(GL_ARRAY_BUFFER, texCoordId);
 	glBufferData(GL_ARRAY_BUFFER, total * stride, texCoord0x, usage);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	countUpload(total * stride);
 }
 
 
@@ -429,6 +474,7 @@ void ofVbo::setIndexData(const ofIndexType * indices, int total, int usage){
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexId);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ofIndexType) * total, &indices[0], usage);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	countUpload(sizeof(ofIndexType) * total);
 }
 
 //--------------------------------------------------------------
@@ -446,6 +492,7 @@ void ofVbo::setAttributeData(int location, const float * attrib0x, int numCoords
 	glBindBuffer(GL_ARRAY_BUFFER, attributeIds[location]);
 	glBufferData(GL_ARRAY_BUFFER, total * attributeSize[location], attrib0x, usage);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	countUpload(total * attributeSize[location]);
 }
 
 //--------------------------------------------------------------
@@ -470,9 +517,7 @@ void ofVbo::updateVertexData(const ofVec2f * verts, int total) {
 //--------------------------------------------------------------
 void ofVbo::updateVertexData(const float * vert0x, int total) {
 	if(vertId!=0){
-		glBindBuffer(GL_ARRAY_BUFFER, vertId);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, total*vertStride, vert0x);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		updateBufferRange(vertId, 0, total*vertStride, vert0x, bOrphaning);
 	}
 }
 
@@ -484,9 +529,7 @@ void ofVbo::updateColorData(const ofFloatColor * colors, int total) {
 //--------------------------------------------------------------
 void ofVbo::updateColorData(const float * color0r, int total) {
 	if(colorId!=0) {
-		glBindBuffer(GL_ARRAY_BUFFER, colorId);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, total*colorStride, color0r);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		updateBufferRange(colorId, 0, total*colorStride, color0r, bOrphaning);
 	}
 }
 
@@ -498,9 +541,7 @@ void ofVbo::updateNormalData(const ofVec3f * normals, int total) {
 //--------------------------------------------------------------
 void ofVbo::updateNormalData(const float * normal0x, int total) {
 	if(normalId!=0) {
-		glBindBuffer(GL_ARRAY_BUFFER, normalId);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, total*normalStride, normal0x);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		updateBufferRange(normalId, 0, total*normalStride, normal0x, bOrphaning);
 	}
 }
 
@@ -512,29 +553,80 @@ void ofVbo::updateTexCoordData(const ofVec2f * texCoords, int total) {
 //--------------------------------------------------------------
 void ofVbo::updateTexCoordData(const float * texCoord0x, int total) {
 	if(texCoordId!=0) {
-		glBindBuffer(GL_ARRAY_BUFFER, texCoordId);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, total*texCoordStride, texCoord0x);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		updateBufferRange(texCoordId, 0, total*texCoordStride, texCoord0x, bOrphaning);
 	}
 }
 
 //--------------------------------------------------------------
 void ofVbo::updateIndexData(const ofIndexType * indices, int total) {
 	if(indexId!=0) {
-		glBindBuffer(GL_ARRAY_BUFFER, indexId);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, total*sizeof(ofIndexType), &indices[0]);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		updateBufferRange(indexId, 0, total*sizeof(ofIndexType), &indices[0], bOrphaning);
 	}
 }
 
 void ofVbo::updateAttributeData(int location, const float * attr0x, int total){
 	if(attributeIds.find(location)!=attributeIds.end() && attributeIds[location]!=0) {
-		glBindBuffer(GL_ARRAY_BUFFER, attributeIds[location]);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, total * attributeSize[location], attr0x);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		updateBufferRange(attributeIds[location], 0, total * attributeSize[location], attr0x, bOrphaning);
+	}
+}
+
+//--------------------------------------------------------------
+void ofVbo::updateVertexDataRange(const ofVec3f * verts, int first, int total) {
+	if(vertId!=0 && total>0){
+		updateBufferRange(vertId, first*vertStride, total*vertStride, &verts[first].x, false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofVbo::updateVertexDataRange(const ofVec2f * verts, int first, int total) {
+	if(vertId!=0 && total>0){
+		updateBufferRange(vertId, first*vertStride, total*vertStride, &verts[first].x, false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofVbo::updateColorDataRange(const ofFloatColor * colors, int first, int total) {
+	if(colorId!=0 && total>0){
+		updateBufferRange(colorId, first*colorStride, total*colorStride, &colors[first].r, false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofVbo::updateNormalDataRange(const ofVec3f * normals, int first, int total) {
+	if(normalId!=0 && total>0){
+		updateBufferRange(normalId, first*normalStride, total*normalStride, &normals[first].x, false);
 	}
 }
 
+//--------------------------------------------------------------
+void ofVbo::updateTexCoordDataRange(const ofVec2f * texCoords, int first, int total) {
+	if(texCoordId!=0 && total>0){
+		updateBufferRange(texCoordId, first*texCoordStride, total*texCoordStride, &texCoords[first].x, false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofVbo::updateIndexDataRange(const ofIndexType * indices, int first, int total) {
+	if(indexId!=0 && total>0){
+		updateBufferRange(indexId, first*sizeof(ofIndexType), total*sizeof(ofIndexType), &indices[first], false);
+	}
+}
+
+//--------------------------------------------------------------
+void ofVbo::enableOrphaning(){
+	bOrphaning = true;
+}
+
+//--------------------------------------------------------------
+void ofVbo::disableOrphaning(){
+	bOrphaning = false;
+}
+
+//--------------------------------------------------------------
+bool ofVbo::getUsingOrphaning() const{
+	return bOrphaning;
+}
+
 void ofVbo::enableColors(){
 	if(colorId!=0 && !bUsingColors){
 		bUsingColors=true;
@@ -973,3 +1065,15 @@ void ofVbo::enableVAOs(){
 	supportVAOs = true;
 	vaoChecked = false;
 }
+
+//--------------------------------------------------------------
+size_t ofVbo::getNumBytesUploadedThisFrame(){
+	updateUploadFrame();
+	return bytesUploadedThisFrame;
+}
+
+//--------------------------------------------------------------
+size_t ofVbo::getNumBytesUploadedLastFrame(){
+	updateUploadFrame();
+	return bytesUploadedLastFrame;
+}
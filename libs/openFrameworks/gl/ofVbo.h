@@ -51,6 +51,22 @@ public:
 	
 	void updateAttributeData(int location, const float * vert0x, int total);
 
+	// update only total elements starting at first, the pointer is
+	// the beginning of the whole array as passed to the update*Data methods
+	void updateVertexDataRange(const ofVec3f * verts, int first, int total);
+	void updateVertexDataRange(const ofVec2f * verts, int first, int total);
+	void updateColorDataRange(const ofFloatColor * colors, int first, int total);
+	void updateNormalDataRange(const ofVec3f * normals, int first, int total);
+	void updateTexCoordDataRange(const ofVec2f * texCoords, int first, int total);
+	void updateIndexDataRange(const ofIndexType * indices, int first, int total);
+
+	// when enabled, updates of the whole buffer ask the driver for new
+	// storage first instead of waiting for the gpu to finish with the
+	// old one, useful for buffers that change every frame
+	void enableOrphaning();
+	void disableOrphaning();
+	bool getUsingOrphaning() const;
+
 	void enableColors();
 	void enableNormals();
 	void enableTexCoords();
@@ -98,6 +114,11 @@ public:
 	static void disableVAOs();
 	static void enableVAOs();
 
+	// bytes uploaded to the gpu by all the vbos during the
+	// current and the previous frame
+	static size_t getNumBytesUploadedThisFrame();
+	static size_t getNumBytesUploadedLastFrame();
+
 private:
 	GLuint vaoID;
 	bool vaoChanged;
@@ -132,6 +153,7 @@ private:
 	int texUsage;
 
 	bool bBound;
+	bool bOrphaning;
 
 	map<int,GLuint> attributeIds;
 	map<int,int> attributeSize;
@@ -29,6 +29,14 @@ void ofVboMesh::setUsage(int _usage){
 	usage = _usage;
 }
 
+void ofVboMesh::setStreaming(bool streaming){
+	if(streaming){
+		vbo.enableOrphaning();
+	}else{
+		vbo.disableOrphaning();
+	}
+}
+
 void ofVboMesh::enableColors(){
 	vbo.enableColors();
 }
@@ -153,65 +161,102 @@ void ofVboMesh::updateVbo(){
 		vboNumColors = getNumColors();
 		vboNumTexCoords = getNumTexCoords();
 		vboNumNormals = getNumNormals();
+
+		// everything was just uploaded, don't upload it again next frame
+		haveVertsChanged();
+		haveColorsChanged();
+		haveNormalsChanged();
+		haveTexCoordsChanged();
+		haveIndicesChanged();
 	}else{
 
-		if(haveVertsChanged()){
+		if(haveVertsChanged(changedRanges)){
 			if(getNumVertices()==0){
 				vbo.clearVertices();
 				vboNumVerts = getNumVertices();
 			}else if(vboNumVerts<getNumVertices()){
 				vbo.setVertexData(getVerticesPointer(),getNumVertices(),usage);
 				vboNumVerts = getNumVertices();
-			}else{
+			}else if(changedRanges.isAll()){
 				vbo.updateVertexData(getVerticesPointer(),getNumVertices());
+			}else{
+				for(int i=0;i<changedRanges.getNumRanges();i++){
+					int first = changedRanges.getFirst(i);
+					int count = min(changedRanges.getCount(i),getNumVertices()-first);
+					vbo.updateVertexDataRange(getVerticesPointer(),first,count);
+				}
 			}
 		}
 
-		if(haveColorsChanged()){
+		if(haveColorsChanged(changedRanges)){
 			if(getNumColors()==0){
 				vbo.clearColors();
 				vboNumColors = getNumColors();
 			}else if(vboNumColors<getNumColors()){
 				vbo.setColorData(getColorsPointer(),getNumColors(),usage);
 				vboNumColors = getNumColors();
-			}else{
+			}else if(changedRanges.isAll()){
 				vbo.updateColorData(getColorsPointer(),getNumColors());
+			}else{
+				for(int i=0;i<changedRanges.getNumRanges();i++){
+					int first = changedRanges.getFirst(i);
+					int count = min(changedRanges.getCount(i),getNumColors()-first);
+					vbo.updateColorDataRange(getColorsPointer(),first,count);
+				}
 			}
 		}
 
-		if(haveNormalsChanged()){
+		if(haveNormalsChanged(changedRanges)){
 			if(getNumNormals()==0){
 				vbo.clearNormals();
 				vboNumNormals = getNumNormals();
 			}else if(vboNumNormals<getNumNormals()){
 				vbo.setNormalData(getNormalsPointer(),getNumNormals(),usage);
 				vboNumNormals = getNumNormals();
-			}else{
+			}else if(changedRanges.isAll()){
 				vbo.updateNormalData(getNormalsPointer(),getNumNormals());
+			}else{
+				for(int i=0;i<changedRanges.getNumRanges();i++){
+					int first = changedRanges.getFirst(i);
+					int count = min(changedRanges.getCount(i),getNumNormals()-first);
+					vbo.updateNormalDataRange(getNormalsPointer(),first,count);
+				}
 			}
 		}
 
-		if(haveTexCoordsChanged()){
+		if(haveTexCoordsChanged(changedRanges)){
 			if(getNumTexCoords()==0){
 				vbo.clearTexCoords();
 				vboNumTexCoords = getNumTexCoords();
 			}else if(vboNumTexCoords<getNumTexCoords()){
 				vbo.setTexCoordData(getTexCoordsPointer(),getNumTexCoords(),usage);
 				vboNumTexCoords = getNumTexCoords();
-			}else{
+			}else if(changedRanges.isAll()){
 				vbo.updateTexCoordData(getTexCoordsPointer(),getNumTexCoords());
+			}else{
+				for(int i=0;i<changedRanges.getNumRanges();i++){
+					int first = changedRanges.getFirst(i);
+					int count = min(changedRanges.getCount(i),getNumTexCoords()-first);
+					vbo.updateTexCoordDataRange(getTexCoordsPointer(),first,count);
+				}
 			}
 		}
 
-		if(haveIndicesChanged()){
+		if(haveIndicesChanged(changedRanges)){
 			if(getNumIndices()==0){
 				vbo.clearIndices();
 				vboNumIndices = getNumIndices();
 			}else if(vboNumIndices<getNumIndices()){
 				vbo.setIndexData(getIndexPointer(),getNumIndices(),usage);
 				vboNumIndices = getNumIndices();
-			}else{
+			}else if(changedRanges.isAll()){
 				vbo.updateIndexData(getIndexPointer(),getNumIndices());
+			}else{
+				for(int i=0;i<changedRanges.getNumRanges();i++){
+					int first = changedRanges.getFirst(i);
+					int count = min(changedRanges.getCount(i),getNumIndices()-first);
+					vbo.updateIndexDataRange(getIndexPointer(),first,count);
+				}
 			}
 		}
 	}
@@ -11,6 +11,9 @@ public:
 	void operator=(const ofMesh & mom);
 	void setUsage(int usage);
 
+	// orphan the vbo storage on every full update, see ofVbo::enableOrphaning
+	void setStreaming(bool streaming);
+
     void enableColors();
     void enableTextures();
     void enableNormals();
@@ -36,4 +39,5 @@ private:
 	ofVbo vbo;
 	int usage;
 	int vboNumVerts, vboNumIndices, vboNumNormals, vboNumTexCoords, vboNumColors;
+	ofMeshDirtyRanges changedRanges;
 };
@@ -78,15 +78,15 @@ void ofInitFreeImage(bool deinit=false){
 }
 
 template <typename T>
-FREE_IMAGE_TYPE getFreeImageType(ofPixels_<T>& pix);
+FREE_IMAGE_TYPE getFreeImageType(const ofPixels_<T>& pix);
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofPixels& pix) {
 	return FIT_BITMAP;
 }
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofShortPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofShortPixels& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_UINT16;
 		case 3: return FIT_RGB16;
@@ -97,7 +97,7 @@ FREE_IMAGE_TYPE getFreeImageType(ofShortPixels& pix) {
 	}
 }
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofFloatPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixels& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_FLOAT;
 		case 3: return FIT_RGBF;
@@ -108,40 +108,126 @@ FREE_IMAGE_TYPE getFreeImageType(ofFloatPixels& pix) {
 	}
 }
 
+//----------------------------------------------------
+// copies a row of 8 bit pixels changing the number of channels and
+// swapping red and blue if the channel orders are different. FreeImage
+// keeps 8 bit color as BGR(A) on little endian machines, converting
+// while copying avoids a second pass over the pixels to swap them
+static void convertRow(const unsigned char * src, int srcChannels, bool srcBgr, unsigned char * dst, int dstChannels, bool dstBgr, int width){
+	if(srcChannels==dstChannels && (srcBgr==dstBgr || srcChannels<3)){
+		memcpy(dst, src, width * srcChannels);
+		return;
+	}
+	const int srcR = srcBgr ? 2 : 0;
+	const int srcB = srcBgr ? 0 : 2;
+	const int dstR = dstBgr ? 2 : 0;
+	const int dstB = dstBgr ? 0 : 2;
+	for(int i = 0; i < width; i++) {
+		unsigned char r, g, b, a;
+		if(srcChannels < 3) {
+			r = g = b = src[0];
+			a = srcChannels == 2 ? src[1] : 255;
+		} else {
+			r = src[srcR];
+			g = src[1];
+			b = src[srcB];
+			a = srcChannels == 4 ? src[3] : 255;
+		}
+		if(dstChannels < 3) {
+			dst[0] = r;
+			if(dstChannels == 2) dst[1] = a;
+		} else {
+			dst[dstR] = r;
+			dst[1] = g;
+			dst[dstB] = b;
+			if(dstChannels == 4) dst[3] = a;
+		}
+		src += srcChannels;
+		dst += dstChannels;
+	}
+}
+
 //----------------------------------------------------
 template<typename PixelType>
-FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
-	PixelType* pixels = pix.getPixels();
+FIBITMAP* getBmpFromPixels(const ofPixels_<PixelType> &pix, int bmpChannels = 0){
 	unsigned int width = pix.getWidth();
 	unsigned int height = pix.getHeight();
-	unsigned int bpp = pix.getBitsPerPixel();
+	int pixChannels = pix.getNumChannels();
+	if(bmpChannels == 0 || sizeof(PixelType) != 1) {
+		bmpChannels = pixChannels;
+	}
+	unsigned int bpp = bmpChannels * sizeof(PixelType) * 8;
 	
 	FREE_IMAGE_TYPE freeImageType = getFreeImageType(pix);
 	FIBITMAP* bmp = FreeImage_AllocateT(freeImageType, width, height, bpp);
-	unsigned char* bmpBits = FreeImage_GetBits(bmp);
-	if(bmpBits != NULL) {
-		int srcStride = width * pix.getBytesPerPixel();
-		int dstStride = FreeImage_GetPitch(bmp);
-		unsigned char* src = (unsigned char*) pixels;
-		unsigned char* dst = bmpBits;
-		for(int i = 0; i < (int)height; i++) {
-			memcpy(dst, src, srcStride);
-			src += srcStride;
-			dst += dstStride;
-		}
-	} else {
+	if(bmp == NULL || FreeImage_GetBits(bmp) == NULL) {
 		ofLogError("ofImage") << "getBmpFromPixels(): unable to get FIBITMAP from ofPixels";
+		return bmp;
+	}
+
+	// ofPixels are top left, FIBITMAP is bottom left so rows
+	// are flipped while copying them
+	const bool pixBgr = pix.getPixelFormat() == OF_PIXELS_BGRA;
+	const bool bmpBgr = FI_RGBA_RED == 2;
+	const int srcStride = width * pixChannels;
+	const PixelType * src = pix.getPixels();
+	for(int y = 0; y < (int)height; y++) {
+		unsigned char * dst = FreeImage_GetScanLine(bmp, height - 1 - y);
+		if(sizeof(PixelType) == 1) {
+			convertRow((const unsigned char*)src, pixChannels, pixBgr, dst, bmpChannels, bmpBgr, width);
+		} else {
+			memcpy(dst, src, srcStride * sizeof(PixelType));
+		}
+		src += srcStride;
 	}
-	
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
 	
 	return bmp;
 }
 
+//----------------------------------------------------
+// type used to add up the pixels of a box when downscaling
+template<typename PixelType>
+struct BoxSum{
+	typedef float Type;
+};
+
+template<>
+struct BoxSum<unsigned char>{
+	typedef unsigned int Type;
+};
+
+//----------------------------------------------------
+// averages boxes of factor x factor pixels of the bitmap into one row of
+// dstWidth pixels, y is the row in ofPixels coordinates
+template<typename PixelType>
+static void boxDownscaleRow(FIBITMAP * bmp, int y, int factor, int channels, int dstWidth, vector<typename BoxSum<PixelType>::Type> & sums, vector<PixelType> & row){
+	const int height = FreeImage_GetHeight(bmp);
+	const int rowSize = dstWidth * channels;
+	const int pixelStride = factor * channels;
+	sums.assign(rowSize, 0);
+	for(int fy = 0; fy < factor; fy++) {
+		const PixelType * line = (const PixelType*) FreeImage_GetScanLine(bmp, height - 1 - (y * factor + fy));
+		for(int x = 0; x < dstWidth; x++) {
+			const PixelType * src = line + x * pixelStride;
+			typename BoxSum<PixelType>::Type * sum = &sums[x * channels];
+			for(int fx = 0; fx < factor; fx++) {
+				for(int c = 0; c < channels; c++) {
+					sum[c] += src[c];
+				}
+				src += channels;
+			}
+		}
+	}
+	const int area = factor * factor;
+	row.resize(rowSize);
+	for(int i = 0; i < rowSize; i++) {
+		row[i] = sums[i] / area;
+	}
+}
+
 //----------------------------------------------------
 template<typename PixelType>
-void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLittleEndian = true) {
+void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, ofPixelFormat format = OF_PIXELS_UNKNOWN, int maxWidth = 0, int maxHeight = 0) {
 	// some images use a palette, or <8 bpp, so convert them to raster 8-bit channels
 	FIBITMAP* bmpConverted = NULL;
 	if(FreeImage_GetColorType(bmp) == FIC_PALETTE || FreeImage_GetBPP(bmp) < 8) {
@@ -157,14 +243,60 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLit
 	unsigned int height = FreeImage_GetHeight(bmp);
 	unsigned int bpp = FreeImage_GetBPP(bmp);
 	unsigned int channels = (bpp / sizeof(PixelType)) / 8;
-	unsigned int pitch = FreeImage_GetPitch(bmp);
 
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
-	
-	unsigned char* bmpBits = FreeImage_GetBits(bmp);
-	if(bmpBits != NULL) {
-		pix.setFromAlignedPixels((PixelType*) bmpBits, width, height, channels, pitch);
+	// images bigger than the maximum size are box filtered while copying
+	// them by the smallest integer factor that makes them fit
+	int factor = 1;
+	if(maxWidth > 0) factor = max(factor, (int)(width + maxWidth - 1) / maxWidth);
+	if(maxHeight > 0) factor = max(factor, (int)(height + maxHeight - 1) / maxHeight);
+	const int dstWidth = width / factor;
+	const int dstHeight = height / factor;
+
+	if(FreeImage_GetBits(bmp) != NULL) {
+		// pixels that are already allocated with the same size and
+		// format are decoded in place without reallocating them
+		if(sizeof(PixelType) == 1) {
+			if(format == OF_PIXELS_UNKNOWN) {
+				switch(channels) {
+					case 1: format = OF_PIXELS_MONO; break;
+					case 3: format = OF_PIXELS_RGB; break;
+					case 4: format = OF_PIXELS_RGBA; break;
+				}
+			}
+		} else if(format != OF_PIXELS_UNKNOWN) {
+			ofLogWarning("ofImage") << "putBmpIntoPixels(): pixel format can only be chosen for 8 bit pixels, ignoring";
+			format = OF_PIXELS_UNKNOWN;
+		}
+		if(format != OF_PIXELS_UNKNOWN) {
+			pix.allocate(dstWidth, dstHeight, format);
+		} else {
+			pix.allocate(dstWidth, dstHeight, channels);
+		}
+
+		// ofPixels are top left, FIBITMAP is bottom left so rows
+		// are flipped while copying them
+		const bool bmpBgr = FI_RGBA_RED == 2;
+		const bool pixBgr = pix.getPixelFormat() == OF_PIXELS_BGRA;
+		const int pixChannels = pix.getNumChannels();
+		const int dstStride = dstWidth * pixChannels;
+		vector<typename BoxSum<PixelType>::Type> sums;
+		vector<PixelType> boxRow;
+		PixelType * dst = pix.getPixels();
+		for(int y = 0; y < dstHeight; y++) {
+			const unsigned char * src;
+			if(factor == 1) {
+				src = FreeImage_GetScanLine(bmp, height - 1 - y);
+			} else {
+				boxDownscaleRow(bmp, y, factor, channels, dstWidth, sums, boxRow);
+				src = (const unsigned char*) &boxRow[0];
+			}
+			if(sizeof(PixelType) == 1) {
+				convertRow(src, channels, bmpBgr, (unsigned char*)dst, pixChannels, pixBgr, dstWidth);
+			} else {
+				memcpy(dst, src, dstStride * sizeof(PixelType));
+			}
+			dst += dstStride;
+		}
 	} else {
 		ofLogError("ofImage") << "putBmpIntoPixels(): unable to set ofPixels from FIBITMAP";
 	}
@@ -172,19 +304,25 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLit
 	if(bmpConverted != NULL) {
 		FreeImage_Unload(bmpConverted);
 	}
+}
 
-#ifdef TARGET_LITTLE_ENDIAN
-	if(swapForLittleEndian && sizeof(PixelType) == 1) {
-		pix.swapRgb();
+//----------------------------------------------------
+// the jpeg decoder can scale the image by 1/2, 1/4 or 1/8 while decoding
+// it, passing the size in the upper bits of the flags FreeImage chooses
+// the smallest scale that keeps the longest side at least that size
+static int getLoadFlags(FREE_IMAGE_FORMAT fif, int maxWidth, int maxHeight){
+	if(fif == FIF_JPEG && (maxWidth > 0 || maxHeight > 0)) {
+		int size = max(maxWidth, maxHeight);
+		return JPEG_DEFAULT | (min(size, 0xffff) << 16);
 	}
-#endif
+	return 0;
 }
 
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
+static bool loadImage(ofPixels_<PixelType> & pix, string fileName, ofPixelFormat format = OF_PIXELS_UNKNOWN, int maxWidth = 0, int maxHeight = 0){
 	ofInitFreeImage();
 	if(fileName.substr(0, 7) == "http://") {
-		return ofLoadImage(pix, ofLoadURL(fileName).data);
+		return loadImage(pix, ofLoadURL(fileName).data, format, maxWidth, maxHeight);
 	}
 	
 	fileName = ofToDataPath(fileName);
@@ -198,7 +336,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 		fif = FreeImage_GetFIFFromFilename(fileName.c_str());
 	}
 	if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
-		bmp = FreeImage_Load(fif, fileName.c_str(), 0);
+		bmp = FreeImage_Load(fif, fileName.c_str(), getLoadFlags(fif, maxWidth, maxHeight));
 
 		if (bmp != NULL){
 			bLoaded = true;
@@ -208,7 +346,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 	//-----------------------------
 
 	if ( bLoaded ){
-		putBmpIntoPixels(bmp,pix);
+		putBmpIntoPixels(bmp,pix,format,maxWidth,maxHeight);
 	}
 
 	if (bmp != NULL){
@@ -219,7 +357,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 }
 
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, ofPixelFormat format = OF_PIXELS_UNKNOWN, int maxWidth = 0, int maxHeight = 0){
 	ofInitFreeImage();
 	bool bLoaded = false;
 	FIBITMAP* bmp = NULL;
@@ -235,13 +373,13 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
 	FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeFromMemory(hmem);
 	if( fif == -1 ){
 		ofLogError("ofImage") << "loadImage(): couldn't load image from ofBuffer, unable to guess image format from memory";
-		return false;
 		FreeImage_CloseMemory(hmem);
+		return false;
 	}
 
 
 	//make the image!!
-	bmp = FreeImage_LoadFromMemory(fif, hmem, 0);
+	bmp = FreeImage_LoadFromMemory(fif, hmem, getLoadFlags(fif, maxWidth, maxHeight));
 	
 	if( bmp != NULL ){
 		bLoaded = true;
@@ -250,7 +388,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
 	//-----------------------------
 	
 	if (bLoaded){
-		putBmpIntoPixels(bmp,pix);
+		putBmpIntoPixels(bmp,pix,format,maxWidth,maxHeight);
 	}
 
 	if (bmp != NULL){
@@ -275,6 +413,26 @@ bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer) {
 	return loadImage(pix,buffer);
 }
 
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, string fileName, ofPixelFormat format) {
+	return loadImage(pix,fileName,format);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, ofPixelFormat format) {
+	return loadImage(pix,buffer,format);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, string fileName, int maxWidth, int maxHeight) {
+	return loadImage(pix,fileName,OF_PIXELS_UNKNOWN,maxWidth,maxHeight);
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, int maxWidth, int maxHeight) {
+	return loadImage(pix,buffer,OF_PIXELS_UNKNOWN,maxWidth,maxHeight);
+}
+
 //----------------------------------------------------
 bool ofLoadImage(ofFloatPixels & pix, string path){
 	return loadImage(pix,path);
@@ -320,27 +478,13 @@ bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer){
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualityType qualityLevel) {
+static bool saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualityType qualityLevel, int pngCompressionLevel = -1) {
 	ofInitFreeImage();
 	if (pix.isAllocated() == false){
 		ofLogError("ofImage") << "saveImage(): couldn't save \"" << fileName << "\", pixels are not allocated";
-		return;
-	}
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
+		return false;
 	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
 
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
-	
 	ofFilePath::createEnclosingDirectory(fileName);
 	fileName = ofToDataPath(fileName);
 	FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
@@ -349,6 +493,10 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 		// or guess via filename
 		fif = FreeImage_GetFIFFromFilename(fileName.c_str());
 	}
+
+	// jpeg has no alpha, it's dropped while copying into the bitmap
+	FIBITMAP * bmp	= getBmpFromPixels(pix, fif == FIF_JPEG && pix.getNumChannels() == 4 ? 3 : 0);
+	bool bSaved = false;
 	if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
 		if(fif == FIF_JPEG) {
 			int quality = JPEG_QUALITYSUPERB;
@@ -359,7 +507,7 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 				case OF_IMAGE_QUALITY_HIGH: quality = JPEG_QUALITYGOOD; break;
 				case OF_IMAGE_QUALITY_BEST: quality = JPEG_QUALITYSUPERB; break;
 			}
-			FreeImage_Save(fif, bmp, fileName.c_str(), quality);
+			bSaved = FreeImage_Save(fif, bmp, fileName.c_str(), quality);
 		} else {
 			if(qualityLevel != OF_IMAGE_QUALITY_BEST) {
 				ofLogWarning("ofImage") << "saveImage(): ofImageCompressionType only applies to JPEGs,"
@@ -375,12 +523,15 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 					// this will create a 256-color palette from the image
 					convertedBmp = FreeImage_ColorQuantize(bmp, FIQ_NNQUANT);
 				}
-				FreeImage_Save(fif, convertedBmp, fileName.c_str());
+				bSaved = FreeImage_Save(fif, convertedBmp, fileName.c_str());
 				if (convertedBmp != NULL){
 					FreeImage_Unload(convertedBmp);
 				}
+			} else if (fif == FIF_PNG && pngCompressionLevel >= 0) {
+				int flags = pngCompressionLevel == 0 ? PNG_Z_NO_COMPRESSION : min(pngCompressionLevel, 9);
+				bSaved = FreeImage_Save(fif, bmp, fileName.c_str(), flags);
 			} else {
-				FreeImage_Save(fif, bmp, fileName.c_str());
+				bSaved = FreeImage_Save(fif, bmp, fileName.c_str());
 			}
 		}
 	}
@@ -388,6 +539,7 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 	if (bmp != NULL){
 		FreeImage_Unload(bmp);
 	}
+	return bSaved;
 }
 
 //----------------------------------------------------------------
@@ -395,6 +547,11 @@ void ofSaveImage(ofPixels & pix, string fileName, ofImageQualityType qualityLeve
 	saveImage(pix,fileName,qualityLevel);
 }
 
+//----------------------------------------------------------------
+bool ofSaveImage(ofPixels & pix, string fileName, ofImageQualityType qualityLevel, int pngCompressionLevel){
+	return saveImage(pix,fileName,qualityLevel,pngCompressionLevel);
+}
+
 //----------------------------------------------------------------
 void ofSaveImage(ofFloatPixels & pix, string fileName, ofImageQualityType qualityLevel) {
 	saveImage(pix,fileName,qualityLevel);
@@ -417,26 +574,8 @@ static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageForm
 		return;
 	}
 
-	if(format==OF_IMAGE_FORMAT_JPEG && pix.getNumChannels()==4){
-		ofPixels pix3 = pix;
-		pix3.setNumChannels(3);
-		saveImage(pix3,buffer,format,qualityLevel);
-		return;
-	}
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
+	// jpeg has no alpha, it's dropped while copying into the bitmap
+	FIBITMAP * bmp	= getBmpFromPixels(pix, format == OF_IMAGE_FORMAT_JPEG && pix.getNumChannels() == 4 ? 3 : 0);
 
 	if (bmp)  // bitmap successfully created
 	{
@@ -1179,7 +1318,7 @@ void ofImage_<PixelType>::resizePixels(ofPixels_<PixelType> &pix, int newWidth,
 	FIBITMAP * convertedBmp			= NULL;
 
 	convertedBmp = FreeImage_Rescale(bmp, newWidth, newHeight, FILTER_BICUBIC);
-	putBmpIntoPixels(convertedBmp, pix, false);
+	putBmpIntoPixels(convertedBmp, pix);
 
 	if (bmp != NULL)				FreeImage_Unload(bmp);
 	if (convertedBmp != NULL)		FreeImage_Unload(convertedBmp);
@@ -1212,7 +1351,7 @@ void ofImage_<PixelType>::changeTypeOfPixels(ofPixels_<PixelType> &pix, ofImageT
 			break;
 	}
 	
-	putBmpIntoPixels(convertedBmp, pix, false);
+	putBmpIntoPixels(convertedBmp, pix);
 
 	if (bmp != NULL) {
 		FreeImage_Unload(bmp);
@@ -59,6 +59,19 @@ enum ofImageFormat {
 bool ofLoadImage(ofPixels & pix, string path);
 bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer);
 
+// decodes straight into pix in the requested format (OF_PIXELS_MONO, RGB,
+// RGBA or BGRA) converting channels while copying. if pix is already
+// allocated with the same size and format its memory is reused
+bool ofLoadImage(ofPixels & pix, string path, ofPixelFormat format);
+bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, ofPixelFormat format);
+
+// loads the image scaled down to fit in maxWidth x maxHeight, 0 means no
+// limit. jpegs are decoded at 1/2, 1/4 or 1/8 of their size and the rest
+// is averaged by an integer factor while copying, so the result can be a
+// bit smaller than the maximum. use resize() after if the exact size matters
+bool ofLoadImage(ofPixels & pix, string path, int maxWidth, int maxHeight);
+bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, int maxWidth, int maxHeight);
+
 bool ofLoadImage(ofFloatPixels & pix, string path);
 bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer);
 
@@ -70,6 +83,9 @@ bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer);
 
 void ofSaveImage(ofPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 void ofSaveImage(ofPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+// pngs are saved with the zlib compression level pngCompressionLevel,
+// from 0 (none, fastest) to 9 (smallest, slowest). returns false on errors
+bool ofSaveImage(ofPixels & pix, string path, ofImageQualityType qualityLevel, int pngCompressionLevel);
 
 void ofSaveImage(ofFloatPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 void ofSaveImage(ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
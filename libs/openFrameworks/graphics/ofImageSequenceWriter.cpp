@@ -0,0 +1,269 @@
+#include "ofImageSequenceWriter.h"
+#include "ofUtils.h"
+#include "ofFileUtils.h"
+#include "Poco/Environment.h"
+
+// defined in ofImage.cpp, FreeImage has to be initialized
+// before the encoders start using it from several threads
+void ofInitFreeImage(bool deinit);
+
+//----------------------------------------------------------
+ofImageSequenceWriter::ofImageSequenceWriter()
+:numDigits(5)
+,pngCompressionLevel(1)
+,quality(OF_IMAGE_QUALITY_BEST)
+,maxQueuedFrames(8)
+,numEncoding(0)
+,numAdded(0)
+,numDropped(0)
+,numFailed(0)
+,numSaved(0)
+,bBlocking(true)
+,bClosing(false){
+}
+
+//----------------------------------------------------------
+ofImageSequenceWriter::~ofImageSequenceWriter(){
+	close();
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::setup(string _pathPrefix, string _extension, int numThreads, int _maxQueuedFrames){
+	close();
+
+	pathPrefix = _pathPrefix;
+	extension = _extension;
+	maxQueuedFrames = max(1,_maxQueuedFrames);
+	numAdded = 0;
+	numDropped = 0;
+	numFailed = 0;
+	numSaved = 0;
+	savedOutOfOrder.clear();
+	bClosing = false;
+	// reserved so growing it never copies the pixels
+	freePixels.reserve(maxQueuedFrames);
+
+	ofInitFreeImage(false);
+	ofFilePath::createEnclosingDirectory(getFileName(0));
+
+	if(numThreads<=0){
+		numThreads = max(1,(int)Poco::Environment::processorCount()-1);
+	}
+	for(int i=0;i<numThreads;i++){
+		encoders.push_back(new Encoder(*this));
+		encoders.back()->startThread(true,false);
+	}
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::close(){
+	if(encoders.empty()) return;
+	waitForQueue();
+	stopEncoders();
+	freePixels.clear();
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::stopEncoders(){
+	mutex.lock();
+	bClosing = true;
+	frameAdded.broadcast();
+	mutex.unlock();
+	for(int i=0;i<(int)encoders.size();i++){
+		encoders[i]->waitForThread(false);
+		delete encoders[i];
+	}
+	encoders.clear();
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::setPngCompressionLevel(int level){
+	ofMutex::ScopedLock lock(mutex);
+	pngCompressionLevel = max(0,min(level,9));
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getPngCompressionLevel(){
+	return pngCompressionLevel;
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::setQuality(ofImageQualityType _quality){
+	ofMutex::ScopedLock lock(mutex);
+	quality = _quality;
+}
+
+//----------------------------------------------------------
+ofImageQualityType ofImageSequenceWriter::getQuality(){
+	return quality;
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::setNumDigits(int _numDigits){
+	ofMutex::ScopedLock lock(mutex);
+	numDigits = _numDigits;
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::setBlocking(bool _bBlocking){
+	bBlocking = _bBlocking;
+}
+
+//----------------------------------------------------------
+bool ofImageSequenceWriter::isBlocking(){
+	return bBlocking;
+}
+
+//----------------------------------------------------------
+bool ofImageSequenceWriter::add(ofPixels & pixels){
+	if(encoders.empty()){
+		ofLogError("ofImageSequenceWriter") << "add(): writer not setup";
+		return false;
+	}
+	if(!pixels.isAllocated()){
+		ofLogWarning("ofImageSequenceWriter") << "add(): pixels not allocated, skipping";
+		return false;
+	}
+
+	ofMutex::ScopedLock lock(mutex);
+	while((int)frames.size() + numEncoding >= maxQueuedFrames){
+		if(!bBlocking){
+			numDropped++;
+			return false;
+		}
+		frameFinished.wait(mutex);
+	}
+
+	frames.push_back(Frame());
+	Frame & frame = frames.back();
+	frame.number = numAdded++;
+	frame.pixels.swap(pixels);
+
+	// hand back a buffer from an already saved frame so the caller
+	// doesn't need to allocate a new one every frame
+	if(!freePixels.empty()){
+		pixels.swap(freePixels.back());
+		freePixels.pop_back();
+	}
+
+	frameAdded.signal();
+	return true;
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::waitForQueue(){
+	ofMutex::ScopedLock lock(mutex);
+	while(!frames.empty() || numEncoding>0){
+		frameFinished.wait(mutex);
+	}
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getNumQueuedFrames(){
+	ofMutex::ScopedLock lock(mutex);
+	return frames.size() + numEncoding;
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getMaxQueuedFrames(){
+	return maxQueuedFrames;
+}
+
+//----------------------------------------------------------
+bool ofImageSequenceWriter::isFull(){
+	return getNumQueuedFrames() >= maxQueuedFrames;
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getNumAddedFrames(){
+	ofMutex::ScopedLock lock(mutex);
+	return numAdded;
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getNumDroppedFrames(){
+	ofMutex::ScopedLock lock(mutex);
+	return numDropped;
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getNumFailedFrames(){
+	ofMutex::ScopedLock lock(mutex);
+	return numFailed;
+}
+
+//----------------------------------------------------------
+int ofImageSequenceWriter::getNumSavedFrames(){
+	ofMutex::ScopedLock lock(mutex);
+	return numSaved;
+}
+
+//----------------------------------------------------------
+string ofImageSequenceWriter::getFileName(int frame){
+	return pathPrefix + ofToString(frame,numDigits,'0') + "." + extension;
+}
+
+//----------------------------------------------------------
+bool ofImageSequenceWriter::waitForFrame(Frame & frame){
+	ofMutex::ScopedLock lock(mutex);
+	while(frames.empty()){
+		if(bClosing) return false;
+		frameAdded.wait(mutex);
+	}
+	frame.number = frames.front().number;
+	frame.pixels.swap(frames.front().pixels);
+	frames.pop_front();
+	numEncoding++;
+	return true;
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::finished(Frame & frame, bool bSaved){
+	ofMutex::ScopedLock lock(mutex);
+	numEncoding--;
+	if(!bSaved){
+		numFailed++;
+	}
+
+	// frames can finish in any order, the saved count only advances
+	// when all the frames before it are done
+	if(frame.number==numSaved){
+		numSaved++;
+		while(!savedOutOfOrder.empty() && *savedOutOfOrder.begin()==numSaved){
+			savedOutOfOrder.erase(savedOutOfOrder.begin());
+			numSaved++;
+		}
+	}else{
+		savedOutOfOrder.insert(frame.number);
+	}
+
+	if((int)freePixels.size()<maxQueuedFrames){
+		freePixels.push_back(ofPixels());
+		freePixels.back().swap(frame.pixels);
+	}
+	frame.pixels.clear();
+	frameFinished.broadcast();
+}
+
+//----------------------------------------------------------
+ofImageSequenceWriter::Encoder::Encoder(ofImageSequenceWriter & writer)
+:writer(writer){
+}
+
+//----------------------------------------------------------
+void ofImageSequenceWriter::Encoder::threadedFunction(){
+	Frame frame;
+	while(writer.waitForFrame(frame)){
+		writer.mutex.lock();
+		string fileName = writer.getFileName(frame.number);
+		ofImageQualityType quality = writer.quality;
+		int pngCompressionLevel = writer.pngCompressionLevel;
+		writer.mutex.unlock();
+
+		bool bSaved = ofSaveImage(frame.pixels,fileName,quality,pngCompressionLevel);
+		if(!bSaved){
+			ofLogError("ofImageSequenceWriter") << "couldn't save frame " << frame.number << " to \"" << fileName << "\"";
+		}
+		writer.finished(frame,bSaved);
+	}
+}
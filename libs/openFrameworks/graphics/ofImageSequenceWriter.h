@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofPixels.h"
+#include "ofImage.h"
+#include "ofThread.h"
+#include "Poco/Condition.h"
+#include <deque>
+#include <set>
+
+// saves a sequence of frames to disk encoding them in a pool of threads
+// so the app doesn't have to wait for the compression. every frame gets
+// its number when it's added so the files are always named in the order
+// the frames were added, whatever order they finish encoding in.
+//
+// Info:
+// the queue is bounded, when it's full add() either waits for a frame to
+// finish or, with setBlocking(false), returns false and drops the frame
+// add() takes the pixels without copying them, see add()
+// close() or the destructor wait for all the queued frames to be saved
+
+class ofImageSequenceWriter {
+public:
+	ofImageSequenceWriter();
+	virtual ~ofImageSequenceWriter();
+
+	// files are named pathPrefix + frame number padded to numDigits + "." + extension,
+	// the extension sets the format. numThreads 0 uses one thread less than cores
+	void setup(string pathPrefix, string extension = "png", int numThreads = 0, int maxQueuedFrames = 8);
+	void close();
+
+	// zlib compression for pngs from 0 (none, fastest) to 9 (smallest, slowest),
+	// 1 by default since speed usually matters more than size for sequences
+	void setPngCompressionLevel(int level);
+	int getPngCompressionLevel();
+	void setQuality(ofImageQualityType quality);
+	ofImageQualityType getQuality();
+	void setNumDigits(int numDigits);
+	void setBlocking(bool bBlocking);
+	bool isBlocking();
+
+	// queues the pixels to be saved swapping them with a buffer of a
+	// frame that was already saved, so after the call pixels holds an
+	// allocated buffer with undefined content or is empty. returns false
+	// if the frame was dropped because the queue was full, pixels are not
+	// touched in that case
+	bool add(ofPixels & pixels);
+
+	// blocks until every queued frame has been saved
+	void waitForQueue();
+
+	// backpressure, the app can skip frames or slow down when the queue
+	// is getting full instead of blocking
+	int getNumQueuedFrames();
+	int getMaxQueuedFrames();
+	bool isFull();
+
+	int getNumAddedFrames();
+	int getNumDroppedFrames();
+	int getNumFailedFrames();
+
+	// frames saved counting from the first one without gaps, every frame
+	// before this number is on disk
+	int getNumSavedFrames();
+
+	// name of the file frame number will be saved to
+	string getFileName(int frame);
+
+private:
+	ofImageSequenceWriter(const ofImageSequenceWriter &);
+	ofImageSequenceWriter & operator=(const ofImageSequenceWriter &);
+
+	struct Frame{
+		ofPixels pixels;
+		int number;
+	};
+
+	class Encoder: public ofThread{
+	public:
+		Encoder(ofImageSequenceWriter & writer);
+		void threadedFunction();
+		ofImageSequenceWriter & writer;
+	};
+
+	bool waitForFrame(Frame & frame);
+	void finished(Frame & frame, bool bSaved);
+	void stopEncoders();
+
+	friend class Encoder;
+
+	vector<Encoder*> encoders;
+	deque<Frame> frames;
+	vector<ofPixels> freePixels;
+	set<int> savedOutOfOrder;
+	ofMutex mutex;
+	Poco::Condition frameAdded;
+	Poco::Condition frameFinished;
+
+	string pathPrefix;
+	string extension;
+	int numDigits;
+	int pngCompressionLevel;
+	ofImageQualityType quality;
+	int maxQueuedFrames;
+	int numEncoding;
+	int numAdded;
+	int numDropped;
+	int numFailed;
+	int numSaved;
+	bool bBlocking;
+	bool bClosing;
+};
@@ -1,6 +1,10 @@
 #include "ofPixels.h"
 #include "ofMath.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 
 static ofImageType getImageTypeFromChannels(int channels){
 	switch(channels){
@@ -15,11 +19,53 @@ static ofImageType getImageTypeFromChannels(int channels){
 	}
 }
 
+static ofPixelFormat getPixelFormatFromChannels(int channels){
+	switch(channels){
+	case 1:
+		return OF_PIXELS_MONO;
+	case 3:
+		return OF_PIXELS_RGB;
+	case 4:
+		return OF_PIXELS_RGBA;
+	default:
+		return OF_PIXELS_UNKNOWN;
+	}
+}
+
+static int getNumChannelsFromPixelFormat(ofPixelFormat format){
+	switch(format){
+	case OF_PIXELS_MONO:
+	case OF_PIXELS_I420:
+	case OF_PIXELS_NV12:
+		return 1;
+	case OF_PIXELS_RGB565:
+		return 2;
+	case OF_PIXELS_RGB:
+		return 3;
+	case OF_PIXELS_RGBA:
+	case OF_PIXELS_BGRA:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+static bool isPlanar(ofPixelFormat format){
+	return format==OF_PIXELS_I420 || format==OF_PIXELS_NV12;
+}
+
+// number of elements of a w x h image in a planar format, chroma
+// planes are rounded up for odd sizes
+static int getPlanarSize(int w, int h){
+	return w*h + 2*((w+1)/2)*((h+1)/2);
+}
+
 template<typename PixelType>
 ofPixels_<PixelType>::ofPixels_(){
 	bAllocated = false;
 	pixelsOwner = false;
 	channels = 0;
+	pixelFormat = OF_PIXELS_UNKNOWN;
 	pixels = NULL;
 	clear();
 }
@@ -35,6 +81,7 @@ ofPixels_<PixelType>::ofPixels_(const ofPixels_<PixelType> & mom){
 	bAllocated = false;
 	pixelsOwner = false;
 	channels = 0;
+	pixelFormat = OF_PIXELS_UNKNOWN;
 	pixels = NULL;
 	width = 0;
 	height = 0;
@@ -53,14 +100,19 @@ ofPixels_<PixelType>& ofPixels_<PixelType>::operator=(const ofPixels_<PixelType>
 template<typename PixelType>
 void ofPixels_<PixelType>::copyFrom(const ofPixels_<PixelType> & mom){
 	if(mom.isAllocated()) {
-		allocate(mom.getWidth(), mom.getHeight(), mom.getNumChannels());
-		memcpy(pixels, mom.getPixels(), mom.getWidth() * mom.getHeight() * mom.getBytesPerPixel());
+		if(isPlanar(mom.pixelFormat)){
+			allocate(mom.getWidth(), mom.getHeight(), mom.pixelFormat);
+		}else{
+			allocate(mom.getWidth(), mom.getHeight(), mom.getNumChannels());
+			pixelFormat = mom.pixelFormat;
+		}
+		memcpy(pixels, mom.getPixels(), mom.size() * sizeof(PixelType));
 	}
 }
 
 template<typename PixelType>
 void ofPixels_<PixelType>::set(PixelType val){
-	int size = width * height * channels;
+	int size = this->size();
 	for(int i = 0; i < size; i++){
 		pixels[i] = val;
 	}
@@ -106,11 +158,19 @@ void ofPixels_<PixelType>::setFromExternalPixels(PixelType * newPixels, int w, i
 	width= w;
 	height = h;
 
+	pixelFormat = getPixelFormatFromChannels(channels);
+
 	pixels = newPixels;
 	pixelsOwner = false;
 	bAllocated = true;
 }
 
+template<typename PixelType>
+void ofPixels_<PixelType>::setFromExternalPixels(PixelType * newPixels, int w, int h, ofPixelFormat format){
+	setFromExternalPixels(newPixels, w, h, getNumChannelsFromPixelFormat(format));
+	pixelFormat = format;
+}
+
 template<typename PixelType>
 void ofPixels_<PixelType>::setFromAlignedPixels(const PixelType * newPixels, int width, int height, int channels, int stride) {
 	if(width*channels==stride){
@@ -134,6 +194,7 @@ void ofPixels_<PixelType>::swap(ofPixels_<PixelType> & pix){
 	std::swap(width, pix.width);
 	std::swap(height,pix.height);
 	std::swap(channels,pix.channels);
+	std::swap(pixelFormat,pix.pixelFormat);
 	std::swap(pixelsOwner, pix.pixelsOwner);
 	std::swap(bAllocated, pix.bAllocated);
 }
@@ -155,7 +216,7 @@ void ofPixels_<PixelType>::allocate(int w, int h, int _channels){
 	}
 
 	//we check if we are already allocated at the right size
-	if(bAllocated && w == width && h == height && channels ==_channels){
+	if(bAllocated && w == width && h == height && channels ==_channels && !isPlanar(pixelFormat)){
 		return; //we don't need to allocate
 	}
 
@@ -163,6 +224,7 @@ void ofPixels_<PixelType>::allocate(int w, int h, int _channels){
 	clear();
 
 	channels = _channels;
+	pixelFormat = getPixelFormatFromChannels(channels);
 	width= w;
 	height = h;
 
@@ -177,6 +239,21 @@ void ofPixels_<PixelType>::allocate(int w, int h, ofPixelFormat format){
 
 	if (w < 0 || h < 0) return;
 
+	if(isPlanar(format)){
+		if(bAllocated && w == width && h == height && pixelFormat == format){
+			return;
+		}
+		clear();
+		channels = 1;
+		pixelFormat = format;
+		width = w;
+		height = h;
+		pixels = new PixelType[getPlanarSize(w,h)];
+		bAllocated = true;
+		pixelsOwner = true;
+		return;
+	}
+
 	ofImageType imgType;
 	switch(format){
 		case OF_PIXELS_RGB:
@@ -196,6 +273,7 @@ void ofPixels_<PixelType>::allocate(int w, int h, ofPixelFormat format){
 
 	}
 	allocate(w,h,imgType);
+	pixelFormat = format;
 }
 
 template<typename PixelType>
@@ -237,6 +315,7 @@ void ofPixels_<PixelType>::clear(){
 	width			= 0;
 	height			= 0;
 	channels		= 0;
+	pixelFormat		= OF_PIXELS_UNKNOWN;
 	bAllocated		= false;
 }
 
@@ -354,6 +433,10 @@ ofImageType ofPixels_<PixelType>::getImageType() const{
 template<typename PixelType>
 void ofPixels_<PixelType>::setImageType(ofImageType imageType){
 	if(!isAllocated() || imageType==getImageType()) return;
+	if(isPlanar(pixelFormat)){
+		ofLogError("ofPixels") << "setImageType(): can't change the type of planar pixels, convert them first";
+		return;
+	}
 	ofPixels_<PixelType> dst;
 	dst.allocate(width,height,imageType);
 	PixelType * dstPtr = &dst[0];
@@ -386,9 +469,64 @@ void ofPixels_<PixelType>::setNumChannels(int numChannels){
 
 template<typename PixelType>
 int ofPixels_<PixelType>::size() const{
+	if(isPlanar(pixelFormat)){
+		return getPlanarSize(width,height);
+	}
 	return width*height*channels;
 }
 
+template<typename PixelType>
+ofPixelFormat ofPixels_<PixelType>::getPixelFormat() const{
+	return pixelFormat;
+}
+
+template<typename PixelType>
+int ofPixels_<PixelType>::getNumPlanes() const{
+	switch(pixelFormat){
+	case OF_PIXELS_I420:
+		return 3;
+	case OF_PIXELS_NV12:
+		return 2;
+	default:
+		return 1;
+	}
+}
+
+template<typename PixelType>
+PixelType * ofPixels_<PixelType>::getPlane(int plane){
+	return const_cast<PixelType*>(static_cast<const ofPixels_<PixelType>*>(this)->getPlane(plane));
+}
+
+template<typename PixelType>
+const PixelType * ofPixels_<PixelType>::getPlane(int plane) const{
+	if(plane<=0 || plane>=getNumPlanes()){
+		return pixels;
+	}
+	const PixelType * chroma = pixels + width*height;
+	if(plane==2){
+		chroma += getPlaneStride(1) * getPlaneHeight(1);
+	}
+	return chroma;
+}
+
+template<typename PixelType>
+int ofPixels_<PixelType>::getPlaneStride(int plane) const{
+	if(plane<=0 || plane>=getNumPlanes()){
+		return width*channels;
+	}
+	// nv12 chroma has u and v interleaved in the same plane
+	int chromaWidth = (width+1)/2;
+	return pixelFormat==OF_PIXELS_NV12 ? chromaWidth*2 : chromaWidth;
+}
+
+template<typename PixelType>
+int ofPixels_<PixelType>::getPlaneHeight(int plane) const{
+	if(plane<=0 || plane>=getNumPlanes()){
+		return height;
+	}
+	return (height+1)/2;
+}
+
 template<typename PixelType>
 ofPixels_<PixelType> ofPixels_<PixelType>::getChannel(int channel) const{
 	ofPixels_<PixelType> channelPixels;
@@ -873,6 +1011,136 @@ bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, int xTo, int yTo
 	return true;
 }
 
+//----------------------------------------------------------------------
+// bt.601 video range in fixed point:
+// r = 1.164(y-16) + 1.596(v-128)
+// g = 1.164(y-16) - 0.391(u-128) - 0.813(v-128)
+// b = 1.164(y-16) + 2.018(u-128)
+static inline unsigned char clampToByte(int v){
+	return v<0 ? 0 : (v>255 ? 255 : v);
+}
+
+static inline void yuvToRgb(int y, int u, int v, unsigned char & r, unsigned char & g, unsigned char & b){
+	int c = 298*(y-16) + 128;
+	int d = u-128;
+	int e = v-128;
+	r = clampToByte((c + 409*e) >> 8);
+	g = clampToByte((c - 100*d - 208*e) >> 8);
+	b = clampToByte((c + 516*d) >> 8);
+}
+
+// converts one row, u and v are read every uvStep bytes and used for 2 pixels.
+// r, g and b are the offsets of each component in the destination pixels
+static void yuvRowToRgb(const unsigned char * y, const unsigned char * u, const unsigned char * v, int uvStep,
+						unsigned char * dst, int dstChannels, int r, int g, int b, int width){
+	int x = 0;
+#ifdef __SSE2__
+	// 8 pixels at a time. values are shifted 7 bits up so that multiplying
+	// with _mm_mulhi_epi16 by the coefficients * 512 gives the result in
+	// the low bits without overflowing 16 bits
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i offsetY = _mm_set1_epi16(16);
+	const __m128i offsetUV = _mm_set1_epi16(128);
+	const __m128i coefY = _mm_set1_epi16(596);
+	const __m128i coefRV = _mm_set1_epi16(818);
+	const __m128i coefGU = _mm_set1_epi16(200);
+	const __m128i coefGV = _mm_set1_epi16(416);
+	const __m128i coefBU = _mm_set1_epi16(1032);
+	unsigned char rgb[3][16];
+	for(; x+8<=width; x+=8){
+		__m128i y16 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(y+x)), zero);
+		__m128i u16, v16;
+		if(uvStep==1){
+			int u4, v4;
+			memcpy(&u4, u+x/2, 4);
+			memcpy(&v4, v+x/2, 4);
+			u16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), zero);
+			v16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v4), zero);
+			u16 = _mm_unpacklo_epi16(u16, u16);
+			v16 = _mm_unpacklo_epi16(v16, v16);
+		}else{
+			// interleaved uv, u is always before v
+			__m128i uv = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(u+x)), zero);
+			u16 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(2,2,0,0)), _MM_SHUFFLE(2,2,0,0));
+			v16 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(3,3,1,1)), _MM_SHUFFLE(3,3,1,1));
+		}
+		__m128i c = _mm_slli_epi16(_mm_sub_epi16(y16, offsetY), 7);
+		__m128i d = _mm_slli_epi16(_mm_sub_epi16(u16, offsetUV), 7);
+		__m128i e = _mm_slli_epi16(_mm_sub_epi16(v16, offsetUV), 7);
+		__m128i luma = _mm_mulhi_epi16(c, coefY);
+		__m128i r16 = _mm_add_epi16(luma, _mm_mulhi_epi16(e, coefRV));
+		__m128i g16 = _mm_sub_epi16(_mm_sub_epi16(luma, _mm_mulhi_epi16(d, coefGU)), _mm_mulhi_epi16(e, coefGV));
+		__m128i b16 = _mm_add_epi16(luma, _mm_mulhi_epi16(d, coefBU));
+		_mm_storel_epi64((__m128i*)rgb[0], _mm_packus_epi16(r16, zero));
+		_mm_storel_epi64((__m128i*)rgb[1], _mm_packus_epi16(g16, zero));
+		_mm_storel_epi64((__m128i*)rgb[2], _mm_packus_epi16(b16, zero));
+		unsigned char * out = dst + x*dstChannels;
+		for(int i=0; i<8; i++, out+=dstChannels){
+			out[r] = rgb[0][i];
+			out[g] = rgb[1][i];
+			out[b] = rgb[2][i];
+		}
+	}
+#endif
+	for(; x<width; x++){
+		unsigned char * out = dst + x*dstChannels;
+		yuvToRgb(y[x], u[(x/2)*uvStep], v[(x/2)*uvStep], out[r], out[g], out[b]);
+	}
+}
+
+bool ofConvertYuvToRgb(const ofPixels & yuv, ofPixels & dst, ofPixelFormat dstFormat){
+	if(yuv.getPixelFormat()!=OF_PIXELS_I420 && yuv.getPixelFormat()!=OF_PIXELS_NV12){
+		ofLogError("ofPixels") << "ofConvertYuvToRgb(): source pixels are not OF_PIXELS_I420 or OF_PIXELS_NV12";
+		return false;
+	}
+	int r, g, b;
+	switch(dstFormat){
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_RGBA:
+		r = 0; g = 1; b = 2;
+		break;
+	case OF_PIXELS_BGRA:
+		r = 2; g = 1; b = 0;
+		break;
+	default:
+		ofLogError("ofPixels") << "ofConvertYuvToRgb(): destination format " << dstFormat << " not supported";
+		return false;
+	}
+
+	int width = yuv.getWidth();
+	int height = yuv.getHeight();
+	dst.allocate(width, height, dstFormat);
+	if(dstFormat!=OF_PIXELS_RGB){
+		dst.set(3, 255);
+	}
+
+	const unsigned char * planeY = yuv.getPlane(0);
+	const unsigned char * planeU = yuv.getPlane(1);
+	const unsigned char * planeV;
+	int uvStep;
+	if(yuv.getPixelFormat()==OF_PIXELS_NV12){
+		planeV = planeU + 1;
+		uvStep = 2;
+	}else{
+		planeV = yuv.getPlane(2);
+		uvStep = 1;
+	}
+	int strideY = yuv.getPlaneStride(0);
+	int strideUV = yuv.getPlaneStride(1);
+	int dstChannels = dst.getNumChannels();
+	int dstStride = width * dstChannels;
+	unsigned char * dstPixels = dst.getPixels();
+
+	for(int row=0; row<height; row++){
+		int chromaRow = row/2;
+		yuvRowToRgb(planeY + row*strideY,
+					planeU + chromaRow*strideUV,
+					planeV + chromaRow*strideUV,
+					uvStep, dstPixels + row*dstStride, dstChannels, r, g, b, width);
+	}
+	return true;
+}
+
 template class ofPixels_<char>;
 template class ofPixels_<unsigned char>;
 template class ofPixels_<short>;
@@ -38,6 +38,7 @@ public:
 	void setFromPixels(const PixelType * newPixels, int w, int h, int channels);
 	void setFromPixels(const PixelType * newPixels, int w, int h, ofImageType type);
 	void setFromExternalPixels(PixelType * newPixels, int w, int h, int channels);
+	void setFromExternalPixels(PixelType * newPixels, int w, int h, ofPixelFormat format);
 	void setFromAlignedPixels(const PixelType * newPixels, int width, int height, int channels, int stride);
 	void swap(ofPixels_<PixelType> & pix);
 
@@ -84,6 +85,17 @@ public:
 	int getBitsPerChannel() const;
 	int getNumChannels() const;
 
+	// planar formats (OF_PIXELS_I420, OF_PIXELS_NV12) store the full
+	// resolution luma plane first followed by the chroma planes at half
+	// resolution. for them getNumChannels() is 1 and most of the methods
+	// above only see the luma plane. packed formats have only 1 plane
+	ofPixelFormat getPixelFormat() const;
+	int getNumPlanes() const;
+	PixelType * getPlane(int plane);
+	const PixelType * getPlane(int plane) const;
+	int getPlaneStride(int plane) const;	// in elements per row
+	int getPlaneHeight(int plane) const;
+
 	ofPixels_<PixelType> getChannel(int channel) const;
 	void setChannel(int channel, const ofPixels_<PixelType> channelPixels);
 
@@ -106,6 +118,7 @@ private:
 	int 	height;
 
 	int 	channels; // 1, 3, 4 channels per pixel (grayscale, rgb, rgba)
+	ofPixelFormat pixelFormat;
 	bool	bAllocated;
 	bool	pixelsOwner;			// if set from external data don't delete it
 
@@ -121,6 +134,11 @@ typedef ofPixels& ofPixelsRef;
 typedef ofFloatPixels& ofFloatPixelsRef;
 typedef ofShortPixels& ofShortPixelsRef;
 
+// converts OF_PIXELS_I420 or OF_PIXELS_NV12 pixels using bt.601 video
+// range coefficients to OF_PIXELS_RGB, OF_PIXELS_RGBA or OF_PIXELS_BGRA,
+// allocating dst if needed. uses SSE2 when the compiler has it enabled
+bool ofConvertYuvToRgb(const ofPixels & yuv, ofPixels & dst, ofPixelFormat dstFormat=OF_PIXELS_RGB);
+
 // sorry for these ones, being templated functions inside a template i needed to do it in the .h
 // they allow to do things like:
 //
@@ -134,6 +152,7 @@ ofPixels_<PixelType>::ofPixels_(const ofPixels_<SrcType> & mom){
 	bAllocated = false;
 	pixelsOwner = false;
 	channels = 0;
+	pixelFormat = OF_PIXELS_UNKNOWN;
 	pixels = NULL;
 	width = 0;
 	height = 0;
@@ -151,7 +170,12 @@ template<typename PixelType>
 template<typename SrcType>
 void ofPixels_<PixelType>::copyFrom(const ofPixels_<SrcType> & mom){
 	if(mom.isAllocated()){
-		allocate(mom.getWidth(),mom.getHeight(),mom.getNumChannels());
+		if(mom.getNumPlanes()>1){
+			allocate(mom.getWidth(),mom.getHeight(),mom.getPixelFormat());
+		}else{
+			allocate(mom.getWidth(),mom.getHeight(),mom.getNumChannels());
+			pixelFormat = mom.getPixelFormat();
+		}
 
 		const float srcMax = ( (sizeof(SrcType) == sizeof(float) ) ? 1.f : numeric_limits<SrcType>::max() );
 		const float dstMax = ( (sizeof(PixelType) == sizeof(float) ) ? 1.f : numeric_limits<PixelType>::max() );
@@ -0,0 +1,107 @@
+#include "ofTextLayout.h"
+#include "ofTrueTypeFont.h"
+
+//----------------------------------------------------------
+ofTextLayout::ofTextLayout()
+:font(NULL)
+,version(0)
+,bVFlipped(true)
+,bNeedsUpdate(true)
+,bBoundingBoxNeedsUpdate(true){
+}
+
+//----------------------------------------------------------
+ofTextLayout::ofTextLayout(ofTrueTypeFont & font, const string & text)
+:font(NULL)
+,version(0)
+,bVFlipped(true)
+,bNeedsUpdate(true)
+,bBoundingBoxNeedsUpdate(true){
+	setup(font,text);
+}
+
+//----------------------------------------------------------
+void ofTextLayout::setup(ofTrueTypeFont & _font, const string & _text){
+	font = &_font;
+	text = _text;
+	bNeedsUpdate = true;
+	bBoundingBoxNeedsUpdate = true;
+}
+
+//----------------------------------------------------------
+void ofTextLayout::setText(const string & _text){
+	if(text==_text) return;
+	text = _text;
+	bNeedsUpdate = true;
+	bBoundingBoxNeedsUpdate = true;
+}
+
+//----------------------------------------------------------
+const string & ofTextLayout::getText() const{
+	return text;
+}
+
+//----------------------------------------------------------
+ofTrueTypeFont * ofTextLayout::getFont(){
+	return font;
+}
+
+//----------------------------------------------------------
+void ofTextLayout::draw(float x, float y){
+	if(!font){
+		ofLogError("ofTextLayout") << "draw(): no font, call setup() first";
+		return;
+	}
+	font->drawLayout(*this,x,y);
+}
+
+//----------------------------------------------------------
+ofRectangle ofTextLayout::getBoundingBox(float x, float y){
+	if(!font || !font->updateLayout(*this)) return ofRectangle();
+	if(bBoundingBoxNeedsUpdate){
+		boundingBox = font->computeStringBoundingBox(text,0,0);
+		bBoundingBoxNeedsUpdate = false;
+	}
+	return ofRectangle(boundingBox.x + x, boundingBox.y + y, boundingBox.width, boundingBox.height);
+}
+
+//----------------------------------------------------------
+float ofTextLayout::getWidth(){
+	return getBoundingBox().width;
+}
+
+//----------------------------------------------------------
+float ofTextLayout::getHeight(){
+	return getBoundingBox().height;
+}
+
+//----------------------------------------------------------
+int ofTextLayout::getNumMeshes(){
+	if(font) font->updateLayout(*this);
+	return meshes.size();
+}
+
+//----------------------------------------------------------
+ofMesh & ofTextLayout::getMesh(int i){
+	return meshes[i];
+}
+
+//----------------------------------------------------------
+ofTexture & ofTextLayout::getTexture(int i){
+	if(font->getUsingDynamicGlyphs()){
+		return font->getGlyphPageTexture(pages[i]);
+	}else{
+		return font->getFontTexture();
+	}
+}
+
+//----------------------------------------------------------
+ofMesh & ofTextLayout::getMeshForPage(int page){
+	for(int i=0;i<(int)pages.size();i++){
+		if(pages[i]==page) return meshes[i];
+	}
+	pages.push_back(page);
+	meshes.push_back(ofMesh());
+	meshes.back().setMode(OF_PRIMITIVE_TRIANGLES);
+	return meshes.back();
+}
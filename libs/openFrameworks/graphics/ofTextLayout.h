@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofMesh.h"
+#include "ofRectangle.h"
+
+class ofTrueTypeFont;
+class ofTexture;
+
+// the quads of a string laid out with a font, cached so drawing the same
+// string again doesn't need to decode it and look up every glyph, it only
+// submits the quads. useful for labels that don't change every frame
+//
+// ofTextLayout label(font,"some text");
+// ...
+// label.draw(x,y);
+//
+// Info:
+// the layout is rebuilt automatically when the text changes or the font
+// changes in a way that affects it (line height, letter spacing, reload...)
+// the font has to outlive the layouts that use it
+// drawString() already keeps layouts of the last strings drawn, see
+// ofTrueTypeFont::setLayoutCacheSize()
+
+class ofTextLayout {
+public:
+	ofTextLayout();
+	ofTextLayout(ofTrueTypeFont & font, const string & text);
+
+	void setup(ofTrueTypeFont & font, const string & text);
+	void setText(const string & text);
+	const string & getText() const;
+	ofTrueTypeFont * getFont();
+
+	void draw(float x, float y);
+
+	ofRectangle getBoundingBox(float x=0, float y=0);
+	float getWidth();
+	float getHeight();
+
+	// the quads are laid out at 0,0, one mesh per texture. fonts with
+	// dynamic glyphs can spread a string over several glyph pages
+	int getNumMeshes();
+	ofMesh & getMesh(int i);
+	ofTexture & getTexture(int i);
+
+private:
+	friend class ofTrueTypeFont;
+
+	ofMesh & getMeshForPage(int page);
+
+	ofTrueTypeFont * font;
+	string text;
+	vector<ofMesh> meshes;
+	vector<int> pages;				// glyph page of every mesh, 0 without dynamic glyphs
+	ofRectangle boundingBox;
+	unsigned int version;			// font layout version the quads were built with
+	bool bVFlipped;
+	bool bNeedsUpdate;
+	bool bBoundingBoxNeedsUpdate;
+};
@@ -12,14 +12,18 @@
 #endif
 
 #include <algorithm>
+#include <map>
 
 #include "ofUtils.h"
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
+#include "ofShader.h"
+#include "ofGLUtils.h"
 #include "Poco/TextConverter.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Latin1Encoding.h"
 #include "Poco/Latin9Encoding.h"
+#include "Poco/TextIterator.h"
 
 static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
@@ -196,6 +200,318 @@ bool compare_cps(const charProps & c1, const charProps & c2){
 	else return c1.tH > c2.tH;
 }
 
+//--------------------------------------------------------
+static void setCharProps(charProps & props, FT_GlyphSlot glyph, int character, int fontSize){
+	props.character		= character;
+	props.height		= glyph->bitmap_top;
+	props.width			= glyph->bitmap.width;
+	props.setWidth		= glyph->advance.x >> 6;
+	props.topExtent		= glyph->bitmap.rows;
+	props.leftExtent	= glyph->bitmap_left;
+
+	props.tW			= props.width;
+	props.tH			= glyph->bitmap.rows;
+
+	GLint fheight	= props.height;
+	GLint bwidth	= props.width;
+	GLint top		= props.topExtent - props.height;
+	GLint lextent	= props.leftExtent;
+
+	GLfloat	corr, stretch;
+
+	//this accounts for the fact that we are showing 2*visibleBorder extra pixels
+	//so we make the size of each char that many pixels bigger
+	stretch = 0;//(float)(visibleBorder * 2);
+
+	corr	= (float)(( (fontSize - fheight) + top) - fontSize);
+
+	props.x1		= lextent + bwidth + stretch;
+	props.y1		= fheight + corr + stretch;
+	props.x2		= (float) lextent;
+	props.y2		= -top + corr;
+}
+
+//--------------------------------------------------------
+// copies the coverage of a rendered glyph into a 1 channel image at x,y
+static void copyGlyphBitmap(const FT_Bitmap & bitmap, bool bAntiAliased, ofPixels & alpha, int x, int y){
+	const unsigned char * src = bitmap.buffer;
+	for(int j=0; j<bitmap.rows; j++){
+		unsigned char * dst = alpha.getPixels() + (y+j)*alpha.getWidth() + x;
+		if(bAntiAliased){
+			memcpy(dst,src,bitmap.width);
+		}else{
+			// true type packs monochrome info in a
+			// 1-bit format, here we unpack it:
+			for(int k=0; k<bitmap.width; k++){
+				dst[k] = src[k>>3] & (0x80>>(k&7)) ? 255 : 0;
+			}
+		}
+		src += bitmap.pitch;
+	}
+}
+
+//--------------------------------------------------------
+// the font textures are white with the glyphs in the alpha channel so
+// they get the current color, this expands a region of the glyphs
+// coverage in one pass
+static void expandGlyphAlpha(const ofPixels & alpha, int x, int y, int w, int h, ofPixels & rgba){
+	rgba.allocate(w,h,4);
+	unsigned char * dst = rgba.getPixels();
+	for(int j=0; j<h; j++){
+		const unsigned char * src = alpha.getPixels() + (y+j)*alpha.getWidth() + x;
+		for(int i=0; i<w; i++){
+			dst[0] = 255;
+			dst[1] = 255;
+			dst[2] = 255;
+			dst[3] = src[i];
+			dst += 4;
+		}
+	}
+}
+
+//--------------------------------------------------------
+// exact euclidean distance transform of a sampled function in 1d, from
+// "Distance Transforms of Sampled Functions", Felzenszwalb & Huttenlocher
+#define DISTANCE_FIELD_INF 1e20f
+static void distanceTransform1D(const float * f, int n, float * d, int * v, float * z){
+	int k = 0;
+	v[0] = 0;
+	z[0] = -DISTANCE_FIELD_INF;
+	z[1] = DISTANCE_FIELD_INF;
+	for(int q=1; q<n; q++){
+		float s = ((f[q] + q*q) - (f[v[k]] + v[k]*v[k])) / (2*q - 2*v[k]);
+		while(s <= z[k]){
+			k--;
+			s = ((f[q] + q*q) - (f[v[k]] + v[k]*v[k])) / (2*q - 2*v[k]);
+		}
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k+1] = DISTANCE_FIELD_INF;
+	}
+	k = 0;
+	for(int q=0; q<n; q++){
+		while(z[k+1] < q) k++;
+		d[q] = (q - v[k])*(q - v[k]) + f[v[k]];
+	}
+}
+
+//--------------------------------------------------------
+// squared distance of every pixel to the closest pixel with value 0
+static void distanceTransform2D(vector<float> & grid, int w, int h){
+	int n = max(w,h);
+	vector<float> f(n), d(n), z(n+1);
+	vector<int> v(n);
+	for(int x=0; x<w; x++){
+		for(int y=0; y<h; y++) f[y] = grid[y*w + x];
+		distanceTransform1D(&f[0], h, &d[0], &v[0], &z[0]);
+		for(int y=0; y<h; y++) grid[y*w + x] = d[y];
+	}
+	for(int y=0; y<h; y++){
+		distanceTransform1D(&grid[y*w], w, &d[0], &v[0], &z[0]);
+		memcpy(&grid[y*w], &d[0], w*sizeof(float));
+	}
+}
+
+//--------------------------------------------------------
+void ofComputeDistanceField(const ofPixels & coverage, ofPixels & distanceField, int spread){
+	if(coverage.getNumChannels()!=1){
+		ofLogError("ofTrueTypeFont") << "ofComputeDistanceField(): coverage needs 1 channel, it has " << coverage.getNumChannels();
+		return;
+	}
+	int w = coverage.getWidth();
+	int h = coverage.getHeight();
+	spread = max(spread,1);
+
+	// distance from every pixel outside the shape to the closest inside
+	// and from every pixel inside to the closest outside
+	const unsigned char * src = coverage.getPixels();
+	vector<float> toInside(w*h), toOutside(w*h);
+	for(int i=0; i<w*h; i++){
+		bool inside = src[i] >= 128;
+		toInside[i] = inside ? 0 : DISTANCE_FIELD_INF;
+		toOutside[i] = inside ? DISTANCE_FIELD_INF : 0;
+	}
+	distanceTransform2D(toInside, w, h);
+	distanceTransform2D(toOutside, w, h);
+
+	// the outline is between pixel centers, pixels with partial coverage
+	// give a better estimate of where it is inside them
+	distanceField.allocate(w, h, 1);
+	unsigned char * dst = distanceField.getPixels();
+	for(int i=0; i<w*h; i++){
+		float distance;
+		if(src[i]>0 && src[i]<255){
+			distance = src[i]/255.f - 0.5f;
+		}else if(src[i]>=128){
+			distance = sqrtf(toOutside[i]) - 0.5f;
+		}else{
+			distance = 0.5f - sqrtf(toInside[i]);
+		}
+		float value = 127.5f + distance * 127.5f / spread;
+		dst[i] = value<0 ? 0 : (value>255 ? 255 : value);
+	}
+}
+
+//--------------------------------------------------------
+// the pixels a glyph is stored with in the atlas. with distance fields
+// the glyph is padded with spread pixels and the quad grows to cover them
+static void getGlyphPixels(const FT_Bitmap & bitmap, bool bAntiAliased, int spread, charProps & props, ofPixels & pixels){
+	if(spread<=0 || bitmap.width==0 || bitmap.rows==0){
+		pixels.allocate(bitmap.width, bitmap.rows, 1);
+		copyGlyphBitmap(bitmap, bAntiAliased, pixels, 0, 0);
+		return;
+	}
+
+	ofPixels coverage;
+	coverage.allocate(bitmap.width + spread*2, bitmap.rows + spread*2, 1);
+	coverage.set(0);
+	copyGlyphBitmap(bitmap, bAntiAliased, coverage, spread, spread);
+	ofComputeDistanceField(coverage, pixels, spread);
+
+	props.tW += spread*2;
+	props.tH += spread*2;
+	props.x1 += spread;
+	props.x2 -= spread;
+	props.y1 += spread;
+	props.y2 -= spread;
+}
+
+//--------------------------------------------------------
+#define STRINGIFY(x) #x
+
+#ifdef TARGET_OPENGLES
+static string distanceFieldVertexShader = STRINGIFY(
+	precision highp float;
+
+	uniform mat4 modelViewProjectionMatrix;
+	uniform mat4 textureMatrix;
+
+	attribute vec4 position;
+	attribute vec2 texcoord;
+
+	varying vec2 texCoordVarying;
+
+	void main(){
+		texCoordVarying = (textureMatrix*vec4(texcoord.x,texcoord.y,0,1)).xy;
+		gl_Position = modelViewProjectionMatrix * position;
+	}
+);
+
+static string distanceFieldFragmentShader = "#extension GL_OES_standard_derivatives : enable\n" STRINGIFY(
+	precision highp float;
+
+	uniform sampler2D src_tex_unit0;
+	uniform vec4 globalColor;
+
+	varying vec2 texCoordVarying;
+
+	void main(){
+		float distance = texture2D(src_tex_unit0, texCoordVarying).a;
+		float width = fwidth(distance) * 0.7;
+		float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+		gl_FragColor = vec4(globalColor.rgb, globalColor.a * alpha);
+	}
+);
+#else
+static string distanceFieldVertexShader = "#version 120\n" STRINGIFY(
+	varying vec2 texCoordVarying;
+
+	void main(){
+		texCoordVarying = (gl_TextureMatrix[0] * gl_MultiTexCoord0).xy;
+		gl_FrontColor = gl_Color;
+		gl_Position = ftransform();
+	}
+);
+
+static string distanceFieldFragmentShader = "#version 120\n" STRINGIFY(
+	uniform sampler2D src_tex_unit0;
+
+	varying vec2 texCoordVarying;
+
+	void main(){
+		float distance = texture2D(src_tex_unit0, texCoordVarying).a;
+		float width = fwidth(distance) * 0.7;
+		float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+		gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);
+	}
+);
+
+static string distanceFieldVertexShaderGL3 = "#version 150\n" STRINGIFY(
+	uniform mat4 modelViewProjectionMatrix;
+	uniform mat4 textureMatrix;
+
+	in vec4 position;
+	in vec2 texcoord;
+
+	out vec2 texCoordVarying;
+
+	void main(){
+		texCoordVarying = (textureMatrix*vec4(texcoord.x,texcoord.y,0,1)).xy;
+		gl_Position = modelViewProjectionMatrix * position;
+	}
+);
+
+static string distanceFieldFragmentShaderGL3 = "#version 150\n" STRINGIFY(
+	uniform sampler2D src_tex_unit0;
+	uniform vec4 globalColor;
+
+	in vec2 texCoordVarying;
+
+	out vec4 fragColor;
+
+	void main(){
+		float distance = texture(src_tex_unit0, texCoordVarying).a;
+		float width = fwidth(distance) * 0.7;
+		float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+		fragColor = vec4(globalColor.rgb, globalColor.a * alpha);
+	}
+);
+#endif
+
+//--------------------------------------------------------
+// finds the outline in the distance field with antialiasing as wide as
+// a screen pixel, whatever the scale the font is drawn at
+static ofShader & distanceFieldShader(){
+	static ofShader * shader = new ofShader;
+	static bool bSetup = false;
+	if(!bSetup){
+		bSetup = true;
+#ifndef TARGET_OPENGLES
+		if(!ofIsGLProgrammableRenderer()){
+			shader->setupShaderFromSource(GL_VERTEX_SHADER, distanceFieldVertexShader);
+			shader->setupShaderFromSource(GL_FRAGMENT_SHADER, distanceFieldFragmentShader);
+		}else{
+			shader->setupShaderFromSource(GL_VERTEX_SHADER, distanceFieldVertexShaderGL3);
+			shader->setupShaderFromSource(GL_FRAGMENT_SHADER, distanceFieldFragmentShaderGL3);
+			shader->bindDefaults();
+		}
+#else
+		shader->setupShaderFromSource(GL_VERTEX_SHADER, distanceFieldVertexShader);
+		shader->setupShaderFromSource(GL_FRAGMENT_SHADER, distanceFieldFragmentShader);
+		shader->bindDefaults();
+#endif
+		shader->linkProgram();
+	}
+	return *shader;
+}
+
+//--------------------------------------------------------
+static void makeContours(FT_Face & face, float simplifyAmt, ofTTFCharacter & outline, ofTTFCharacter & outlineNonVFlipped){
+	outline = makeContoursForCharacter( face );
+
+	outlineNonVFlipped = outline;
+	outlineNonVFlipped.scale(1,-1);
+
+	if(simplifyAmt>0)
+		outline.simplify(simplifyAmt);
+	outline.getTessellation();
+
+	if(simplifyAmt>0)
+		outlineNonVFlipped.simplify(simplifyAmt);
+	outlineNonVFlipped.getTessellation();
+}
+
 
 #ifdef TARGET_OSX
 static string osxFontPathByName( string fontname ){
@@ -362,9 +678,109 @@ void ofTrueTypeFont::finishLibraries(){
 		//FcFini();
 #endif
 		FT_Done_FreeType(library);
+		librariesInitialized = false;
 	}
 }
 
+//------------------------------------------------------------------
+struct ofTrueTypeFont::Glyph{
+	charProps props;
+	int page;					// -1 if the glyph has no pixels
+	ofTTFCharacter outline;
+	ofTTFCharacter outlineNonVFlipped;
+};
+
+struct ofTrueTypeFont::GlyphPage{
+	struct Shelf{
+		int y;
+		int height;
+		int x;
+	};
+
+	ofTexture texture;
+	ofPixels pixels;			// coverage of the glyphs, expanded to white + alpha on upload
+	ofMesh quads;				// quads using this page while the font is binded
+	vector<Shelf> shelves;
+	vector<int> characters;		// glyphs in the page, removed when it's evicted
+	int size;
+	int dirtyX0, dirtyY0, dirtyX1, dirtyY1;
+	unsigned int lastUsed;
+
+	void setDirty(int x, int y, int w, int h){
+		dirtyX0 = min(dirtyX0,x);
+		dirtyY0 = min(dirtyY0,y);
+		dirtyX1 = max(dirtyX1,x+w);
+		dirtyY1 = max(dirtyY1,y+h);
+	}
+
+	void clearDirty(){
+		dirtyX0 = size;
+		dirtyY0 = size;
+		dirtyX1 = 0;
+		dirtyY1 = 0;
+	}
+
+	bool isDirty(){
+		return dirtyX1>dirtyX0 && dirtyY1>dirtyY0;
+	}
+
+	// shelf packing: glyphs are placed left to right in rows with the
+	// height of the first glyph that opened them, a glyph goes to the
+	// lowest shelf it fits in unless it would waste too much of its height
+	bool pack(int w, int h, int & x, int & y){
+		if(w>size || h>size) return false;
+		int best = -1;
+		for(int i=0;i<(int)shelves.size();i++){
+			if(shelves[i].height>=h && shelves[i].x+w<=size && (best==-1 || shelves[i].height<shelves[best].height)){
+				best = i;
+			}
+		}
+		int top = shelves.empty() ? 0 : shelves.back().y + shelves.back().height;
+		bool canOpenShelf = top + h <= size;
+		if(best==-1 || (shelves[best].height > h + h/2 && canOpenShelf)){
+			if(!canOpenShelf) return false;
+			Shelf shelf;
+			shelf.y = top;
+			shelf.height = h;
+			shelf.x = 0;
+			shelves.push_back(shelf);
+			best = shelves.size()-1;
+		}
+		x = shelves[best].x;
+		y = shelves[best].y;
+		shelves[best].x += w;
+		return true;
+	}
+
+	int getMemory(){
+		// rgba texture + 1 channel cpu copy
+		return size*size*5;
+	}
+};
+
+class ofTrueTypeFont::GlyphAtlas{
+public:
+	GlyphAtlas(FT_Face face)
+	:face(face)
+	,useCount(0)
+	,bWarnedMemory(false){}
+
+	~GlyphAtlas(){
+		// the faces are destroyed with the library when the app exits
+		if(librariesInitialized){
+			FT_Done_Face(face);
+		}
+	}
+
+	FT_Face face;
+	map<int,Glyph> glyphs;
+	vector<ofPtr<GlyphPage> > pages;
+	ofPixels uploadPixels;
+	ofPixels glyphPixels;
+	unsigned int useCount;		// increased for every string, pages used in the current one are not evicted
+	bool bWarnedMemory;
+};
+
 
 //------------------------------------------------------------------
 ofTrueTypeFont::ofTrueTypeFont(){
@@ -385,6 +801,17 @@ ofTrueTypeFont::ofTrueTypeFont(){
 	//visibleBorder	= 2;
 	stringQuads.setMode(OF_PRIMITIVE_TRIANGLES);
 	binded = false;
+
+	bDynamicGlyphs	= false;
+	glyphPageSize	= 512;
+	maxGlyphMemory	= 16*1024*1024;
+	encoding		= OF_ENCODING_UTF8;
+
+	bDistanceField	= false;
+	distanceFieldSpread = 6;
+
+	layoutVersion	= 1;
+	layoutCacheSize	= 256;
 }
 
 //------------------------------------------------------------------
@@ -403,6 +830,8 @@ void ofTrueTypeFont::unloadTextures(){
 	if(!bLoadedOk) return;
 
 	texAtlas.clear();
+	atlas.reset();
+	layoutVersion++;
 	bLoadedOk = false;
 }
 
@@ -467,6 +896,8 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 		// we've already been loaded, try to clean up :
 		unloadTextures();
 	}
+	clearLayoutCache();
+	layoutVersion++;
 	//------------------------------------------------
 
 	if( _dpi == 0 ){
@@ -495,6 +926,18 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 	FT_Set_Char_Size( face, fontSize << 6, fontSize << 6, dpi, dpi);
 	lineHeight = fontSize * 1.43f;
 
+	//--------------- with dynamic glyphs the face is kept open
+	// and the glyphs are loaded as they are used
+	if(bDynamicGlyphs){
+		nCharacters = 0;
+		cps.clear();
+		charOutlines.clear();
+		charOutlinesNonVFlipped.clear();
+		atlas = ofPtr<GlyphAtlas>(new GlyphAtlas(face));
+		bLoadedOk = true;
+		return true;
+	}
+
 	//------------------------------------------------------
 	//kerning would be great to support:
 	//ofLogNotice("ofTrueTypeFont") << "FT_HAS_KERNING ? " <<  FT_HAS_KERNING(face);
@@ -555,94 +998,16 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 			}
 
 			//int character = i + NUM_CHARACTER_TO_START;
-			charOutlines[i] = makeContoursForCharacter( face );
-
-			charOutlinesNonVFlipped[i] = charOutlines[i];
-			charOutlinesNonVFlipped[i].translate(ofVec3f(0,cps[i].height));
-			charOutlinesNonVFlipped[i].scale(1,-1);
-
-
-			if(simplifyAmt>0)
-				charOutlines[i].simplify(simplifyAmt);
-			charOutlines[i].getTessellation();
-
-			if(simplifyAmt>0)
-				charOutlinesNonVFlipped[i].simplify(simplifyAmt);
-			charOutlinesNonVFlipped[i].getTessellation();
+			makeContours(face, simplifyAmt, charOutlines[i], charOutlinesNonVFlipped[i]);
 		}
 
 
 		// -------------------------
 		// info about the character:
-		cps[i].character		= i;
-		cps[i].height 			= face->glyph->bitmap_top;
-		cps[i].width 			= face->glyph->bitmap.width;
-		cps[i].setWidth 		= face->glyph->advance.x >> 6;
-		cps[i].topExtent 		= face->glyph->bitmap.rows;
-		cps[i].leftExtent		= face->glyph->bitmap_left;
-
-		int width  = cps[i].width;
-		int height = bitmap.rows;
-
-
-		cps[i].tW				= width;
-		cps[i].tH				= height;
-
-
-
-		GLint fheight	= cps[i].height;
-		GLint bwidth	= cps[i].width;
-		GLint top		= cps[i].topExtent - cps[i].height;
-		GLint lextent	= cps[i].leftExtent;
-
-		GLfloat	corr, stretch;
-
-		//this accounts for the fact that we are showing 2*visibleBorder extra pixels
-		//so we make the size of each char that many pixels bigger
-		stretch = 0;//(float)(visibleBorder * 2);
-
-		corr	= (float)(( (fontSize - fheight) + top) - fontSize);
-
-		cps[i].x1		= lextent + bwidth + stretch;
-		cps[i].y1		= fheight + corr + stretch;
-		cps[i].x2		= (float) lextent;
-		cps[i].y2		= -top + corr;
-
+		setCharProps(cps[i], face->glyph, i, fontSize);
 
 		// Allocate Memory For The Texture Data.
-		expanded_data[i].allocate(width, height, 2);
-		//-------------------------------- clear data:
-		expanded_data[i].set(0,255); // every luminance pixel = 255
-		expanded_data[i].set(1,0);
-
-
-		if (bAntiAliased == true){
-			ofPixels bitmapPixels;
-			bitmapPixels.setFromExternalPixels(bitmap.buffer,bitmap.width,bitmap.rows,1);
-			expanded_data[i].setChannel(1,bitmapPixels);
-		} else {
-			//-----------------------------------
-			// true type packs monochrome info in a
-			// 1-bit format, hella funky
-			// here we unpack it:
-			unsigned char *src =  bitmap.buffer;
-			for(int j=0; j <bitmap.rows;j++) {
-				unsigned char b=0;
-				unsigned char *bptr =  src;
-				for(int k=0; k < bitmap.width ; k++){
-					expanded_data[i][2*(k+j*width)] = 255;
-
-					if (k%8==0){
-						b = (*bptr++);
-					}
-
-					expanded_data[i][2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
-					b <<= 1;
-				}
-				src += bitmap.pitch;
-			}
-			//-----------------------------------
-		}
+		getGlyphPixels(bitmap, bAntiAliased, bDistanceField ? distanceFieldSpread : 0, cps[i], expanded_data[i]);
 
 		areaSum += (cps[i].width+border*2)*(cps[i].height+border*2);
 	}
@@ -684,10 +1049,9 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 
 
 
-	ofPixels atlasPixelsLuminanceAlpha;
-	atlasPixelsLuminanceAlpha.allocate(w,h,2);
-	atlasPixelsLuminanceAlpha.set(0,255);
-	atlasPixelsLuminanceAlpha.set(1,0);
+	ofPixels atlasPixelsAlpha;
+	atlasPixelsAlpha.allocate(w,h,1);
+	atlasPixelsAlpha.set(0);
 
 
 	int x=0;
@@ -706,23 +1070,15 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 		cps[sortedCopy[i].character].v2		= float(y + border)/float(h);
 		cps[sortedCopy[i].character].t1		= float(cps[sortedCopy[i].character].tW + x + border)/float(w);
 		cps[sortedCopy[i].character].v1		= float(cps[sortedCopy[i].character].tH + y + border)/float(h);
-		charPixels.pasteInto(atlasPixelsLuminanceAlpha,x+border,y+border);
+		charPixels.pasteInto(atlasPixelsAlpha,x+border,y+border);
 		x+= sortedCopy[i].tW + border*2;
 	}
 
 	ofPixels atlasPixels;
-	atlasPixels.allocate(atlasPixelsLuminanceAlpha.getWidth(),atlasPixelsLuminanceAlpha.getHeight(),4);
-	atlasPixels.setChannel(0,atlasPixelsLuminanceAlpha.getChannel(0));
-	atlasPixels.setChannel(1,atlasPixelsLuminanceAlpha.getChannel(0));
-	atlasPixels.setChannel(2,atlasPixelsLuminanceAlpha.getChannel(0));
-	atlasPixels.setChannel(3,atlasPixelsLuminanceAlpha.getChannel(1));
+	expandGlyphAlpha(atlasPixelsAlpha,0,0,w,h,atlasPixels);
 	texAtlas.allocate(atlasPixels,false);
 
-	if(bAntiAliased && fontSize>20){
-		texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
-	}else{
-		texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
-	}
+	setTextureFilter(texAtlas);
 	texAtlas.loadData(atlasPixels);
 
 	// ------------- close the library and typeface
@@ -737,6 +1093,290 @@ ofTextEncoding ofTrueTypeFont::getEncoding() const {
 
 void ofTrueTypeFont::setEncoding(ofTextEncoding _encoding) {
 	encoding = _encoding;
+	layoutVersion++;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::enableDynamicGlyphs(){
+	if(bDynamicGlyphs) return;
+	bDynamicGlyphs = true;
+	if(bLoadedOk) reloadTextures();
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::disableDynamicGlyphs(){
+	if(!bDynamicGlyphs) return;
+	bDynamicGlyphs = false;
+	if(bLoadedOk) reloadTextures();
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::getUsingDynamicGlyphs(){
+	return bDynamicGlyphs;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setGlyphPageSize(int pageSize){
+	// pages that already exist keep their size
+	glyphPageSize = max(pageSize,64);
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getGlyphPageSize(){
+	return glyphPageSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setMaxGlyphMemory(int bytes){
+	maxGlyphMemory = bytes;
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getMaxGlyphMemory(){
+	return maxGlyphMemory;
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getGlyphMemory(){
+	int memory = 0;
+	if(atlas){
+		for(int i=0;i<(int)atlas->pages.size();i++){
+			memory += atlas->pages[i]->getMemory();
+		}
+	}
+	return memory;
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getNumGlyphPages(){
+	return atlas ? atlas->pages.size() : 0;
+}
+
+//-----------------------------------------------------------
+ofTexture & ofTrueTypeFont::getGlyphPageTexture(int page){
+	if(!atlas || page<0 || page>=(int)atlas->pages.size()){
+		ofLogError("ofTrueTypeFont") << "getGlyphPageTexture(): page " << page << " doesn't exist";
+		return texAtlas;
+	}
+	uploadGlyphPage(*atlas->pages[page]);
+	return atlas->pages[page]->texture;
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::Glyph * ofTrueTypeFont::getGlyph(int character){
+	if(!atlas) return NULL;
+
+	map<int,Glyph>::iterator it = atlas->glyphs.find(character);
+	if(it!=atlas->glyphs.end()){
+		if(it->second.page>=0){
+			atlas->pages[it->second.page]->lastUsed = atlas->useCount;
+		}
+		return &it->second;
+	}
+
+	// characters the font doesn't have are stored too so they are only
+	// looked up once, they use the font's missing glyph
+	FT_Face face = atlas->face;
+	FT_Error err = FT_Load_Glyph( face, FT_Get_Char_Index( face, character ), FT_LOAD_DEFAULT );
+	if(err){
+		ofLogError("ofTrueTypeFont") << "getGlyph(): FT_Load_Glyph failed for char " << character << ": FT_Error " << err;
+		return NULL;
+	}
+
+	if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
+	else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
+
+	Glyph & glyph = atlas->glyphs[character];
+	setCharProps(glyph.props, face->glyph, character, fontSize);
+	glyph.page = -1;
+
+	if(bMakeContours){
+		makeContours(face, simplifyAmt, glyph.outline, glyph.outlineNonVFlipped);
+	}
+
+	const FT_Bitmap & bitmap = face->glyph->bitmap;
+	if(bitmap.width==0 || bitmap.rows==0){
+		return &glyph;
+	}
+
+	ofPixels & glyphPixels = atlas->glyphPixels;
+	getGlyphPixels(bitmap, bAntiAliased, bDistanceField ? distanceFieldSpread : 0, glyph.props, glyphPixels);
+
+	int page, x, y;
+	if(!allocateGlyphRect(glyphPixels.getWidth() + border*2, glyphPixels.getHeight() + border*2, page, x, y)){
+		ofLogError("ofTrueTypeFont") << "getGlyph(): char " << character << " doesn't fit in a glyph page of " << glyphPageSize << "x" << glyphPageSize;
+		return &glyph;
+	}
+
+	GlyphPage & glyphPage = *atlas->pages[page];
+	glyphPixels.pasteInto(glyphPage.pixels, x+border, y+border);
+	glyphPage.setDirty(x+border, y+border, glyphPixels.getWidth(), glyphPixels.getHeight());
+	glyphPage.characters.push_back(character);
+	glyphPage.lastUsed = atlas->useCount;
+
+	float size = glyphPage.size;
+	glyph.page = page;
+	glyph.props.t2 = float(x + border)/size;
+	glyph.props.v2 = float(y + border)/size;
+	glyph.props.t1 = float(x + border + glyph.props.tW)/size;
+	glyph.props.v1 = float(y + border + glyph.props.tH)/size;
+	return &glyph;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::allocateGlyphRect(int w, int h, int & page, int & x, int & y){
+	vector<ofPtr<GlyphPage> > & pages = atlas->pages;
+	for(int i=0;i<(int)pages.size();i++){
+		if(pages[i]->pack(w,h,x,y)){
+			page = i;
+			return true;
+		}
+	}
+	if(w>glyphPageSize || h>glyphPageSize){
+		return false;
+	}
+
+	// reuse the least recently used page if a new one doesn't fit in
+	// memory. pages used by the current string can't be reused unless
+	// their quads are drawn first
+	if(!pages.empty() && getGlyphMemory() + glyphPageSize*glyphPageSize*5 > maxGlyphMemory){
+		int lru = -1;
+		for(int i=0;i<(int)pages.size();i++){
+			if(pages[i]->lastUsed==atlas->useCount || pages[i]->quads.getNumVertices()) continue;
+			if(lru==-1 || pages[i]->lastUsed<pages[lru]->lastUsed) lru = i;
+		}
+		if(lru==-1 && binded){
+			drawGlyphPages();
+			for(int i=0;i<(int)pages.size();i++){
+				if(lru==-1 || pages[i]->lastUsed<pages[lru]->lastUsed) lru = i;
+			}
+		}
+		if(lru!=-1){
+			evictGlyphPage(lru);
+			if(pages[lru]->pack(w,h,x,y)){
+				page = lru;
+				return true;
+			}
+			return false;
+		}
+		if(!atlas->bWarnedMemory){
+			ofLogWarning("ofTrueTypeFont") << "allocateGlyphRect(): glyphs in use need more than " << maxGlyphMemory << " bytes, adding a page anyway";
+			atlas->bWarnedMemory = true;
+		}
+	}
+
+	pages.push_back(ofPtr<GlyphPage>(new GlyphPage));
+	GlyphPage & newPage = *pages.back();
+	newPage.size = glyphPageSize;
+	newPage.pixels.allocate(glyphPageSize,glyphPageSize,1);
+	newPage.pixels.set(0);
+	newPage.texture.allocate(glyphPageSize,glyphPageSize,GL_RGBA,false);
+	setTextureFilter(newPage.texture);
+	newPage.quads.setMode(OF_PRIMITIVE_TRIANGLES);
+	newPage.clearDirty();
+	newPage.setDirty(0,0,glyphPageSize,glyphPageSize);
+	newPage.lastUsed = atlas->useCount;
+
+	page = pages.size()-1;
+	return newPage.pack(w,h,x,y);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::evictGlyphPage(int page){
+	GlyphPage & glyphPage = *atlas->pages[page];
+	for(int i=0;i<(int)glyphPage.characters.size();i++){
+		atlas->glyphs.erase(glyphPage.characters[i]);
+	}
+	glyphPage.characters.clear();
+	glyphPage.shelves.clear();
+	glyphPage.pixels.set(0);
+	glyphPage.setDirty(0,0,glyphPage.size,glyphPage.size);
+
+	// layouts with glyphs from this page need to be built again
+	layoutVersion++;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::uploadGlyphPage(GlyphPage & page){
+	if(!page.isDirty()) return;
+
+	int x = page.dirtyX0;
+	int y = page.dirtyY0;
+	int w = page.dirtyX1 - page.dirtyX0;
+	int h = page.dirtyY1 - page.dirtyY0;
+	expandGlyphAlpha(page.pixels, x, y, w, h, atlas->uploadPixels);
+
+	ofTextureData & texData = page.texture.getTextureData();
+	ofSetPixelStorei(w,1,4);
+	glBindTexture(texData.textureTarget, (GLuint) texData.textureID);
+	glTexSubImage2D(texData.textureTarget, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, atlas->uploadPixels.getPixels());
+	glBindTexture(texData.textureTarget, 0);
+	page.clearDirty();
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::drawGlyphPages(){
+	if(!atlas) return;
+	for(int i=0;i<(int)atlas->pages.size();i++){
+		GlyphPage & page = *atlas->pages[i];
+		if(page.quads.getNumVertices()==0) continue;
+		uploadGlyphPage(page);
+		page.texture.bind();
+		page.quads.drawFaces();
+		page.texture.unbind();
+		page.quads.clear();
+	}
+}
+
+//-----------------------------------------------------------
+const charProps * ofTrueTypeFont::getCharProps(int character, int * page){
+	if(page) *page = -1;
+	if(character < NUM_CHARACTER_TO_START) return NULL;
+
+	if(!bDynamicGlyphs){
+		int cy = character - NUM_CHARACTER_TO_START;
+		if(cy >= nCharacters) return NULL;
+		return &cps[cy];
+	}
+
+	Glyph * glyph = getGlyph(character);
+	if(!glyph) return NULL;
+	if(page) *page = glyph->page;
+	return &glyph->props;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::getCharacters(const string & s, vector<int> & characters){
+	characters.clear();
+	characters.reserve(s.size());
+
+	if(bDynamicGlyphs){
+		if(atlas) atlas->useCount++;
+		Poco::UTF8Encoding utf8;
+		Poco::Latin9Encoding latin9;
+		Poco::TextEncoding & textEncoding = encoding==OF_ENCODING_UTF8 ? (Poco::TextEncoding&)utf8 : (Poco::TextEncoding&)latin9;
+		Poco::TextIterator it(s,textEncoding);
+		Poco::TextIterator end(s);
+		for(;it!=end;++it){
+			characters.push_back(*it);
+		}
+	}else if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
+		string o;
+		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(s,o);
+		for(int i=0;i<(int)o.size();i++){
+			characters.push_back((unsigned char)o[i]);
+		}
+	}else{
+		for(int i=0;i<(int)s.size();i++){
+			characters.push_back((unsigned char)s[i]);
+		}
+	}
+}
+
+//-----------------------------------------------------------
+float ofTrueTypeFont::getSpaceWidth(){
+	const charProps * props = getCharProps('p');
+	return props ? props->setWidth * letterSpacing * spaceSize : 0;
 }
 
 //-----------------------------------------------------------
@@ -762,6 +1402,7 @@ int ofTrueTypeFont::getSize() {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	layoutVersion++;
 }
 
 //-----------------------------------------------------------
@@ -772,6 +1413,7 @@ float ofTrueTypeFont::getLineHeight(){
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	layoutVersion++;
 }
 
 //-----------------------------------------------------------
@@ -782,6 +1424,7 @@ float ofTrueTypeFont::getLetterSpacing(){
 //-----------------------------------------------------------
 void ofTrueTypeFont::setSpaceSize(float _newspaceSize) {
 	spaceSize = _newspaceSize;
+	layoutVersion++;
 }
 
 //-----------------------------------------------------------
@@ -795,6 +1438,16 @@ ofTTFCharacter ofTrueTypeFont::getCharacterAsPoints(int character, bool vflip){
 		ofLogError("ofxTrueTypeFont") << "getCharacterAsPoints(): contours not created, call loadFont() with makeContours set to true";
 		return ofTTFCharacter();
 	}
+
+	if(bDynamicGlyphs){
+		Glyph * glyph = character < NUM_CHARACTER_TO_START ? NULL : getGlyph(character);
+		if(!glyph){
+			ofLogError("ofxTrueTypeFont") << "getCharacterAsPoint(): char " << character << " not allocated";
+			return ofTTFCharacter();
+		}
+		return vflip ? glyph->outline : glyph->outlineNonVFlipped;
+	}
+
     if (character - NUM_CHARACTER_TO_START >= nCharacters || character < NUM_CHARACTER_TO_START){
         ofLogError("ofxTrueTypeFont") << "getCharacterAsPoint(): char " << character + NUM_CHARACTER_TO_START
 		<< " not allocated: line " << __LINE__ << " in " << __FILE__;
@@ -817,19 +1470,25 @@ void ofTrueTypeFont::drawChar(int c, float x, float y) {
 		return;
 	}
 
+	addGlyphQuad(cps[c], stringQuads, x, y);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::addGlyphQuad(const charProps & props, ofMesh & mesh, float x, float y) {
+
 	GLfloat	x1, y1, x2, y2;
 	GLfloat t1, v1, t2, v2;
-	t2		= cps[c].t2;
-	v2		= cps[c].v2;
-	t1		= cps[c].t1;
-	v1		= cps[c].v1;
+	t2		= props.t2;
+	v2		= props.v2;
+	t1		= props.t1;
+	v1		= props.v1;
 
-	x1		= cps[c].x1+x;
-	y1		= cps[c].y1;
-	x2		= cps[c].x2+x;
-	y2		= cps[c].y2;
+	x1		= props.x1+x;
+	y1		= props.y1;
+	x2		= props.x2+x;
+	y2		= props.y2;
 
-	int firstIndex = stringQuads.getVertices().size();
+	int firstIndex = mesh.getVertices().size();
 
 	if(!ofIsVFlipped()){
        y1 *= -1;
@@ -839,32 +1498,26 @@ void ofTrueTypeFont::drawChar(int c, float x, float y) {
     y1 += y;
     y2 += y; 
 
-	stringQuads.addVertex(ofVec3f(x1,y1));
-	stringQuads.addVertex(ofVec3f(x2,y1));
-	stringQuads.addVertex(ofVec3f(x2,y2));
-	stringQuads.addVertex(ofVec3f(x1,y2));
-
-	stringQuads.addTexCoord(ofVec2f(t1,v1));
-	stringQuads.addTexCoord(ofVec2f(t2,v1));
-	stringQuads.addTexCoord(ofVec2f(t2,v2));
-	stringQuads.addTexCoord(ofVec2f(t1,v2));
-
-	stringQuads.addIndex(firstIndex);
-	stringQuads.addIndex(firstIndex+1);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+3);
-	stringQuads.addIndex(firstIndex);
+	mesh.addVertex(ofVec3f(x1,y1));
+	mesh.addVertex(ofVec3f(x2,y1));
+	mesh.addVertex(ofVec3f(x2,y2));
+	mesh.addVertex(ofVec3f(x1,y2));
+
+	mesh.addTexCoord(ofVec2f(t1,v1));
+	mesh.addTexCoord(ofVec2f(t2,v1));
+	mesh.addTexCoord(ofVec2f(t2,v2));
+	mesh.addTexCoord(ofVec2f(t1,v2));
+
+	mesh.addIndex(firstIndex);
+	mesh.addIndex(firstIndex+1);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+3);
+	mesh.addIndex(firstIndex);
 }
 
 //-----------------------------------------------------------
 vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip){
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
-		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(str,o);
-		str=o;
-	}
-
 	vector<ofTTFCharacter> shapes;
 
 	if (!bLoadedOk){
@@ -872,7 +1525,6 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip)
 		return shapes;
 	};
 
-	GLint		index	= 0;
 	GLfloat		X		= 0;
 	GLfloat		Y		= 0;
 	int newLineDirection		= 1;
@@ -884,26 +1536,25 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip)
 		newLineDirection = -1;
 	}
 
+	vector<int> characters;
+	getCharacters(str,characters);
 
-	int len = (int)str.length();
-
-	while(index < len){
-		int cy = (unsigned char)str[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-			if (str[index] == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = 0 ; //reset X Pos back to zero
-			}else if (str[index] == ' ') {
-				int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				X += cps[cy].setWidth * letterSpacing * spaceSize;
-			} else if(cy > -1){
-				shapes.push_back(getCharacterAsPoints((unsigned char)str[index],vflip));
+	for(int index=0;index<(int)characters.size();index++){
+		int c = characters[index];
+		if (c == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = 0 ; //reset X Pos back to zero
+		}else if (c == ' ') {
+			X += getSpaceWidth();
+		} else {
+			const charProps * props = getCharProps(c);
+			if(props){
+				shapes.push_back(getCharacterAsPoints(c,vflip));
 				shapes.back().translate(ofPoint(X,Y));
 
-				X += cps[cy].setWidth * letterSpacing;
+				X += props->setWidth * letterSpacing;
 			}
 		}
-		index++;
 	}
 	return shapes;
 
@@ -911,21 +1562,22 @@ vector<ofTTFCharacter> ofTrueTypeFont::getStringAsPoints(string str, bool vflip)
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::drawCharAsShape(int c, float x, float y) {
-	if (c - NUM_CHARACTER_TO_START >= nCharacters || c < NUM_CHARACTER_TO_START){
-		//ofLogError("ofTrueTypeFont") << "drawCharAsShape(): char " << << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
-		return;
+	ofTTFCharacter * charRef;
+	if(bDynamicGlyphs){
+		Glyph * glyph = c < NUM_CHARACTER_TO_START ? NULL : getGlyph(c);
+		if(!glyph) return;
+		charRef = ofIsVFlipped() ? &glyph->outline : &glyph->outlineNonVFlipped;
+	}else{
+		if (c - NUM_CHARACTER_TO_START >= nCharacters || c < NUM_CHARACTER_TO_START){
+			//ofLogError("ofTrueTypeFont") << "drawCharAsShape(): char " << << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
+			return;
+		}
+		charRef = ofIsVFlipped() ? &charOutlines[c - NUM_CHARACTER_TO_START] : &charOutlinesNonVFlipped[c - NUM_CHARACTER_TO_START];
 	}
 	//-----------------------
 
-	if(ofIsVFlipped()){
-		ofTTFCharacter & charRef = charOutlines[c - NUM_CHARACTER_TO_START];
-		charRef.setFilled(ofGetStyle().bFill);
-		charRef.draw(x,y);
-	}else{
-		ofTTFCharacter & charRef = charOutlinesNonVFlipped[c - NUM_CHARACTER_TO_START];
-		charRef.setFilled(ofGetStyle().bFill);
-		charRef.draw(x,y);
-	}
+	charRef->setFilled(ofGetStyle().bFill);
+	charRef->draw(x,y);
 }
 
 //-----------------------------------------------------------
@@ -936,6 +1588,16 @@ float ofTrueTypeFont::stringWidth(string c) {
 
 
 ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
+	// strings drawn recently have their bounding box in the layout cache
+	ofTextLayout * layout = layoutCache.find(c);
+	if(layout && bLoadedOk){
+		return layout->getBoundingBox(x,y);
+	}
+	return computeStringBoundingBox(c,x,y);
+}
+
+//-----------------------------------------------------------
+ofRectangle ofTrueTypeFont::computeStringBoundingBox(const string & c, float x, float y){
 
     ofRectangle myRect;
 
@@ -944,16 +1606,14 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
     	return myRect;
     }
 
-	GLint		index	= 0;
 	GLfloat		xoffset	= 0;
 	GLfloat		yoffset	= 0;
-    int         len     = (int)c.length();
     float       minx    = -1;
     float       miny    = -1;
     float       maxx    = -1;
     float       maxy    = -1;
 
-    if ( len < 1 || cps.empty() ){
+    if ( c.empty() || (cps.empty() && !bDynamicGlyphs) ){
         myRect.x        = 0;
         myRect.y        = 0;
         myRect.width    = 0;
@@ -961,46 +1621,47 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y){
         return myRect;
     }
 
+	vector<int> characters;
+	getCharacters(c,characters);
+
     bool bFirstCharacter = true;
-	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
- 	    if (cy < nCharacters){ 			// full char set or not?
-	       if (c[index] == '\n') {
-				yoffset += lineHeight;
-				xoffset = 0 ; //reset X Pos back to zero
-	      } else if (c[index] == ' ') {
-	     		int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				 xoffset += cps[cy].setWidth * letterSpacing * spaceSize;
-				 // zach - this is a bug to fix -- for now, we don't currently deal with ' ' in calculating string bounding box
-		  } else if(cy > -1){
-                GLint height	= cps[cy].height;
-            	GLint bwidth	= cps[cy].width * letterSpacing;
-            	GLint top		= cps[cy].topExtent - cps[cy].height;
-            	GLint lextent	= cps[cy].leftExtent;
-            	float	x1, y1, x2, y2, corr, stretch;
-            	stretch = 0;//(float)visibleBorder * 2;
-				corr = (float)(((fontSize - height) + top) - fontSize);
-				x1		= (x + xoffset + lextent + bwidth + stretch);
-            	y1		= (y + yoffset + height + corr + stretch);
-            	x2		= (x + xoffset + lextent);
-            	y2		= (y + yoffset + -top + corr);
-				xoffset += cps[cy].setWidth * letterSpacing;
-				if (bFirstCharacter == true){
-                    minx = x2;
-                    miny = y2;
-                    maxx = x1;
-                    maxy = y1;
-                    bFirstCharacter = false;
-                } else {
-                    if (x2 < minx) minx = x2;
-                    if (y2 < miny) miny = y2;
-                    if (x1 > maxx) maxx = x1;
-                    if (y1 > maxy) maxy = y1;
-            }
-		  }
-	  	}
-    	index++;
-    }
+	for(int index=0;index<(int)characters.size();index++){
+		int character = characters[index];
+		if (character == '\n') {
+			yoffset += lineHeight;
+			xoffset = 0 ; //reset X Pos back to zero
+		} else if (character == ' ') {
+			xoffset += getSpaceWidth();
+			// zach - this is a bug to fix -- for now, we don't currently deal with ' ' in calculating string bounding box
+		} else {
+			const charProps * props = getCharProps(character);
+			if(!props) continue;
+			GLint height	= props->height;
+			GLint bwidth	= props->width * letterSpacing;
+			GLint top		= props->topExtent - props->height;
+			GLint lextent	= props->leftExtent;
+			float	x1, y1, x2, y2, corr, stretch;
+			stretch = 0;//(float)visibleBorder * 2;
+			corr = (float)(((fontSize - height) + top) - fontSize);
+			x1		= (x + xoffset + lextent + bwidth + stretch);
+			y1		= (y + yoffset + height + corr + stretch);
+			x2		= (x + xoffset + lextent);
+			y2		= (y + yoffset + -top + corr);
+			xoffset += props->setWidth * letterSpacing;
+			if (bFirstCharacter == true){
+				minx = x2;
+				miny = y2;
+				maxx = x1;
+				maxy = y1;
+				bFirstCharacter = false;
+			} else {
+				if (x2 < minx) minx = x2;
+				if (y2 < miny) miny = y2;
+				if (x1 > maxx) maxx = x1;
+				if (y1 > maxy) maxy = y1;
+			}
+		}
+	}
 
     myRect.x        = minx;
     myRect.y        = miny;
@@ -1016,7 +1677,11 @@ float ofTrueTypeFont::stringHeight(string c) {
 }
 
 void ofTrueTypeFont::createStringMesh(string c, float x, float y){
-	GLint		index	= 0;
+	addStringQuads(c,x,y,NULL);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::addStringQuads(const string & c, float x, float y, ofTextLayout * layout){
 	GLfloat		X		= x;
 	GLfloat		Y		= y;
 	int newLineDirection		= 1;
@@ -1028,35 +1693,55 @@ void ofTrueTypeFont::createStringMesh(string c, float x, float y){
 		newLineDirection = -1;
 	}
 
-	int len = (int)c.length();
-
-	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-		  if (c[index] == '\n') {
+	vector<int> characters;
+	getCharacters(c,characters);
 
-				Y += lineHeight*newLineDirection;
-				X = x ; //reset X Pos back to zero
-
-		  }else if (c[index] == ' ') {
-				 int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				 X += cps[cy].setWidth * letterSpacing * spaceSize;
-		  } else if(cy > -1){
-				drawChar(cy, X, Y);
-				X += cps[cy].setWidth * letterSpacing;
-		  }
+	for(int index=0;index<(int)characters.size();index++){
+		int character = characters[index];
+		if (character == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = x ; //reset X Pos back to zero
+		}else if (character == ' ') {
+			X += getSpaceWidth();
+		} else {
+			int page;
+			const charProps * props = getCharProps(character,&page);
+			if(!props) continue;
+			if(!bDynamicGlyphs){
+				addGlyphQuad(*props, layout ? layout->getMeshForPage(0) : stringQuads, X, Y);
+			}else if(page>=0){
+				// while binded every page collects its own quads
+				// so they can be drawn with the right texture
+				if(layout){
+					addGlyphQuad(*props, layout->getMeshForPage(page), X, Y);
+				}else{
+					addGlyphQuad(*props, binded ? atlas->pages[page]->quads : stringQuads, X, Y);
+				}
+			}
+			X += props->setWidth * letterSpacing;
 		}
-		index++;
 	}
 }
 
 ofMesh & ofTrueTypeFont::getStringMesh(string c, float x, float y){
 	stringQuads.clear();
-	createStringMesh(c,x,y);
+	if(layoutCacheSize>0 && bLoadedOk){
+		ofTextLayout & layout = getCachedLayout(c);
+		if(updateLayout(layout)){
+			for(int i=0;i<(int)layout.meshes.size();i++){
+				appendQuads(layout.meshes[i],stringQuads,x,y);
+			}
+		}
+	}else{
+		createStringMesh(c,x,y);
+	}
 	return stringQuads;
 }
 
 ofTexture & ofTrueTypeFont::getFontTexture(){
+	if(bDynamicGlyphs && getNumGlyphPages()>0){
+		return getGlyphPageTexture(0);
+	}
 	return texAtlas;
 }
 
@@ -1067,17 +1752,16 @@ void ofTrueTypeFont::drawString(string c, float x, float y) {
 	 glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	 texAtlas.draw(0,0);*/
 	
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
-		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
-		c=o;
-	}
-	
 	if (!bLoadedOk){
 		ofLogError("ofTrueTypeFont") << "drawString(): font not allocated: line " << __LINE__ << " in " << __FILE__;
 		return;
 	};
 	
+	if(layoutCacheSize>0){
+		drawLayout(getCachedLayout(c),x,y);
+		return;
+	}
+
 	bool alreadyBinded = binded;
 
 	if(!alreadyBinded) bind();
@@ -1086,6 +1770,197 @@ void ofTrueTypeFont::drawString(string c, float x, float y) {
 
 }
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::drawLayout(ofTextLayout & layout, float x, float y){
+	if(!updateLayout(layout)){
+		ofLogError("ofTrueTypeFont") << "drawLayout(): font not allocated";
+		return;
+	}
+
+	if(bDynamicGlyphs){
+		atlas->useCount++;
+		for(int i=0;i<(int)layout.pages.size();i++){
+			atlas->pages[layout.pages[i]]->lastUsed = atlas->useCount;
+		}
+	}
+
+	// while binded the quads are added to the batch
+	if(binded){
+		for(int i=0;i<(int)layout.meshes.size();i++){
+			ofMesh & dst = bDynamicGlyphs ? atlas->pages[layout.pages[i]]->quads : stringQuads;
+			appendQuads(layout.meshes[i],dst,x,y);
+		}
+		return;
+	}
+
+	bind();
+	ofPushMatrix();
+	ofTranslate(x,y);
+	for(int i=0;i<(int)layout.meshes.size();i++){
+		if(bDynamicGlyphs){
+			GlyphPage & page = *atlas->pages[layout.pages[i]];
+			uploadGlyphPage(page);
+			page.texture.bind();
+			layout.meshes[i].drawFaces();
+			page.texture.unbind();
+		}else{
+			layout.meshes[i].drawFaces();
+		}
+	}
+	ofPopMatrix();
+	unbind();
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::enableDistanceField(int spread){
+#ifdef TARGET_OPENGLES
+	if(!ofIsGLProgrammableRenderer()){
+		ofLogError("ofTrueTypeFont") << "enableDistanceField(): distance fields need shaders, use the programmable renderer";
+		return;
+	}
+#endif
+	if(bDistanceField && spread==distanceFieldSpread) return;
+	bDistanceField = true;
+	distanceFieldSpread = max(spread,1);
+	if(bLoadedOk) reloadTextures();
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::disableDistanceField(){
+	if(!bDistanceField) return;
+	bDistanceField = false;
+	if(bLoadedOk) reloadTextures();
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::getUsingDistanceField(){
+	return bDistanceField;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setTextureFilter(ofTexture & texture){
+	// distance fields are always interpolated, that's where the
+	// outline between texels comes from
+	if(bDistanceField || (bAntiAliased && fontSize>20)){
+		texture.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+	}else{
+		texture.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::setLayoutCacheSize(int size){
+	layoutCacheSize = max(size,0);
+	layoutCache.trim(layoutCacheSize);
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getLayoutCacheSize(){
+	return layoutCacheSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::clearLayoutCache(){
+	layoutCache.clear();
+}
+
+//-----------------------------------------------------------
+ofTextLayout & ofTrueTypeFont::getCachedLayout(const string & s){
+	ofTextLayout * layout = layoutCache.use(s);
+	if(!layout){
+		layoutCache.trim(layoutCacheSize-1);
+		layout = &layoutCache.add(s);
+		layout->setup(*this,s);
+	}
+	return *layout;
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::LayoutCache::LayoutCache(){
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::LayoutCache::LayoutCache(const LayoutCache &){
+}
+
+//-----------------------------------------------------------
+ofTrueTypeFont::LayoutCache & ofTrueTypeFont::LayoutCache::operator=(const LayoutCache &){
+	clear();
+	return *this;
+}
+
+//-----------------------------------------------------------
+ofTextLayout * ofTrueTypeFont::LayoutCache::find(const string & s){
+	map<string,Entry>::iterator it = entries.find(s);
+	if(it==entries.end()) return NULL;
+	return &it->second.layout;
+}
+
+//-----------------------------------------------------------
+ofTextLayout * ofTrueTypeFont::LayoutCache::use(const string & s){
+	map<string,Entry>::iterator it = entries.find(s);
+	if(it==entries.end()) return NULL;
+	order.splice(order.begin(),order,it->second.order);
+	return &it->second.layout;
+}
+
+//-----------------------------------------------------------
+ofTextLayout & ofTrueTypeFont::LayoutCache::add(const string & s){
+	Entry & entry = entries[s];
+	order.push_front(s);
+	entry.order = order.begin();
+	return entry.layout;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::LayoutCache::trim(int size){
+	while((int)entries.size()>max(size,0)){
+		entries.erase(order.back());
+		order.pop_back();
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::LayoutCache::clear(){
+	entries.clear();
+	order.clear();
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::updateLayout(ofTextLayout & layout){
+	if(!bLoadedOk) return false;
+	if(!layout.bNeedsUpdate && layout.font==this && layout.version==layoutVersion && layout.bVFlipped==ofIsVFlipped()){
+		return true;
+	}
+
+	// glyph pages evicted while building it leave the layout outdated
+	// so it's built again next time
+	unsigned int version = layoutVersion;
+	layout.font = this;
+	layout.bVFlipped = ofIsVFlipped();
+	layout.meshes.clear();
+	layout.pages.clear();
+	addStringQuads(layout.text,0,0,&layout);
+	layout.version = version;
+	layout.bNeedsUpdate = false;
+	layout.bBoundingBoxNeedsUpdate = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendQuads(const ofMesh & src, ofMesh & dst, float x, float y){
+	int firstIndex = dst.getNumVertices();
+	const vector<ofVec3f> & vertices = src.getVertices();
+	for(int i=0;i<(int)vertices.size();i++){
+		dst.addVertex(ofVec3f(vertices[i].x+x, vertices[i].y+y));
+	}
+	dst.addTexCoords(src.getTexCoords());
+	const vector<ofIndexType> & indices = src.getIndices();
+	for(int i=0;i<(int)indices.size();i++){
+		dst.addIndex(indices[i]+firstIndex);
+	}
+}
+
 //-----------------------------------------------------------
 void ofTrueTypeFont::bind(){
 	if(!binded){
@@ -1112,7 +1987,8 @@ void ofTrueTypeFont::bind(){
 	    glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		texAtlas.bind();
+		if(bDistanceField) distanceFieldShader().begin();
+		if(!bDynamicGlyphs) texAtlas.bind();
 		stringQuads.clear();
 		binded = true;
 	}
@@ -1121,8 +1997,13 @@ void ofTrueTypeFont::bind(){
 //-----------------------------------------------------------
 void ofTrueTypeFont::unbind(){
 	if(binded){
-		stringQuads.drawFaces();
-		texAtlas.unbind();
+		if(bDynamicGlyphs){
+			drawGlyphPages();
+		}else{
+			stringQuads.drawFaces();
+			texAtlas.unbind();
+		}
+		if(bDistanceField) distanceFieldShader().end();
 
 		if( !blend_enabled )
 			glDisable(GL_BLEND);
@@ -1148,13 +2029,6 @@ void ofTrueTypeFont::drawStringAsShapes(string c, float x, float y) {
 		return;
 	}
 
-	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
-		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
-		c=o;
-	}
-
-	GLint		index	= 0;
 	GLfloat		X		= x;
 	GLfloat		Y		= y;
 	int newLineDirection		= 1;
@@ -1166,32 +2040,30 @@ void ofTrueTypeFont::drawStringAsShapes(string c, float x, float y) {
 		newLineDirection = -1;
 	}
 
-	int len = (int)c.length();
-
-	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-		  if (c[index] == '\n') {
-
-				Y += lineHeight*newLineDirection;
-				X = x ; //reset X Pos back to zero
+	vector<int> characters;
+	getCharacters(c,characters);
 
-		  }else if (c[index] == ' ') {
-				 int cy = (int)'p' - NUM_CHARACTER_TO_START;
-				 X += cps[cy].setWidth * letterSpacing * spaceSize;
-				 //glTranslated(cps[cy].width, 0, 0);
-		  } else if(cy > -1){
-				drawCharAsShape((unsigned char)c[index], X, Y);
-				X += cps[cy].setWidth * letterSpacing;
-				//glTranslated(cps[cy].setWidth, 0, 0);
-		  }
+	for(int index=0;index<(int)characters.size();index++){
+		int character = characters[index];
+		if (character == '\n') {
+			Y += lineHeight*newLineDirection;
+			X = x ; //reset X Pos back to zero
+		}else if (character == ' ') {
+			X += getSpaceWidth();
+		} else {
+			const charProps * props = getCharProps(character);
+			if(!props) continue;
+			drawCharAsShape(character, X, Y);
+			X += props->setWidth * letterSpacing;
 		}
-		index++;
 	}
 
 }
 
 //-----------------------------------------------------------
 int ofTrueTypeFont::getNumCharacters() {
+	if(bDynamicGlyphs){
+		return atlas ? atlas->glyphs.size() : 0;
+	}
 	return nCharacters;
 }
@@ -2,12 +2,15 @@
 
 
 #include <vector>
+#include <map>
+#include <list>
 #include "ofPoint.h"
 #include "ofRectangle.h"
 #include "ofConstants.h"
 #include "ofPath.h"
 #include "ofTexture.h"
 #include "ofMesh.h"
+#include "ofTextLayout.h"
 
 //--------------------------------------------------
 typedef struct {
@@ -28,6 +31,12 @@ typedef ofPath ofTTFCharacter;
 //--------------------------------------------------
 #define NUM_CHARACTER_TO_START		33		// 0 - 32 are control characters, no graphics needed.
 
+// computes a signed distance field from the coverage of a 1 channel image:
+// 128 is the outline, values above are inside the shape, and 0 and 255 are
+// spread pixels away from it. the coverage needs spread pixels of empty
+// margin for the distance outside the shape to be complete
+void ofComputeDistanceField(const ofPixels & coverage, ofPixels & distanceField, int spread);
+
 const static string OF_TTF_SANS = "sans-serif";
 const static string OF_TTF_SERIF = "serif";
 const static string OF_TTF_MONO = "monospace";
@@ -79,6 +88,54 @@ public:
 	ofTextEncoding getEncoding() const;
 	void setEncoding(ofTextEncoding encoding);
 
+	// dynamic glyphs: instead of rasterizing a fixed character set when the
+	// font is loaded, every glyph is rasterized the first time a string uses
+	// it so any unicode character in the font can be drawn. strings are
+	// decoded using the current encoding.
+	// glyphs are packed in pages of pageSize x pageSize pixels, when adding
+	// a page would go over maxGlyphMemory the least recently used page is
+	// emptied to make room for the new glyphs. only the part of a page that
+	// changed is uploaded to the texture.
+	// enabling or disabling reloads the font if it's already loaded
+	void		enableDynamicGlyphs();
+	void		disableDynamicGlyphs();
+	bool		getUsingDynamicGlyphs();
+	void		setGlyphPageSize(int pageSize);
+	int			getGlyphPageSize();
+	// memory used by the pages, textures + the cpu copy of the glyphs, in bytes
+	void		setMaxGlyphMemory(int bytes);
+	int			getMaxGlyphMemory();
+	int			getGlyphMemory();
+	int			getNumGlyphPages();
+
+	// with dynamic glyphs getFontTexture() returns the first page, the meshes
+	// returned by getStringMesh() are only correct if all their glyphs are
+	// in that page. drawString() doesn't have that limitation
+	ofTexture &	getGlyphPageTexture(int page);
+
+	// drawString() keeps the layouts of the last strings it drew so drawing
+	// them again only submits their quads, see ofTextLayout. the size is the
+	// number of strings kept, 0 disables the cache
+	void		setLayoutCacheSize(int size);
+	int			getLayoutCacheSize();
+	void		clearLayoutCache();
+
+	void		drawLayout(ofTextLayout & layout, float x, float y);
+
+	// distance field glyphs: the atlas stores the distance of every texel to
+	// the outline of the glyphs instead of their coverage and a shader finds
+	// the outline when drawing, so the font can be drawn sharp at any scale
+	// using ofScale or any other transformation instead of loading it at
+	// every size. the size passed to loadFont is the size the glyphs are
+	// rasterized at, 32 to 64 is usually enough. spread is the distance in
+	// pixels around the outline that is stored, bigger allows smaller scales.
+	// enabling or disabling reloads the font if it's already loaded.
+	// getStringMesh() and getFontTexture() give the distance field, drawing
+	// them needs a shader like the one drawString() uses
+	void		enableDistanceField(int spread=6);
+	void		disableDistanceField();
+	bool		getUsingDistanceField();
+
 protected:
 	bool			bLoadedOk;
 	bool 			bAntiAliased;
@@ -102,6 +159,12 @@ protected:
 	void 			drawChar(int c, float x, float y);
 	void			drawCharAsShape(int c, float x, float y);
 	void			createStringMesh(string s, float x, float y);
+
+	// properties of a character code, rasterizing it if it's not loaded
+	// yet with dynamic glyphs. NULL if the font can't draw it
+	const charProps * getCharProps(int character, int * page=NULL);
+	void			getCharacters(const string & s, vector<int> & characters);
+	float			getSpaceWidth();
 	
 	int				border;//, visibleBorder;
 	string			filename;
@@ -110,6 +173,16 @@ protected:
 	bool binded;
 	ofMesh stringQuads;
 
+	bool			bDynamicGlyphs;
+	int				glyphPageSize;
+	int				maxGlyphMemory;
+
+	bool			bDistanceField;
+	int				distanceFieldSpread;
+
+	unsigned int	layoutVersion;		// changes when the layouts built with this font are no longer valid
+	int				layoutCacheSize;
+
 private:
 #if defined(TARGET_ANDROID) || defined(TARGET_OF_IOS)
 	friend void ofUnloadAllFontTextures();
@@ -121,6 +194,53 @@ private:
 	GLboolean texture_2d_enabled;
 
 	ofTextEncoding encoding;
+
+	struct Glyph;
+	struct GlyphPage;
+	class GlyphAtlas;
+	ofPtr<GlyphAtlas> atlas;	// shared by copies of the font
+
+	// the layouts of the strings drawn recently in the order they were
+	// used, so the least recently used one is dropped in constant time.
+	// the layouts point to the font that built them so copies of the
+	// font start with an empty cache
+	class LayoutCache{
+	public:
+		LayoutCache();
+		LayoutCache(const LayoutCache &);
+		LayoutCache & operator=(const LayoutCache &);
+
+		ofTextLayout * find(const string & s);	// doesn't count as a use
+		ofTextLayout * use(const string & s);	// NULL if it's not in the cache
+		ofTextLayout & add(const string & s);
+		void trim(int size);
+		void clear();
+
+	private:
+		struct Entry{
+			ofTextLayout layout;
+			list<string>::iterator order;
+		};
+		map<string,Entry> entries;
+		list<string> order;		// most recently used first
+	};
+	LayoutCache layoutCache;
+
+	Glyph *		getGlyph(int character);
+	bool		allocateGlyphRect(int w, int h, int & page, int & x, int & y);
+	void		evictGlyphPage(int page);
+	void		uploadGlyphPage(GlyphPage & page);
+	void		drawGlyphPages();
+	void		addGlyphQuad(const charProps & props, ofMesh & mesh, float x, float y);
+	void		setTextureFilter(ofTexture & texture);
+
+	friend class ofTextLayout;
+	bool		updateLayout(ofTextLayout & layout);
+	ofTextLayout & getCachedLayout(const string & s);
+	ofRectangle	computeStringBoundingBox(const string & s, float x, float y);
+	void		addStringQuads(const string & s, float x, float y, ofTextLayout * layout);
+	static void	appendQuads(const ofMesh & src, ofMesh & dst, float x, float y);
+
 	void		unloadTextures();
 	void		reloadTextures();
 	static bool	initLibraries();
@@ -8,6 +8,8 @@
 #include "ofSystemUtils.h"
 #include "ofThread.h"
 #include "ofURLFileLoader.h"
+#include "ofFileAsync.h"
+#include "ofDirectoryWatcher.h"
 #include "ofUtils.h"
 
 //--------------------------
@@ -20,6 +22,7 @@
 #include "ofXml.h"
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
+#include "ofParameterMirror.h"
 
 //--------------------------
 // math
@@ -54,12 +57,14 @@
 #endif
 #include "ofGraphics.h"
 #include "ofImage.h"
+#include "ofImageSequenceWriter.h"
 #include "ofPath.h"
 #include "ofPixels.h"
 #include "ofPolyline.h"
 #include "ofRendererCollection.h"
 #include "ofTessellator.h"
 #include "ofTrueTypeFont.h"
+#include "ofTextLayout.h"
 
 //--------------------------
 // app
@@ -83,8 +88,10 @@
 //--------------------------
 // 3d
 #include "of3dUtils.h"
+#include "ofBoundingBox.h"
 #include "ofCamera.h"
 #include "ofEasyCam.h"
 #include "ofMesh.h"
 #include "ofNode.h"
+#include "ofNodeGraph.h"
 
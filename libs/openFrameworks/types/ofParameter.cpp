@@ -1,6 +1,8 @@
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
 
+int ofAbstractParameter::structureVersion = 0;
+
 ofAbstractParameter::ofAbstractParameter(){
 	parent = NULL;
 }
@@ -48,6 +48,11 @@ protected:
 	virtual void setSerializable(bool serializable);
 	void notifyParent();
 	virtual string escape(string str) const;
+
+	// incremented when any parameter is added to or removed from a
+	// group, renamed or made (not) serializable, groups use it to know
+	// when the layout of their snapshots needs to be rebuilt
+	static int structureVersion;
 private:
 	ofParameterGroup * parent;
 };
@@ -170,6 +175,7 @@ private:
 	void eventsSetValue(ParameterType v);
 	void noEventsSetValue(ParameterType v);
 
+	friend class ofParameterGroup;
 
 };
 
@@ -259,6 +265,7 @@ inline void ofParameter<ParameterType>::noEventsSetValue(ParameterType v){
 
 template<typename ParameterType>
 void ofParameter<ParameterType>::setSerializable(bool serializable){
+	if(obj->serializable!=serializable) structureVersion++;
 	obj->serializable = serializable;
 }
 
@@ -294,6 +301,7 @@ inline ofParameter<ParameterType>::operator const ParameterType & () const{
 
 template<typename ParameterType>
 void ofParameter<ParameterType>::setName(string _name){
+	if(obj->name!=_name) structureVersion++;
 	obj->name = _name;
 }
 
@@ -1,6 +1,7 @@
 #include "ofParameterGroup.h"
 #include "ofUtils.h"
 #include "ofParameter.h"
+#include "ofFileUtils.h"
 
 ofParameterGroup::ofParameterGroup()
 :obj(new Value)
@@ -12,11 +13,13 @@ void ofParameterGroup::add(ofAbstractParameter & param){
 	obj->parameters.push_back(&param);
 	obj->parametersIndex[param.getEscapedName()] = obj->parameters.size()-1;
 	param.setParent(this);
+	structureVersion++;
 }
 
 void ofParameterGroup::clear(){
 	obj->parameters.clear();
 	obj->parametersIndex.clear();
+	structureVersion++;
 }
 
 ofParameter<bool> ofParameterGroup::getBool(string name) const	{
@@ -163,6 +166,7 @@ string ofParameterGroup::getName() const{
 }
 
 void ofParameterGroup::setName(string _name){
+	if(obj->name!=_name) structureVersion++;
 	obj->name = _name;
 }
 
@@ -241,9 +245,241 @@ const ofAbstractParameter & ofParameterGroup::front() const{
 }
 
 void ofParameterGroup::setSerializable(bool _serializable){
+	if(obj->serializable!=_serializable) structureVersion++;
 	obj->serializable = _serializable;
 }
 
 bool ofParameterGroup::isSerializable() const{
 	return obj->serializable;
 }
+
+// fnv-1a
+static unsigned int hashLayout(unsigned int hash, const string & str){
+	for(int i=0;i<(int)str.size();i++){
+		hash ^= (unsigned char)str[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+void ofParameterGroup::flattenInto(Value & layout, const string & prefix) const{
+	static const string groupType = typeid(ofParameterGroup).name();
+	static const string floatType = typeid(ofParameter<float>).name();
+	static const string intType = typeid(ofParameter<int>).name();
+	for(int i=0;i<(int)obj->parameters.size();i++){
+		ofAbstractParameter * param = obj->parameters[i];
+		if(!param->isSerializable()) continue;
+		string name = prefix + param->getEscapedName();
+		string type = param->type();
+		layout.layoutHash = hashLayout(hashLayout(layout.layoutHash, name), type);
+		if(type==groupType){
+			static_cast<ofParameterGroup*>(param)->flattenInto(layout, name + "/");
+		}else if(type==floatType || type==intType){
+			layout.numericParameters.push_back(param);
+			layout.numericIsInt.push_back(type==intType);
+		}else{
+			layout.otherParameters.push_back(param);
+		}
+	}
+}
+
+void ofParameterGroup::updateLayout() const{
+	if(obj->layoutVersion==structureVersion) return;
+	obj->numericParameters.clear();
+	obj->numericIsInt.clear();
+	obj->otherParameters.clear();
+	obj->layoutHash = 2166136261u;
+	flattenInto(*obj, "");
+	obj->lerpValues.resize(obj->numericParameters.size());
+	obj->layoutVersion = structureVersion;
+}
+
+int ofParameterGroup::getNumNumericParameters() const{
+	updateLayout();
+	return obj->numericParameters.size();
+}
+
+void ofParameterGroup::getSnapshot(ofParameterSnapshot & snapshot) const{
+	updateLayout();
+	snapshot.layoutHash = obj->layoutHash;
+	snapshot.values.resize(obj->numericParameters.size());
+	for(int i=0;i<(int)obj->numericParameters.size();i++){
+		if(obj->numericIsInt[i]){
+			snapshot.values[i] = static_cast<ofParameter<int>*>(obj->numericParameters[i])->get();
+		}else{
+			snapshot.values[i] = static_cast<ofParameter<float>*>(obj->numericParameters[i])->get();
+		}
+	}
+	snapshot.strings.resize(obj->otherParameters.size());
+	for(int i=0;i<(int)obj->otherParameters.size();i++){
+		snapshot.strings[i] = obj->otherParameters[i]->toString();
+	}
+}
+
+bool ofParameterGroup::applyValues(const vector<float> & values, bool bNotifyParameters){
+	bool bChanged = false;
+	for(int i=0;i<(int)values.size();i++){
+		if(obj->numericIsInt[i]){
+			ofParameter<int> & param = *static_cast<ofParameter<int>*>(obj->numericParameters[i]);
+			int value = floor(values[i] + 0.5f);
+			if(param.get()==value) continue;
+			if(bNotifyParameters) param.set(value);
+			else param.noEventsSetValue(value);
+		}else{
+			ofParameter<float> & param = *static_cast<ofParameter<float>*>(obj->numericParameters[i]);
+			if(param.get()==values[i]) continue;
+			if(bNotifyParameters) param.set(values[i]);
+			else param.noEventsSetValue(values[i]);
+		}
+		bChanged = true;
+	}
+	return bChanged;
+}
+
+bool ofParameterGroup::setSnapshot(const ofParameterSnapshot & snapshot, bool bNotifyParameters){
+	updateLayout();
+	if(snapshot.layoutHash!=obj->layoutHash
+			|| snapshot.values.size()!=obj->numericParameters.size()
+			|| snapshot.strings.size()!=obj->otherParameters.size()){
+		ofLogError("ofParameterGroup") << "setSnapshot(): snapshot doesn't match the layout of group " << getName();
+		return false;
+	}
+	bool bChanged = applyValues(snapshot.values, bNotifyParameters);
+	for(int i=0;i<(int)obj->otherParameters.size();i++){
+		ofAbstractParameter & param = *obj->otherParameters[i];
+		if(param.toString()==snapshot.strings[i]) continue;
+		param.fromString(snapshot.strings[i]);
+		bChanged = true;
+	}
+	if(bChanged) ofNotifyEvent(obj->snapshotAppliedE,*this,this);
+	return true;
+}
+
+bool ofParameterGroup::lerp(const ofParameterSnapshot & from, const ofParameterSnapshot & to, float t, bool bNotifyParameters){
+	updateLayout();
+	int n = obj->numericParameters.size();
+	if(from.layoutHash!=obj->layoutHash || to.layoutHash!=obj->layoutHash
+			|| (int)from.values.size()!=n || (int)to.values.size()!=n){
+		ofLogError("ofParameterGroup") << "lerp(): snapshots don't match the layout of group " << getName();
+		return false;
+	}
+	// plain loop over contiguous floats so the compiler can vectorize it
+	const float * a = n ? &from.values[0] : NULL;
+	const float * b = n ? &to.values[0] : NULL;
+	float * out = n ? &obj->lerpValues[0] : NULL;
+	for(int i=0;i<n;i++){
+		out[i] = a[i] + (b[i] - a[i]) * t;
+	}
+	if(applyValues(obj->lerpValues, bNotifyParameters)){
+		ofNotifyEvent(obj->snapshotAppliedE,*this,this);
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+ofParameterSnapshot::ofParameterSnapshot()
+:layoutHash(0){
+}
+
+vector<float> & ofParameterSnapshot::getValues(){
+	return values;
+}
+
+const vector<float> & ofParameterSnapshot::getValues() const{
+	return values;
+}
+
+int ofParameterSnapshot::size() const{
+	return values.size();
+}
+
+unsigned int ofParameterSnapshot::getLayoutHash() const{
+	return layoutHash;
+}
+
+static const char snapshotMagic[4] = {'o','f','p','s'};
+static const unsigned int snapshotVersion = 1;
+
+// magic, version, layout hash, num values, values, num strings,
+// and every string as its length followed by its bytes
+void ofParameterSnapshot::saveToBuffer(ofBuffer & buffer) const{
+	unsigned int header[4] = {0, snapshotVersion, layoutHash, (unsigned int)values.size()};
+	memcpy(header, snapshotMagic, 4);
+	size_t size = sizeof(header) + values.size()*sizeof(float) + sizeof(unsigned int);
+	for(int i=0;i<(int)strings.size();i++){
+		size += sizeof(unsigned int) + strings[i].size();
+	}
+
+	vector<char> data(size);
+	char * out = &data[0];
+	memcpy(out, header, sizeof(header));
+	out += sizeof(header);
+	if(!values.empty()){
+		memcpy(out, &values[0], values.size()*sizeof(float));
+		out += values.size()*sizeof(float);
+	}
+	unsigned int numStrings = strings.size();
+	memcpy(out, &numStrings, sizeof(numStrings));
+	out += sizeof(numStrings);
+	for(int i=0;i<(int)strings.size();i++){
+		unsigned int length = strings[i].size();
+		memcpy(out, &length, sizeof(length));
+		out += sizeof(length);
+		memcpy(out, strings[i].c_str(), length);
+		out += length;
+	}
+	buffer.set(&data[0], data.size());
+}
+
+bool ofParameterSnapshot::loadFromBuffer(const ofBuffer & buffer){
+	const char * in = buffer.getBinaryBuffer();
+	const char * end = in + buffer.size();
+	unsigned int header[4];
+	if((size_t)buffer.size()<sizeof(header)){
+		ofLogError("ofParameterSnapshot") << "loadFromBuffer(): buffer too small";
+		return false;
+	}
+	memcpy(header, in, sizeof(header));
+	in += sizeof(header);
+	if(memcmp(header, snapshotMagic, 4)!=0 || header[1]!=snapshotVersion){
+		ofLogError("ofParameterSnapshot") << "loadFromBuffer(): not a snapshot or unsupported version";
+		return false;
+	}
+
+	// check the count against the data before allocating anything
+	unsigned int numStrings;
+	size_t available = end-in;
+	if(available < sizeof(numStrings) || (available - sizeof(numStrings))/sizeof(float) < header[3]){
+		ofLogError("ofParameterSnapshot") << "loadFromBuffer(): truncated snapshot";
+		return false;
+	}
+	vector<float> newValues(header[3]);
+	if(!newValues.empty()){
+		memcpy(&newValues[0], in, newValues.size()*sizeof(float));
+		in += newValues.size()*sizeof(float);
+	}
+	memcpy(&numStrings, in, sizeof(numStrings));
+	in += sizeof(numStrings);
+
+	vector<string> newStrings;
+	for(unsigned int i=0;i<numStrings;i++){
+		unsigned int length;
+		if((size_t)(end-in) < sizeof(length)){
+			ofLogError("ofParameterSnapshot") << "loadFromBuffer(): truncated snapshot";
+			return false;
+		}
+		memcpy(&length, in, sizeof(length));
+		in += sizeof(length);
+		if((size_t)(end-in) < length){
+			ofLogError("ofParameterSnapshot") << "loadFromBuffer(): truncated snapshot";
+			return false;
+		}
+		newStrings.push_back(string(in, length));
+		in += length;
+	}
+
+	layoutHash = header[2];
+	values.swap(newValues);
+	strings.swap(newStrings);
+	return true;
+}
@@ -14,6 +14,45 @@
 #include "ofLog.h"
 #include "ofParameter.h"
 
+class ofBuffer;
+
+// the values of all the parameters in a group at some moment, to store
+// presets and interpolate between them fast.
+//
+// the float and int parameters of the group and all its subgroups are
+// stored as a flat array of floats in the order they appear in the group,
+// the rest of the parameters as strings. only serializable parameters are
+// included. ints are stored as floats so they are exact up to 2^24
+//
+// Info:
+// a snapshot can only be applied to a group with the same layout, the same
+// names and types in the same order, see ofParameterGroup::getSnapshot()
+// the binary format is native endian, it's meant for presets saved and
+// loaded on the same platform
+
+class ofParameterSnapshot{
+public:
+	ofParameterSnapshot();
+
+	// the flat view of the numeric parameters, can be modified and
+	// applied back with ofParameterGroup::setSnapshot()
+	vector<float> & getValues();
+	const vector<float> & getValues() const;
+	int size() const;
+
+	// identifies the layout of the group the snapshot was taken from
+	unsigned int getLayoutHash() const;
+
+	void saveToBuffer(ofBuffer & buffer) const;
+	bool loadFromBuffer(const ofBuffer & buffer);
+
+private:
+	friend class ofParameterGroup;
+	vector<float> values;
+	vector<string> strings;
+	unsigned int layoutHash;
+};
+
 class ofParameterGroup: public ofAbstractParameter {
 public:
 	ofParameterGroup();
@@ -97,16 +136,58 @@ public:
 	void setSerializable(bool serializable);
 	bool isSerializable() const;
 
+	// presets, see ofParameterSnapshot. setSnapshot and lerp set the values
+	// without notifying each parameter and notify the snapshot listeners
+	// once if anything changed. with bNotifyParameters the parameters that changed
+	// also notify their own events, slower but listeners like guis
+	// are updated. lerp only interpolates the numeric parameters, ints are
+	// rounded. they return false if a snapshot doesn't match the group
+	void getSnapshot(ofParameterSnapshot & snapshot) const;
+	bool setSnapshot(const ofParameterSnapshot & snapshot, bool bNotifyParameters=false);
+	bool lerp(const ofParameterSnapshot & from, const ofParameterSnapshot & to, float t, bool bNotifyParameters=false);
+	int getNumNumericParameters() const;
+
+	// listeners are shared by all the copies of the group, like the
+	// listeners of a parameter, so groups returned by getGroup() or kept
+	// by a gui notify the listeners of the original
+	template<class ListenerClass, typename ListenerMethod>
+	void addSnapshotListener(ListenerClass * listener, ListenerMethod method){
+		ofAddListener(obj->snapshotAppliedE,listener,method);
+	}
+
+	template<class ListenerClass, typename ListenerMethod>
+	void removeSnapshotListener(ListenerClass * listener, ListenerMethod method){
+		ofRemoveListener(obj->snapshotAppliedE,listener,method);
+	}
+
 private:
 	class Value{
 	public:
-		Value():serializable(true){}
+		Value()
+		:serializable(true)
+		,layoutHash(0)
+		,layoutVersion(-1){}
 
 		map<string,int> parametersIndex;
 		vector<ofAbstractParameter*> parameters;
 		string name;
 		bool serializable;
+		ofEvent<ofParameterGroup> snapshotAppliedE;
+
+		// flattened parameters of the group and its subgroups for the
+		// snapshots, rebuilt when any group changes its structure
+		vector<ofAbstractParameter*> numericParameters;
+		vector<bool> numericIsInt;
+		vector<ofAbstractParameter*> otherParameters;
+		vector<float> lerpValues;
+		unsigned int layoutHash;
+		int layoutVersion;
 	};
+
+	void updateLayout() const;
+	void flattenInto(Value & layout, const string & prefix) const;
+	bool applyValues(const vector<float> & values, bool bNotifyParameters);
+
 	ofPtr<Value> obj;
 };
 
@@ -128,6 +209,7 @@ void ofParameterGroup::add(ofParameter<ParameterType> param){
 	obj->parameters.push_back(p);
 	obj->parametersIndex[p->getEscapedName()] = obj->parameters.size()-1;
 	p->setParent(this);
+	structureVersion++;
 }
 
 template<typename ParameterType,typename Friend>
@@ -137,5 +219,6 @@ void ofParameterGroup::add(ofReadOnlyParameter<ParameterType,Friend> & param){
 	obj->parameters.push_back(p);
 	obj->parametersIndex[p->getEscapedName()] = obj->parameters.size()-1;
 	p->setParent(this);
+	structureVersion++;
 }
 #endif /* OFXPARAMETERGROUP_H_ */
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "ofParameter.h"
+#include "Poco/AtomicCounter.h"
+
+// a copy of a parameter that can be read from another thread, usually the
+// audio thread, while the parameter is being modified from the main thread
+// (by a gui for example) without locks, so the audio thread never waits
+// for the main thread.
+//
+// ofParameterMirror<float> volumeMirror;
+// volumeMirror.setup(volume);
+// ...
+// void testApp::audioOut(float * output, int bufferSize, int nChannels){
+//     volumeMirror.update();
+//     float v = volumeMirror;
+//     ...
+// }
+//
+// Info:
+// every change of the parameter is published to a small ring of slots
+// with a sequence counter each, the reader copies the last published slot
+// and checks that it wasn't overwritten meanwhile. if it was the copy keeps
+// its previous value until the next update(), neither side ever blocks.
+// only for types that can be copied as plain memory: numbers, bool,
+// ofVec*, ofColor... not strings
+// the parameter must be modified from one thread only, the mirror can be
+// read from one thread only, the one calling update()
+// update() returns true once per call with the last value even if the
+// parameter changed several times since the last update, so calling it once
+// per audio buffer coalesces all the changes in that buffer in one change.
+// there's no event for it: notifying an ofEvent locks a mutex and can
+// allocate, poll the result of update() in the audio thread or listen to the
+// parameter itself in the main thread instead
+// changes made without events, like ofParameterGroup::setSnapshot() without
+// bNotifyParameters, aren't seen by the mirror, call publish() after them
+
+template<typename ParameterType>
+class ofParameterMirror{
+public:
+	ofParameterMirror();
+	~ofParameterMirror();
+
+	void setup(ofParameter<ParameterType> & parameter);
+	void close();
+
+	// writing thread, publishes the current value of the parameter
+	void publish();
+
+	// reading thread, takes the last published value. returns true if the
+	// value changed since the last call
+	bool update();
+	const ParameterType & get() const;
+	operator const ParameterType & () const;
+
+private:
+	ofParameterMirror(const ofParameterMirror<ParameterType> &);
+	ofParameterMirror<ParameterType> & operator=(const ofParameterMirror<ParameterType> &);
+
+	void parameterChanged(ParameterType & value);
+	void publish(const ParameterType & value);
+
+	static const int NumSlots = 4;
+	struct Slot{
+		ParameterType value;
+		Poco::AtomicCounter sequence;	// odd while the slot is being written
+	};
+
+	ofParameter<ParameterType> parameter;
+	Slot slots[NumSlots];
+	Poco::AtomicCounter numPublished;
+	Poco::AtomicCounter fence;			// incremented only as a memory barrier by the reader
+	int numRead;
+	ParameterType value;
+	bool bSetup;
+};
+
+
+template<typename ParameterType>
+ofParameterMirror<ParameterType>::ofParameterMirror()
+:numRead(0)
+,value()
+,bSetup(false){
+}
+
+template<typename ParameterType>
+ofParameterMirror<ParameterType>::~ofParameterMirror(){
+	close();
+}
+
+template<typename ParameterType>
+void ofParameterMirror<ParameterType>::setup(ofParameter<ParameterType> & _parameter){
+	close();
+	parameter.makeReferenceTo(_parameter);
+	value = parameter.get();
+	numRead = numPublished.value();
+	parameter.addListener(this,&ofParameterMirror<ParameterType>::parameterChanged);
+	bSetup = true;
+}
+
+template<typename ParameterType>
+void ofParameterMirror<ParameterType>::close(){
+	if(!bSetup) return;
+	parameter.removeListener(this,&ofParameterMirror<ParameterType>::parameterChanged);
+	bSetup = false;
+}
+
+template<typename ParameterType>
+void ofParameterMirror<ParameterType>::publish(){
+	publish(parameter.get());
+}
+
+template<typename ParameterType>
+void ofParameterMirror<ParameterType>::parameterChanged(ParameterType & value){
+	publish(value);
+}
+
+template<typename ParameterType>
+void ofParameterMirror<ParameterType>::publish(const ParameterType & newValue){
+	// the atomic increments are full barriers, the value is written
+	// between the two so a reader that sees the same even sequence
+	// before and after copying it got a complete value
+	Slot & slot = slots[(unsigned int)numPublished.value() % NumSlots];
+	++slot.sequence;
+	slot.value = newValue;
+	++slot.sequence;
+	++numPublished;
+}
+
+template<typename ParameterType>
+bool ofParameterMirror<ParameterType>::update(){
+	int published = numPublished.value();
+	if(published==numRead) return false;
+
+	Slot & slot = slots[(unsigned int)(published-1) % NumSlots];
+	int before = slot.sequence.value();
+	if(before % 2) return false;
+	++fence;
+	ParameterType newValue = slot.value;
+	++fence;
+	if(slot.sequence.value()!=before){
+		// the writer went around the ring while copying, try again in
+		// the next update
+		return false;
+	}
+	numRead = published;
+
+	if(newValue==value) return false;
+	value = newValue;
+	return true;
+}
+
+template<typename ParameterType>
+inline const ParameterType & ofParameterMirror<ParameterType>::get() const{
+	return value;
+}
+
+template<typename ParameterType>
+inline ofParameterMirror<ParameterType>::operator const ParameterType & () const{
+	return value;
+}
@@ -472,6 +472,8 @@ enum ofPixelFormat{
 	OF_PIXELS_RGBA,
 	OF_PIXELS_BGRA,
 	OF_PIXELS_RGB565,
+	OF_PIXELS_I420,		// planar yuv 4:2:0, y plane then u and v planes
+	OF_PIXELS_NV12,		// planar yuv 4:2:0, y plane then interleaved uv plane
 	OF_PIXELS_UNKNOWN
 };
 
@@ -0,0 +1,308 @@
+#include "ofDirectoryWatcher.h"
+#include "ofUtils.h"
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+	#define OF_DIRECTORY_WATCHER_INOTIFY
+	#include <sys/inotify.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <errno.h>
+#endif
+
+//----------------------------------------------------------
+ofDirectoryWatcher::ofDirectoryWatcher()
+:recursive(true)
+,showHidden(false)
+,bListening(false)
+,pollingIntervalMs(1000)
+,inotifyFd(-1){
+}
+
+//----------------------------------------------------------
+ofDirectoryWatcher::~ofDirectoryWatcher(){
+	close();
+}
+
+//----------------------------------------------------------
+bool ofDirectoryWatcher::setup(string path, bool _recursive){
+	close();
+
+	dir.open(path);
+	if(!dir.exists() || !dir.isDirectory()){
+		ofLogError("ofDirectoryWatcher") << "setup(): \"" << path << "\" is not a directory";
+		return false;
+	}
+	dir.setShowHidden(showHidden);
+	originalDirectory = dir.getOriginalDirectory();
+	absPath = ofFilePath::addTrailingSlash(dir.getAbsolutePath());
+	recursive = _recursive;
+
+#ifdef OF_DIRECTORY_WATCHER_INOTIFY
+	inotifyFd = inotify_init();
+	if(inotifyFd<0){
+		ofLogError("ofDirectoryWatcher") << "setup(): couldn't init inotify: " << strerror(errno) << ", polling instead";
+	}else if(recursive){
+		addWatchRecursive("",false);
+	}else{
+		addWatch("");
+	}
+#endif
+	if(inotifyFd<0){
+		takeSnapshot(snapshot);
+	}
+
+	ofAddListener(ofEvents().update,this,&ofDirectoryWatcher::update);
+	bListening = true;
+	startThread(true,false);
+	return true;
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::close(){
+	if(isThreadRunning()){
+		waitForThread(true);
+	}
+	if(bListening){
+		ofRemoveListener(ofEvents().update,this,&ofDirectoryWatcher::update);
+		bListening = false;
+	}
+#ifdef OF_DIRECTORY_WATCHER_INOTIFY
+	if(inotifyFd>=0){
+		::close(inotifyFd);
+	}
+#endif
+	inotifyFd = -1;
+	watches.clear();
+	snapshot.clear();
+	lock();
+	events.clear();
+	unlock();
+}
+
+//----------------------------------------------------------
+string ofDirectoryWatcher::getPath(){
+	return originalDirectory;
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::setShowHidden(bool _showHidden){
+	showHidden = _showHidden;
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::setPollingIntervalMs(int ms){
+	pollingIntervalMs = max(ms,1);
+}
+
+//----------------------------------------------------------
+bool ofDirectoryWatcher::isPolling(){
+	return inotifyFd<0;
+}
+
+//----------------------------------------------------------
+bool ofDirectoryWatcher::isIgnored(const string & name){
+	return !showHidden && !name.empty() && name[0]=='.';
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::queueEvent(ofDirectoryWatcherEventArgs::Type type, const string & path, bool isDirectory){
+	ofDirectoryWatcherEventArgs args;
+	args.type = type;
+	args.path = originalDirectory + path;
+	args.isDirectory = isDirectory;
+	lock();
+	events.push_back(args);
+	unlock();
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::threadedFunction(){
+	while(isThreadRunning()){
+		if(inotifyFd>=0){
+			readNotifications();
+		}else{
+			sleep(pollingIntervalMs);
+			if(isThreadRunning()) poll();
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::update(ofEventArgs &){
+	lock();
+	deque<ofDirectoryWatcherEventArgs> pending;
+	pending.swap(events);
+	unlock();
+
+	for(int i=0;i<(int)pending.size();i++){
+		ofDirectoryWatcherEventArgs & event = pending[i];
+		// a file being saved can generate the same event several times
+		bool repeated = false;
+		for(int j=0;j<i && !repeated;j++){
+			repeated = pending[j].type==event.type && pending[j].path==event.path;
+		}
+		if(repeated) continue;
+		switch(event.type){
+		case ofDirectoryWatcherEventArgs::Created:
+			ofNotifyEvent(fileCreated,event,this);
+			break;
+		case ofDirectoryWatcherEventArgs::Modified:
+			ofNotifyEvent(fileModified,event,this);
+			break;
+		case ofDirectoryWatcherEventArgs::Deleted:
+			ofNotifyEvent(fileDeleted,event,this);
+			break;
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::addWatch(const string & relDir){
+#ifdef OF_DIRECTORY_WATCHER_INOTIFY
+	uint32_t mask = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+	int wd = inotify_add_watch(inotifyFd, (absPath + relDir).c_str(), mask);
+	if(wd<0){
+		ofLogWarning("ofDirectoryWatcher") << "couldn't watch \"" << absPath + relDir << "\": " << strerror(errno);
+		return;
+	}
+	watches[wd] = relDir;
+#endif
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::addWatchRecursive(const string & relDir, bool bNotifyCreated){
+	addWatch(relDir);
+	ofDirectory subdir;
+	subdir.setShowHidden(showHidden);
+	subdir.open(absPath + relDir);
+	vector<ofDirectoryEntry> entries;
+	subdir.scan(entries, recursive, 1);
+	for(int i=0;i<(int)entries.size();i++){
+		string relPath = relDir + entries[i].path.substr(subdir.getOriginalDirectory().size());
+		if(entries[i].isDirectory){
+			addWatch(relPath + "/");
+		}
+		// files created in a new directory before it was watched
+		if(bNotifyCreated){
+			queueEvent(ofDirectoryWatcherEventArgs::Created, relPath, entries[i].isDirectory);
+			if(!entries[i].isDirectory){
+				queueEvent(ofDirectoryWatcherEventArgs::Modified, relPath, false);
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::removeWatchRecursive(const string & relDir){
+#ifdef OF_DIRECTORY_WATCHER_INOTIFY
+	// a directory moved out would keep notifying with its old path
+	map<int,string>::iterator it = watches.begin();
+	while(it!=watches.end()){
+		if(it->second.compare(0,relDir.size(),relDir)==0){
+			inotify_rm_watch(inotifyFd, it->first);
+			watches.erase(it++);
+		}else{
+			++it;
+		}
+	}
+#endif
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::readNotifications(){
+#ifdef OF_DIRECTORY_WATCHER_INOTIFY
+	// wait with a timeout so the thread can be stopped
+	struct pollfd pfd;
+	pfd.fd = inotifyFd;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	if(::poll(&pfd,1,100)<=0) return;
+
+	char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+	ssize_t len = read(inotifyFd, buffer, sizeof(buffer));
+	if(len<=0) return;
+
+	for(char * ptr = buffer; ptr < buffer + len; ptr += sizeof(struct inotify_event) + ((struct inotify_event *)ptr)->len){
+		const struct inotify_event * event = (const struct inotify_event *)ptr;
+		if(event->mask & IN_Q_OVERFLOW){
+			ofLogWarning("ofDirectoryWatcher") << "too many changes at once, some events were lost";
+			continue;
+		}
+		map<int,string>::iterator watch = watches.find(event->wd);
+		if(watch==watches.end()) continue;
+		if(event->mask & IN_IGNORED){
+			watches.erase(watch);
+			continue;
+		}
+		if(event->len==0) continue;
+
+		string name = event->name;
+		if(isIgnored(name)) continue;
+		string relPath = watch->second + name;
+		bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+		if(event->mask & (IN_CREATE | IN_MOVED_TO)){
+			queueEvent(ofDirectoryWatcherEventArgs::Created, relPath, isDirectory);
+			if(isDirectory && recursive){
+				addWatchRecursive(relPath + "/", true);
+			}
+			// a file moved in is complete, there won't be a close after
+			// writing it, notify it like polling does
+			if(!isDirectory && (event->mask & IN_MOVED_TO)){
+				queueEvent(ofDirectoryWatcherEventArgs::Modified, relPath, false);
+			}
+		}
+		if(event->mask & IN_CLOSE_WRITE){
+			queueEvent(ofDirectoryWatcherEventArgs::Modified, relPath, false);
+		}
+		if(event->mask & (IN_DELETE | IN_MOVED_FROM)){
+			queueEvent(ofDirectoryWatcherEventArgs::Deleted, relPath, isDirectory);
+			if(isDirectory && recursive){
+				removeWatchRecursive(relPath + "/");
+			}
+		}
+	}
+#endif
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::takeSnapshot(map<string,Snapshot> & newSnapshot){
+	newSnapshot.clear();
+	vector<ofDirectoryEntry> entries;
+	dir.scan(entries, recursive, 1);
+	for(int i=0;i<(int)entries.size();i++){
+		Snapshot & entry = newSnapshot[entries[i].path.substr(originalDirectory.size())];
+		entry.isDirectory = entries[i].isDirectory;
+		entry.size = entries[i].size;
+		entry.lastModified = entries[i].lastModified;
+	}
+}
+
+//----------------------------------------------------------
+void ofDirectoryWatcher::poll(){
+	map<string,Snapshot> newSnapshot;
+	takeSnapshot(newSnapshot);
+
+	// both maps are sorted, walk them together
+	map<string,Snapshot>::iterator prev = snapshot.begin();
+	map<string,Snapshot>::iterator next = newSnapshot.begin();
+	while(prev!=snapshot.end() || next!=newSnapshot.end()){
+		if(next==newSnapshot.end() || (prev!=snapshot.end() && prev->first < next->first)){
+			queueEvent(ofDirectoryWatcherEventArgs::Deleted, prev->first, prev->second.isDirectory);
+			++prev;
+		}else if(prev==snapshot.end() || next->first < prev->first){
+			queueEvent(ofDirectoryWatcherEventArgs::Created, next->first, next->second.isDirectory);
+			if(!next->second.isDirectory){
+				queueEvent(ofDirectoryWatcherEventArgs::Modified, next->first, false);
+			}
+			++next;
+		}else{
+			if(!next->second.isDirectory && (next->second.size!=prev->second.size || next->second.lastModified!=prev->second.lastModified)){
+				queueEvent(ofDirectoryWatcherEventArgs::Modified, next->first, false);
+			}
+			++prev;
+			++next;
+		}
+	}
+	snapshot.swap(newSnapshot);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <deque>
+#include <map>
+
+#include "ofConstants.h"
+#include "ofEvents.h"
+#include "ofThread.h"
+#include "ofFileUtils.h"
+
+//-----------------------------------------------
+class ofDirectoryWatcherEventArgs : public ofEventArgs {
+public:
+	enum Type{
+		Created,
+		Modified,
+		Deleted
+	} type;
+	string path;			// the watched directory path + the path inside it
+	bool isDirectory;
+};
+
+// notifies when files are created, modified or deleted inside a directory
+// and, if recursive, its subdirectories. on linux it's notified by the
+// kernel through inotify without polling, on other platforms the
+// directory is scanned periodically. the events are notified in the main
+// thread during update, so they can be used to reload assets:
+//
+// watcher.setup("shaders");
+// ofAddListener(watcher.fileModified,this,&testApp::shaderModified);
+//
+// void testApp::shaderModified(ofDirectoryWatcherEventArgs & args){
+//     if(ofFilePath::getFileExt(args.path)=="frag") shader.load("shaders/shader");
+// }
+//
+// Info:
+// modified is notified when a file that was open for writing is closed, so
+// files are complete by then. a new file gets created and then modified
+// moving a file into the directory is notified as created and modified,
+// like a new file, out of it as deleted. repeated events for a file in the
+// same frame are merged
+// hidden files, like the temporary files of many editors, are ignored
+// unless setShowHidden(true) is called before setup
+
+class ofDirectoryWatcher: public ofThread{
+public:
+	ofDirectoryWatcher();
+	virtual ~ofDirectoryWatcher();
+
+	bool setup(string path, bool recursive = true);
+	void close();
+
+	string getPath();
+	void setShowHidden(bool showHidden);
+
+	// only used on platforms without native notifications, 1s by default
+	void setPollingIntervalMs(int ms);
+	bool isPolling();
+
+	ofEvent<ofDirectoryWatcherEventArgs> fileCreated;
+	ofEvent<ofDirectoryWatcherEventArgs> fileModified;
+	ofEvent<ofDirectoryWatcherEventArgs> fileDeleted;
+
+protected:
+	void threadedFunction();
+	void update(ofEventArgs & args);  // notify in update so the notification is thread safe
+
+private:
+	ofDirectoryWatcher(const ofDirectoryWatcher &);
+	ofDirectoryWatcher & operator=(const ofDirectoryWatcher &);
+
+	void queueEvent(ofDirectoryWatcherEventArgs::Type type, const string & path, bool isDirectory);
+	bool isIgnored(const string & name);
+
+	// inotify
+	void addWatch(const string & relDir);
+	void addWatchRecursive(const string & relDir, bool bNotifyCreated);
+	void removeWatchRecursive(const string & relDir);
+	void readNotifications();
+
+	// polling
+	struct Snapshot{
+		bool isDirectory;
+		uint64_t size;
+		time_t lastModified;
+	};
+	void takeSnapshot(map<string,Snapshot> & snapshot);
+	void poll();
+
+	ofDirectory dir;
+	string originalDirectory;
+	string absPath;
+	bool recursive;
+	bool showHidden;
+	bool bListening;
+	int pollingIntervalMs;
+	deque<ofDirectoryWatcherEventArgs> events;
+
+	int inotifyFd;
+	map<int,string> watches;
+	map<string,Snapshot> snapshot;
+};
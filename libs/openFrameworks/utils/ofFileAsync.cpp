@@ -0,0 +1,397 @@
+#include "ofFileAsync.h"
+#include "ofUtils.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+
+Poco::AtomicCounter ofFileAsyncResult::nextID;
+
+//----------------------------------------------------------
+ofEvent<ofFileAsyncEventArgs> & ofFileAsyncEvent(){
+	static ofEvent<ofFileAsyncEventArgs> * event = new ofEvent<ofFileAsyncEventArgs>;
+	return *event;
+}
+
+//----------------------------------------------------------
+ofFileAsyncResult::ofFileAsyncResult(const string & path, bool bWrite, bool binary)
+:id(nextID++)
+,path(path)
+,bWrite(bWrite)
+,binary(binary)
+,bDone(false)
+,bOk(false)
+,bCancelled(false){
+}
+
+//----------------------------------------------------------
+int ofFileAsyncResult::getID() const{
+	return id;
+}
+
+//----------------------------------------------------------
+const string & ofFileAsyncResult::getPath() const{
+	return path;
+}
+
+//----------------------------------------------------------
+bool ofFileAsyncResult::isWrite() const{
+	return bWrite;
+}
+
+//----------------------------------------------------------
+bool ofFileAsyncResult::isDone(){
+	ofMutex::ScopedLock lock(mutex);
+	return bDone;
+}
+
+//----------------------------------------------------------
+void ofFileAsyncResult::waitForDone(){
+	ofMutex::ScopedLock lock(mutex);
+	while(!bDone){
+		doneCondition.wait(mutex);
+	}
+}
+
+//----------------------------------------------------------
+bool ofFileAsyncResult::waitForDone(long timeoutMs){
+	ofMutex::ScopedLock lock(mutex);
+	unsigned long long start = ofGetSystemTime();
+	while(!bDone){
+		long remaining = timeoutMs - (long)(ofGetSystemTime() - start);
+		if(remaining<=0 || !doneCondition.tryWait(mutex,remaining)){
+			return bDone;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofFileAsyncResult::isOk(){
+	ofMutex::ScopedLock lock(mutex);
+	return bOk;
+}
+
+//----------------------------------------------------------
+bool ofFileAsyncResult::isCancelled(){
+	ofMutex::ScopedLock lock(mutex);
+	return bCancelled;
+}
+
+//----------------------------------------------------------
+string ofFileAsyncResult::getError(){
+	ofMutex::ScopedLock lock(mutex);
+	return error;
+}
+
+//----------------------------------------------------------
+ofBuffer & ofFileAsyncResult::getBuffer(){
+	return buffer;
+}
+
+//----------------------------------------------------------
+void ofFileAsyncResult::finish(bool _bOk, const string & _error){
+	ofMutex::ScopedLock lock(mutex);
+	bOk = _bOk;
+	error = _error;
+	bDone = true;
+	doneCondition.broadcast();
+}
+
+//----------------------------------------------------------
+void ofFileAsyncResult::cancel(){
+	ofMutex::ScopedLock lock(mutex);
+	bCancelled = true;
+	bOk = false;
+	error = "cancelled";
+	bDone = true;
+	doneCondition.broadcast();
+}
+
+//----------------------------------------------------------
+ofFileAsync::ofFileAsync()
+:numThreads(2)
+,numActive(0)
+,bListening(false){
+}
+
+//----------------------------------------------------------
+ofFileAsync::~ofFileAsync(){
+	stop();
+	if(bListening){
+		ofRemoveListener(ofEvents().update,this,&ofFileAsync::update);
+	}
+}
+
+//----------------------------------------------------------
+ofPtr<ofFileAsyncResult> ofFileAsync::read(const string & path, bool binary){
+	return add(new ofFileAsyncResult(ofToDataPath(path,true),false,binary));
+}
+
+//----------------------------------------------------------
+ofPtr<ofFileAsyncResult> ofFileAsync::write(const string & path, const ofBuffer & buffer, bool binary){
+	ofFileAsyncResult * request = new ofFileAsyncResult(ofToDataPath(path,true),true,binary);
+	request->buffer = buffer;
+	return add(request);
+}
+
+//----------------------------------------------------------
+ofPtr<ofFileAsyncResult> ofFileAsync::add(ofFileAsyncResult * request){
+	ofPtr<ofFileAsyncResult> result(request);
+	ofMutex::ScopedLock lock(mutex);
+	requests.push_back(result);
+	start();
+	requestAdded.signal();
+	return result;
+}
+
+//----------------------------------------------------------
+void ofFileAsync::start(){
+	if(!bListening){
+		ofAddListener(ofEvents().update,this,&ofFileAsync::update);
+		bListening = true;
+	}
+	while((int)workers.size()<numThreads){
+		workers.push_back(new Worker(*this));
+		workers.back()->startThread(true,false);
+	}
+}
+
+//----------------------------------------------------------
+bool ofFileAsync::cancel(int id){
+	ofMutex::ScopedLock lock(mutex);
+	for(int i=0;i<(int)requests.size();i++){
+		if(requests[i]->getID()==id){
+			requests[i]->cancel();
+			responses.push_back(requests[i]);
+			requests.erase(requests.begin()+i);
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+void ofFileAsync::waitForAll(){
+	ofMutex::ScopedLock lock(mutex);
+	while(!requests.empty() || numActive>0){
+		requestFinished.wait(mutex);
+	}
+}
+
+//----------------------------------------------------------
+int ofFileAsync::getNumPending(){
+	ofMutex::ScopedLock lock(mutex);
+	return requests.size() + numActive;
+}
+
+//----------------------------------------------------------
+void ofFileAsync::setNumThreads(int _numThreads){
+	_numThreads = max(1,_numThreads);
+	mutex.lock();
+	bool bShrink = _numThreads<(int)workers.size();
+	mutex.unlock();
+	if(bShrink){
+		// the workers finish their current request and the
+		// pending ones are picked up by the new pool
+		stopWorkers();
+	}
+	ofMutex::ScopedLock lock(mutex);
+	numThreads = _numThreads;
+	if(!requests.empty() || !workers.empty()) start();
+}
+
+//----------------------------------------------------------
+int ofFileAsync::getNumThreads(){
+	return numThreads;
+}
+
+//----------------------------------------------------------
+void ofFileAsync::stop(){
+	mutex.lock();
+	for(int i=0;i<(int)requests.size();i++){
+		requests[i]->cancel();
+		responses.push_back(requests[i]);
+	}
+	requests.clear();
+	requestFinished.broadcast();
+	mutex.unlock();
+	stopWorkers();
+}
+
+//----------------------------------------------------------
+void ofFileAsync::stopWorkers(){
+	// workers that aren't in the pool anymore exit once they finish
+	// their current request, new ones can start in the meantime
+	mutex.lock();
+	vector<Worker*> stopping;
+	stopping.swap(workers);
+	requestAdded.broadcast();
+	mutex.unlock();
+
+	for(int i=0;i<(int)stopping.size();i++){
+		stopping[i]->waitForThread(false);
+		delete stopping[i];
+	}
+}
+
+//----------------------------------------------------------
+bool ofFileAsync::waitForRequest(Worker * worker, ofPtr<ofFileAsyncResult> & request){
+	ofMutex::ScopedLock lock(mutex);
+	while(true){
+		if(find(workers.begin(),workers.end(),worker)==workers.end()) return false;
+		if(!requests.empty()) break;
+		requestAdded.wait(mutex);
+	}
+	request = requests.front();
+	requests.pop_front();
+	numActive++;
+	return true;
+}
+
+//----------------------------------------------------------
+void ofFileAsync::finished(ofPtr<ofFileAsyncResult> request){
+	ofMutex::ScopedLock lock(mutex);
+	numActive--;
+	responses.push_back(request);
+	// only waitForAll() waits on this, waking it for every request
+	// would cost a context switch per file
+	if(requests.empty() && numActive==0){
+		requestFinished.broadcast();
+	}
+}
+
+//----------------------------------------------------------
+void ofFileAsync::handleRequest(ofFileAsyncResult & request){
+	ios_base::openmode binaryMode = request.binary ? ios_base::binary : ios_base::openmode(0);
+	if(!request.bWrite){
+		ifstream istr(request.path.c_str(), ios_base::in | binaryMode);
+		if(!istr){
+			request.finish(false,"couldn't open \"" + request.path + "\" for reading");
+			return;
+		}
+		if(!request.buffer.set(istr) || istr.bad()){
+			request.finish(false,"couldn't read \"" + request.path + "\"");
+			return;
+		}
+		request.finish(true,"");
+	}else{
+		// write next to the destination and replace it once complete,
+		// every request has its own temporary file so concurrent writes
+		// to the same destination don't mix
+		string tmpPath = request.path + "." + ofToString(request.id) + ".tmp";
+		ofstream ostr(tmpPath.c_str(), ios_base::out | ios_base::trunc | binaryMode);
+		if(!ostr){
+			request.finish(false,"couldn't open \"" + tmpPath + "\" for writing");
+			return;
+		}
+		bool bWritten = request.buffer.writeTo(ostr);
+		ostr.close();
+		if(!bWritten || ostr.fail()){
+			try{
+				Poco::File(tmpPath).remove();
+			}catch(Poco::Exception &){
+			}
+			request.finish(false,"couldn't write \"" + tmpPath + "\"");
+			return;
+		}
+		string error;
+		if(!replace(tmpPath,request.path,error)){
+			try{
+				Poco::File(tmpPath).remove();
+			}catch(Poco::Exception &){
+			}
+			request.finish(false,"couldn't replace \"" + request.path + "\": " + error);
+			return;
+		}
+		// the data is on disk, no need to keep a copy around
+		request.buffer.clear();
+		request.finish(true,"");
+	}
+}
+
+//----------------------------------------------------------
+bool ofFileAsync::replace(const string & from, const string & to, string & error){
+#ifdef TARGET_WIN32
+	// rename fails on windows if the destination exists
+	if(!MoveFileExA(from.c_str(),to.c_str(),MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)){
+		error = "error " + ofToString((int)GetLastError());
+		return false;
+	}
+	return true;
+#else
+	try{
+		Poco::File(from).renameTo(to);
+		return true;
+	}catch(Poco::Exception & e){
+		error = e.displayText();
+		return false;
+	}
+#endif
+}
+
+//----------------------------------------------------------
+void ofFileAsync::update(ofEventArgs &){
+	mutex.lock();
+	while(!responses.empty()){
+		ofFileAsyncEventArgs args;
+		args.result = responses.front();
+		responses.pop_front();
+		mutex.unlock();
+		if(!args.result->isOk() && !args.result->isCancelled()){
+			ofLogError("ofFileAsync") << args.result->getError();
+		}
+		ofNotifyEvent(ofFileAsyncEvent(),args);
+		mutex.lock();
+	}
+	mutex.unlock();
+}
+
+//----------------------------------------------------------
+ofFileAsync::Worker::Worker(ofFileAsync & loader)
+:loader(loader){
+}
+
+//----------------------------------------------------------
+void ofFileAsync::Worker::threadedFunction(){
+	ofPtr<ofFileAsyncResult> request;
+	while(loader.waitForRequest(this,request)){
+		loader.handleRequest(*request);
+		loader.finished(request);
+		request.reset();
+	}
+}
+
+//----------------------------------------------------------
+static ofFileAsync & getFileAsync(){
+	static ofFileAsync * fileAsync = new ofFileAsync;
+	return *fileAsync;
+}
+
+//----------------------------------------------------------
+ofPtr<ofFileAsyncResult> ofBufferFromFileAsync(const string & path, bool binary){
+	return getFileAsync().read(path,binary);
+}
+
+//----------------------------------------------------------
+ofPtr<ofFileAsyncResult> ofBufferToFileAsync(const string & path, const ofBuffer & buffer, bool binary){
+	return getFileAsync().write(path,buffer,binary);
+}
+
+//----------------------------------------------------------
+bool ofCancelFileAsync(int id){
+	return getFileAsync().cancel(id);
+}
+
+//----------------------------------------------------------
+void ofWaitForFileAsync(){
+	getFileAsync().waitForAll();
+}
+
+//----------------------------------------------------------
+void ofSetFileAsyncNumThreads(int numThreads){
+	getFileAsync().setNumThreads(numThreads);
+}
+
+//----------------------------------------------------------
+void ofStopFileAsync(){
+	getFileAsync().stop();
+}
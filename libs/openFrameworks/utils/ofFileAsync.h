@@ -0,0 +1,162 @@
+#pragma once
+
+#include <deque>
+
+#include "ofThread.h"
+#include "ofEvents.h"
+#include "ofFileUtils.h"
+
+#include "Poco/Condition.h"
+#include "Poco/AtomicCounter.h"
+
+// reads and writes whole files in a pool of threads so loading big assets
+// or saving state doesn't stall the app.
+//
+// ofPtr<ofFileAsyncResult> result = ofBufferFromFileAsync("big.bin",true);
+// ...
+// if(result->isDone() && result->isOk()) process(result->getBuffer());
+//
+// the result works like a future, it can be polled or waited for from any
+// thread. when the app is running every result is also notified in the main
+// thread through ofFileAsyncEvent() during update, register with:
+//
+// ofRegisterFileAsyncNotification(this) and implement
+// void fileAsyncDone(ofFileAsyncEventArgs & args)
+//
+// requests removed with cancel() or stop() before they start are also
+// notified, with isCancelled() returning true
+//
+// Info:
+// writes go to a temporary file that replaces the destination once it's
+// complete, so a crash while saving never leaves a half written file.
+// concurrent writes to the same file each use their own temporary file,
+// the one that finishes last is the one that stays
+// the buffer passed to a write is copied so it can be modified right away
+
+class ofFileAsyncResult{
+public:
+	ofFileAsyncResult(const string & path, bool bWrite, bool binary);
+
+	int getID() const;
+	const string & getPath() const;
+	bool isWrite() const;
+
+	bool isDone();
+	void waitForDone();
+	// returns false if the timeout expires before it's done
+	bool waitForDone(long timeoutMs);
+
+	// only valid once done
+	bool isOk();
+	bool isCancelled();
+	string getError();
+
+	// the contents of the file for reads, only valid once done
+	ofBuffer & getBuffer();
+
+private:
+	ofFileAsyncResult(const ofFileAsyncResult &);
+	ofFileAsyncResult & operator=(const ofFileAsyncResult &);
+
+	friend class ofFileAsync;
+	void finish(bool bOk, const string & error);
+	void cancel();
+
+	int id;
+	string path;
+	ofBuffer buffer;
+	bool bWrite;
+	bool binary;
+	bool bDone;
+	bool bOk;
+	bool bCancelled;
+	string error;
+	ofMutex mutex;
+	Poco::Condition doneCondition;
+
+	static Poco::AtomicCounter nextID;
+};
+
+class ofFileAsyncEventArgs: public ofEventArgs{
+public:
+	ofPtr<ofFileAsyncResult> result;
+};
+
+ofPtr<ofFileAsyncResult> ofBufferFromFileAsync(const string & path, bool binary=false);
+ofPtr<ofFileAsyncResult> ofBufferToFileAsync(const string & path, const ofBuffer & buffer, bool binary=false);
+bool ofCancelFileAsync(int id);
+void ofWaitForFileAsync();
+void ofSetFileAsyncNumThreads(int numThreads);
+void ofStopFileAsync();
+
+ofEvent<ofFileAsyncEventArgs> & ofFileAsyncEvent();
+
+template<class T>
+void ofRegisterFileAsyncNotification(T * obj){
+	ofAddListener(ofFileAsyncEvent(),obj,&T::fileAsyncDone);
+}
+
+template<class T>
+void ofUnregisterFileAsyncNotification(T * obj){
+	ofRemoveListener(ofFileAsyncEvent(),obj,&T::fileAsyncDone);
+}
+
+
+class ofFileAsync{
+public:
+	ofFileAsync();
+	virtual ~ofFileAsync();
+
+	ofPtr<ofFileAsyncResult> read(const string & path, bool binary=false);
+	ofPtr<ofFileAsyncResult> write(const string & path, const ofBuffer & buffer, bool binary=false);
+
+	// removes a request that hasn't started yet, returns false if it
+	// already started or doesn't exist
+	bool cancel(int id);
+
+	// blocks until all the requests are done
+	void waitForAll();
+	int getNumPending();
+
+	// 2 threads by default, more help with many small files on ssds,
+	// big files on a single disk are usually faster with less
+	void setNumThreads(int numThreads);
+	int getNumThreads();
+
+	// waits for the requests being processed and cancels the rest
+	void stop();
+
+protected:
+	void update(ofEventArgs &);  // notify in update so the notification is thread safe
+
+private:
+	ofFileAsync(const ofFileAsync &);
+	ofFileAsync & operator=(const ofFileAsync &);
+
+	class Worker: public ofThread{
+	public:
+		Worker(ofFileAsync & loader);
+		void threadedFunction();
+		ofFileAsync & loader;
+	};
+
+	ofPtr<ofFileAsyncResult> add(ofFileAsyncResult * request);
+	void start();
+	void stopWorkers();
+	bool waitForRequest(Worker * worker, ofPtr<ofFileAsyncResult> & request);
+	void finished(ofPtr<ofFileAsyncResult> request);
+	void handleRequest(ofFileAsyncResult & request);
+	bool replace(const string & from, const string & to, string & error);
+
+	friend class Worker;
+
+	vector<Worker*> workers;
+	deque<ofPtr<ofFileAsyncResult> > requests;
+	deque<ofPtr<ofFileAsyncResult> > responses;
+	ofMutex mutex;
+	Poco::Condition requestAdded;
+	Poco::Condition requestFinished;
+	int numThreads;
+	int numActive;
+	bool bListening;
+};
@@ -1,9 +1,17 @@
 #include "ofFileUtils.h"
 #ifndef TARGET_WIN32
  #include <pwd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <dirent.h>
 #endif
 
 #include "ofUtils.h"
+#include "ofThread.h"
+#include "Poco/Condition.h"
+#include "Poco/Environment.h"
+#include <deque>
 
 
 #ifdef TARGET_OSX
@@ -18,6 +26,165 @@
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------
+// a read only file mapped copy on write, shared by the buffers that use it
+class ofBufferMapping{
+public:
+	ofBufferMapping()
+	:data(NULL)
+	,size(0){
+#ifdef TARGET_WIN32
+		mappingHandle = NULL;
+#endif
+	}
+
+	~ofBufferMapping(){
+		if(!data) return;
+#ifdef TARGET_WIN32
+		UnmapViewOfFile(data);
+		CloseHandle(mappingHandle);
+#else
+		munmap(data,size);
+#endif
+	}
+
+	bool map(const string & path){
+		// the buffer needs a 0 after the data, the rest of the last page
+		// is zeroed but if the size is a multiple of the page there's none
+#ifdef TARGET_WIN32
+		HANDLE file = CreateFileA(path.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+		if(file==INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER fileSize;
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		if(!GetFileSizeEx(file,&fileSize) || fileSize.QuadPart==0 || fileSize.QuadPart % info.dwPageSize == 0 || fileSize.QuadPart > LONG_MAX){
+			CloseHandle(file);
+			return false;
+		}
+		mappingHandle = CreateFileMappingA(file,NULL,PAGE_WRITECOPY,0,0,NULL);
+		CloseHandle(file);
+		if(!mappingHandle) return false;
+		data = (char*)MapViewOfFile(mappingHandle,FILE_MAP_COPY,0,0,0);
+		if(!data){
+			CloseHandle(mappingHandle);
+			mappingHandle = NULL;
+			return false;
+		}
+		size = fileSize.QuadPart;
+#else
+		int fd = ::open(path.c_str(),O_RDONLY);
+		if(fd<0) return false;
+		struct stat fileStat;
+		long pageSize = sysconf(_SC_PAGESIZE);
+		if(fstat(fd,&fileStat)!=0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size==0 || fileStat.st_size % pageSize == 0 || fileStat.st_size > LONG_MAX){
+			::close(fd);
+			return false;
+		}
+		void * mapped = mmap(NULL,fileStat.st_size,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+		::close(fd);
+		if(mapped==MAP_FAILED) return false;
+		data = (char*)mapped;
+		size = fileStat.st_size;
+#endif
+		return true;
+	}
+
+	char * data;
+	long size;
+
+private:
+#ifdef TARGET_WIN32
+	HANDLE mappingHandle;
+#endif
+};
+
+//--------------------------------------------------
+ofBufferView::ofBufferView()
+:data("")
+,length(0){
+}
+
+//--------------------------------------------------
+ofBufferView::ofBufferView(const char * _data, long _size)
+:data(_data)
+,length(_size){
+}
+
+//--------------------------------------------------
+const char * ofBufferView::getBinaryBuffer() const{
+	return data;
+}
+
+//--------------------------------------------------
+long ofBufferView::size() const{
+	return length;
+}
+
+//--------------------------------------------------
+bool ofBufferView::empty() const{
+	return length==0;
+}
+
+//--------------------------------------------------
+string ofBufferView::getText() const{
+	return string(data,length);
+}
+
+//--------------------------------------------------
+ofBufferView::operator string() const{
+	return getText();
+}
+
+//--------------------------------------------------
+ofBufferView ofBufferView::slice(long offset, long _size) const{
+	offset = max(0L,min(offset,length));
+	if(_size<0 || offset+_size>length){
+		_size = length - offset;
+	}
+	return ofBufferView(data+offset,_size);
+}
+
+//--------------------------------------------------
+const char * ofBufferView::begin() const{
+	return data;
+}
+
+//--------------------------------------------------
+const char * ofBufferView::end() const{
+	return data+length;
+}
+
+//--------------------------------------------------
+char ofBufferView::operator[](long i) const{
+	return data[i];
+}
+
+//--------------------------------------------------
+bool ofBufferView::operator==(const ofBufferView & other) const{
+	return length==other.length && memcmp(data,other.data,length)==0;
+}
+
+//--------------------------------------------------
+bool ofBufferView::operator!=(const ofBufferView & other) const{
+	return !(*this==other);
+}
+
+//--------------------------------------------------
+bool ofBufferView::operator==(const string & text) const{
+	return length==(long)text.size() && memcmp(data,text.c_str(),length)==0;
+}
+
+//--------------------------------------------------
+bool ofBufferView::operator!=(const string & text) const{
+	return !(*this==text);
+}
+
+//--------------------------------------------------
+ostream & operator<<(ostream & ostr, const ofBufferView & view){
+	ostr.write(view.data,view.length);
+	return ostr;
+}
+
 //--------------------------------------------------
 ofBuffer::ofBuffer(){
 	nextLinePos = 0;
@@ -42,14 +209,34 @@ ofBuffer::ofBuffer(istream & stream){
 //--------------------------------------------------
 ofBuffer::ofBuffer(const ofBuffer & buffer_){
 	buffer = buffer_.buffer;
+	mapping = buffer_.mapping;
 	nextLinePos = buffer_.nextLinePos;
 }
 
+//--------------------------------------------------
+ofBuffer & ofBuffer::operator=(const ofBuffer & buffer_){
+	if(this!=&buffer_){
+		buffer = buffer_.buffer;
+		mapping = buffer_.mapping;
+		nextLinePos = buffer_.nextLinePos;
+	}
+	return *this;
+}
+
 //--------------------------------------------------
 ofBuffer::~ofBuffer(){
 	clear();
 }
 
+//--------------------------------------------------
+void ofBuffer::unmap(bool bKeepData){
+	if(!mapping) return;
+	if(bKeepData){
+		buffer.assign(mapping->data,mapping->data+mapping->size+1);
+	}
+	mapping.reset();
+}
+
 //--------------------------------------------------
 bool ofBuffer::set(istream & stream){
 	clear();
@@ -57,36 +244,78 @@ bool ofBuffer::set(istream & stream){
 		return false;
 	}
 
-	char aux_buffer[1024];
+	// if the stream knows its size read it all at once,
+	// in text mode it can be less than the size in bytes
 	std::streamsize size = 0;
-	stream.read(aux_buffer, 1024);
-	std::streamsize n = stream.gcount();
-	while(n > 0){
+	std::streamsize expected = 0;
+	std::streampos start = stream.tellg();
+	if(start!=std::streampos(-1)){
+		stream.seekg(0, ios_base::end);
+		std::streampos end = stream.tellg();
+		if(stream && end!=std::streampos(-1)){
+			expected = end - start;
+		}
+		stream.clear(stream.rdstate() & ~ios_base::failbit);
+		stream.seekg(start);
+	}
+	if(expected>0){
 		// we resize to size+1 initialized to 0 to have a 0 at the end for strings
-		buffer.resize(size + n + 1, 0);
-		memcpy(&(buffer[0]) + size, aux_buffer, n);
+		buffer.resize(expected + 1, 0);
+		stream.read(&buffer[0], expected);
+		size = stream.gcount();
+	}
+
+	// streams without size or that grew since, read in chunks
+	const std::streamsize chunkSize = 64*1024;
+	bool bComplete = expected>0 && size==expected && stream.peek()==char_traits<char>::eof();
+	while(stream && !bComplete){
+		buffer.resize(size + chunkSize + 1);
+		stream.read(&buffer[0] + size, chunkSize);
+		std::streamsize n = stream.gcount();
+		if(n<=0) break;
 		size += n;
-		if(stream){
-			stream.read(aux_buffer, 1024);
-			n = stream.gcount();
-		}
-		else{n = 0;
-		}
 	}
+	buffer.resize(size + 1);
+	buffer.back() = 0;
 	return true;
 }
 
+//--------------------------------------------------
+bool ofBuffer::setFromMappedFile(const string & path, bool bRelativeToData){
+	clear();
+	string absPath = bRelativeToData ? ofToDataPath(path,true) : path;
+	ofPtr<ofBufferMapping> newMapping(new ofBufferMapping);
+	if(newMapping->map(absPath)){
+		buffer.clear();
+		mapping = newMapping;
+		return true;
+	}
+	// empty, special or page aligned files
+	ifstream istr(absPath.c_str(), ifstream::binary);
+	if(!istr){
+		ofLogError("ofBuffer") << "setFromMappedFile(): couldn't open \"" << absPath << "\"";
+		return false;
+	}
+	return set(istr);
+}
+
+//--------------------------------------------------
+bool ofBuffer::isMapped() const{
+	return mapping;
+}
+
 //--------------------------------------------------
 bool ofBuffer::writeTo(ostream & stream) const {
 	if(stream.bad()){
 		return false;
 	}
-	stream.write(&(buffer[0]), buffer.size() - 1);
+	stream.write(getBinaryBuffer(), size());
 	return true;
 }
 
 //--------------------------------------------------
 void ofBuffer::set(const char * _buffer, unsigned int _size){
+	unmap(false);
 	buffer.assign(_buffer,_buffer+_size);
 	buffer.resize(buffer.size()+1);
 	buffer.back() = 0;
@@ -104,12 +333,14 @@ void ofBuffer::append(const string& _buffer){
 
 //--------------------------------------------------
 void ofBuffer::append(const char * _buffer, unsigned int _size){
+	unmap(true);
 	buffer.insert(buffer.end()-1,_buffer,_buffer+_size);
 	buffer.back() = 0;
 }
 
 //--------------------------------------------------
 void ofBuffer::clear(){
+	unmap(false);
 	buffer.resize(1);
 	nextLinePos = 0;
 }
@@ -122,6 +353,13 @@ void ofBuffer::allocate(long _size){
 
 //--------------------------------------------------
 char *ofBuffer::getBinaryBuffer(){
+	if(mapping){
+		// copies share the mapping, modifying it would modify all of them
+		if(mapping.unique()){
+			return mapping->data;
+		}
+		unmap(true);
+	}
 	if(buffer.empty()){
 		return NULL;
 	}
@@ -130,6 +368,9 @@ char *ofBuffer::getBinaryBuffer(){
 
 //--------------------------------------------------
 const char *ofBuffer::getBinaryBuffer() const {
+	if(mapping){
+		return mapping->data;
+	}
 	if(buffer.empty()){
 		return "";
 	}
@@ -138,10 +379,10 @@ const char *ofBuffer::getBinaryBuffer() const {
 
 //--------------------------------------------------
 string ofBuffer::getText() const {
-	if(buffer.empty()){
+	if(!mapping && buffer.empty()){
 		return "";
 	}
-	return &buffer[0];
+	return getBinaryBuffer();
 }
 
 //--------------------------------------------------
@@ -157,6 +398,9 @@ ofBuffer & ofBuffer::operator=(const string & text){
 
 //--------------------------------------------------
 long ofBuffer::size() const {
+	if(mapping){
+		return mapping->size;
+	}
 	if(buffer.empty()){
 		return 0;
 	}
@@ -164,15 +408,22 @@ long ofBuffer::size() const {
 	return buffer.size() - 1;
 }
 
+//--------------------------------------------------
+ofBufferView ofBuffer::getView(long offset, long _size) const{
+	return ofBufferView(getBinaryBuffer(),size()).slice(offset,_size);
+}
+
 //--------------------------------------------------
 string ofBuffer::getNextLine(){
-	if(buffer.empty() || (int)(buffer.size() - 1) == nextLinePos){
+	const char * data = getBinaryBuffer();
+	long end = size();
+	if(end <= 0 || end == nextLinePos){
 		return "";
 	}
 	long currentLinePos = nextLinePos;
 	bool lineEndWasCR = false;
-	while(nextLinePos < (int)buffer.size() - 1 && buffer[nextLinePos] != '\n'){
-		if(buffer[nextLinePos] != '\r'){
+	while(nextLinePos < end && data[nextLinePos] != '\n'){
+		if(data[nextLinePos] != '\r'){
 			nextLinePos++;
 		}
 		else{
@@ -180,12 +431,12 @@ string ofBuffer::getNextLine(){
 			break;
 		}
 	}
-	string line(getBinaryBuffer() + currentLinePos, nextLinePos - currentLinePos);
-	if(nextLinePos < (int)(buffer.size() - 1)){
+	string line(data + currentLinePos, nextLinePos - currentLinePos);
+	if(nextLinePos < end){
 		nextLinePos++;
 	}
 	// if lineEndWasCR check for CRLF
-	if(lineEndWasCR && nextLinePos < (int)(buffer.size() - 1) && buffer[nextLinePos] == '\n'){
+	if(lineEndWasCR && nextLinePos < end && data[nextLinePos] == '\n'){
 		nextLinePos++;
 	}
 	return line;
@@ -199,7 +450,7 @@ string ofBuffer::getFirstLine(){
 
 //--------------------------------------------------
 bool ofBuffer::isLastLine(){
-	return (int)(buffer.size() - 1) == nextLinePos;
+	return size() == nextLinePos;
 }
 
 //--------------------------------------------------
@@ -207,6 +458,84 @@ void ofBuffer::resetLineReader(){
 	nextLinePos = 0;
 }
 
+//--------------------------------------------------
+ofBuffer::LineIterator ofBuffer::beginLines() const{
+	const char * data = getBinaryBuffer();
+	return LineIterator(data, data + max(size(),0L));
+}
+
+//--------------------------------------------------
+ofBuffer::LineIterator ofBuffer::endLines() const{
+	return LineIterator();
+}
+
+//--------------------------------------------------
+ofBuffer::LineIterator::LineIterator()
+:next(NULL)
+,last(NULL)
+,bEnd(true){
+}
+
+//--------------------------------------------------
+ofBuffer::LineIterator::LineIterator(const char * begin, const char * end)
+:next(begin)
+,last(end)
+,bEnd(false){
+	++(*this);
+}
+
+//--------------------------------------------------
+const ofBufferView & ofBuffer::LineIterator::operator*() const{
+	return line;
+}
+
+//--------------------------------------------------
+const ofBufferView * ofBuffer::LineIterator::operator->() const{
+	return &line;
+}
+
+//--------------------------------------------------
+ofBuffer::LineIterator & ofBuffer::LineIterator::operator++(){
+	// same lines as getNextLine(), a line break at the end
+	// doesn't start a new empty line
+	if(bEnd || next>=last){
+		bEnd = true;
+		line = ofBufferView();
+		return *this;
+	}
+	const char * lineEnd = next;
+	while(lineEnd<last && *lineEnd!='\n' && *lineEnd!='\r'){
+		lineEnd++;
+	}
+	line = ofBufferView(next, lineEnd - next);
+	next = lineEnd;
+	if(next<last){
+		if(*next=='\r' && next+1<last && next[1]=='\n'){
+			next++;
+		}
+		next++;
+	}
+	return *this;
+}
+
+//--------------------------------------------------
+ofBuffer::LineIterator ofBuffer::LineIterator::operator++(int){
+	LineIterator prev = *this;
+	++(*this);
+	return prev;
+}
+
+//--------------------------------------------------
+bool ofBuffer::LineIterator::operator==(const LineIterator & other) const{
+	if(bEnd || other.bEnd) return bEnd==other.bEnd;
+	return line.begin()==other.line.begin();
+}
+
+//--------------------------------------------------
+bool ofBuffer::LineIterator::operator!=(const LineIterator & other) const{
+	return !(*this==other);
+}
+
 //--------------------------------------------------
 ostream & operator<<(ostream & ostr, const ofBuffer & buf){
 	buf.writeTo(ostr);
@@ -228,6 +557,13 @@ ofBuffer ofBufferFromFile(const string & path, bool binary){
 	return buffer;
 }
 
+//--------------------------------------------------
+ofBuffer ofBufferFromMappedFile(const string & path){
+	ofBuffer buffer;
+	buffer.setFromMappedFile(path);
+	return buffer;
+}
+
 //--------------------------------------------------
 bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary){
 	ios_base::openmode mode = binary ? ofstream::binary : ios_base::out;
@@ -1146,6 +1482,196 @@ int ofDirectory::listDir(){
 	return size();
 }
 
+//------------------------------------------------------------------------------------------------------------
+// walks a directory tree with a pool of threads, each one takes a
+// directory from the queue, lists it and queues its subdirectories
+class ofDirectoryScanner{
+public:
+	ofDirectoryScanner(const string & absRoot, const string & originalRoot, const vector<string> & extensions, bool showHidden, bool recursive)
+	:absRoot(absRoot)
+	,originalRoot(originalRoot)
+	,extensions(extensions)
+	,showHidden(showHidden)
+	,recursive(recursive)
+	,numBusy(0){
+		filterExtensions = !extensions.empty() && !ofContains(extensions, (string)"*");
+		pending.push_back("");
+	}
+
+	void run(int numThreads){
+		vector<Worker*> workers;
+		for(int i=1;i<numThreads;i++){
+			workers.push_back(new Worker(*this));
+			workers.back()->startThread(true,false);
+		}
+		// the calling thread works too
+		process();
+		for(int i=0;i<(int)workers.size();i++){
+			workers[i]->waitForThread(false);
+			delete workers[i];
+		}
+	}
+
+	vector<ofDirectoryEntry> entries;
+
+private:
+	class Worker: public ofThread{
+	public:
+		Worker(ofDirectoryScanner & scanner):scanner(scanner){}
+		void threadedFunction(){ scanner.process(); }
+		ofDirectoryScanner & scanner;
+	};
+
+	void process(){
+		vector<ofDirectoryEntry> found;
+		vector<string> subdirs;
+		mutex.lock();
+		while(true){
+			while(pending.empty() && numBusy>0){
+				condition.wait(mutex);
+			}
+			if(pending.empty()) break;
+			string dir = pending.front();
+			pending.pop_front();
+			numBusy++;
+			mutex.unlock();
+
+			found.clear();
+			subdirs.clear();
+			list(dir,found,subdirs);
+
+			mutex.lock();
+			entries.insert(entries.end(),found.begin(),found.end());
+			if(recursive){
+				pending.insert(pending.end(),subdirs.begin(),subdirs.end());
+			}
+			numBusy--;
+			condition.broadcast();
+		}
+		mutex.unlock();
+	}
+
+	void add(const string & relDir, const string & name, bool isDirectory, bool isHidden, uint64_t size, time_t lastModified, vector<ofDirectoryEntry> & found, vector<string> & subdirs){
+		if(isHidden && !showHidden) return;
+		string relPath = relDir + name;
+		if(isDirectory){
+			subdirs.push_back(relPath + "/");
+		}else if(filterExtensions){
+			size_t dot = name.rfind('.');
+			if(dot==string::npos || !ofContains(extensions, toLower(name.substr(dot+1)))) return;
+		}
+		found.push_back(ofDirectoryEntry());
+		ofDirectoryEntry & entry = found.back();
+		entry.path = originalRoot + relPath;
+		entry.name = name;
+		entry.isDirectory = isDirectory;
+		entry.isHidden = isHidden;
+		entry.size = isDirectory ? 0 : size;
+		entry.lastModified = lastModified;
+	}
+
+	void list(const string & relDir, vector<ofDirectoryEntry> & found, vector<string> & subdirs){
+		string absDir = absRoot + relDir;
+#ifdef TARGET_WIN32
+		WIN32_FIND_DATAA data;
+		HANDLE handle = FindFirstFileA((absDir + "*").c_str(), &data);
+		if(handle==INVALID_HANDLE_VALUE){
+			ofLogWarning("ofDirectory") << "scan(): couldn't list \"" << absDir << "\"";
+			return;
+		}
+		do{
+			string name = data.cFileName;
+			if(name=="." || name=="..") continue;
+			bool isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+			bool isHidden = (data.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN) != 0;
+			uint64_t size = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+			// FILETIME is in 100ns intervals since 1601
+			uint64_t fileTime = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+			time_t lastModified = (fileTime - 116444736000000000ULL) / 10000000ULL;
+			// don't follow links to directories, they can create cycles
+			if(isDirectory && (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)){
+				vector<string> ignored;
+				add(relDir,name,true,isHidden,0,lastModified,found,ignored);
+				continue;
+			}
+			add(relDir,name,isDirectory,isHidden,size,lastModified,found,subdirs);
+		}while(FindNextFileA(handle,&data));
+		FindClose(handle);
+#else
+		DIR * dir = opendir(absDir.c_str());
+		if(!dir){
+			ofLogWarning("ofDirectory") << "scan(): couldn't list \"" << absDir << "\"";
+			return;
+		}
+		struct dirent * ent;
+		while((ent = readdir(dir)) != NULL){
+			string name = ent->d_name;
+			if(name=="." || name=="..") continue;
+			bool isHidden = name[0]=='.';
+			if(isHidden && !showHidden) continue;
+			struct stat st;
+			if(stat((absDir + name).c_str(), &st)!=0) continue;
+			bool isDirectory = S_ISDIR(st.st_mode);
+			// don't follow links to directories, they can create cycles.
+			// some filesystems don't fill d_type, then lstat tells
+			bool isLink = ent->d_type==DT_LNK;
+			if(isDirectory && ent->d_type==DT_UNKNOWN){
+				struct stat lst;
+				isLink = lstat((absDir + name).c_str(), &lst)==0 && S_ISLNK(lst.st_mode);
+			}
+			if(isDirectory && isLink){
+				vector<string> ignored;
+				add(relDir,name,true,isHidden,0,st.st_mtime,found,ignored);
+				continue;
+			}
+			add(relDir,name,isDirectory,isHidden,st.st_size,st.st_mtime,found,subdirs);
+		}
+		closedir(dir);
+#endif
+	}
+
+	string absRoot;
+	string originalRoot;
+	vector<string> extensions;
+	bool filterExtensions;
+	bool showHidden;
+	bool recursive;
+	deque<string> pending;
+	int numBusy;
+	ofMutex mutex;
+	Poco::Condition condition;
+};
+
+//------------------------------------------------------------------------------------------------------------
+static bool entryPathLess(const ofDirectoryEntry & a, const ofDirectoryEntry & b){
+	return a.path < b.path;
+}
+
+//------------------------------------------------------------------------------------------------------------
+int ofDirectory::scan(vector<ofDirectoryEntry> & entries, bool recursive, int numThreads){
+	entries.clear();
+	if(path().empty()){
+		ofLogError("ofDirectory") << "scan(): directory path is empty";
+		return 0;
+	}
+	if(!myDir.exists()){
+		ofLogError("ofDirectory") << "scan(): source directory does not exist: \"" << myDir.path() << "\"";
+		return 0;
+	}
+
+	if(!recursive){
+		numThreads = 1;
+	}else if(numThreads<=0){
+		numThreads = max(1,min((int)Poco::Environment::processorCount(),4));
+	}
+
+	ofDirectoryScanner scanner(ofFilePath::addTrailingSlash(myDir.path()), originalDirectory, extensions, showHidden, recursive);
+	scanner.run(numThreads);
+	entries.swap(scanner.entries);
+	std::sort(entries.begin(), entries.end(), entryPathLess);
+	return entries.size();
+}
+
 //------------------------------------------------------------------------------------------------------------
 string ofDirectory::getOriginalDirectory(){
 	return originalDirectory;
@@ -1,12 +1,55 @@
 #pragma once
 
 #include "ofConstants.h"
+#include "ofTypes.h"
 #include "Poco/File.h"
 
+//----------------------------------------------------------
+// ofBufferView
+//----------------------------------------------------------
+
+// a part of an ofBuffer without copying it. it's only valid while the
+// buffer it comes from isn't modified or destroyed, and is not 0 terminated,
+// use getText() to get a string from it
+
+class ofBufferView{
+
+public:
+	ofBufferView();
+	ofBufferView(const char * data, long size);
+
+	const char * getBinaryBuffer() const;
+	long size() const;
+	bool empty() const;
+
+	string getText() const;
+	operator string() const;
+
+	// part of this view starting at offset, size -1 is until the end
+	ofBufferView slice(long offset, long size=-1) const;
+
+	const char * begin() const;
+	const char * end() const;
+	char operator[](long i) const;
+
+	bool operator==(const ofBufferView & other) const;
+	bool operator!=(const ofBufferView & other) const;
+	bool operator==(const string & text) const;
+	bool operator!=(const string & text) const;
+
+	friend ostream & operator<<(ostream & ostr, const ofBufferView & view);
+
+private:
+	const char * data;
+	long length;
+};
+
 //----------------------------------------------------------
 // ofBuffer
 //----------------------------------------------------------
 
+class ofBufferMapping;
+
 class ofBuffer{
 	
 public:
@@ -15,12 +58,22 @@ public:
 	ofBuffer(const string & text);
 	ofBuffer(istream & stream);
 	ofBuffer(const ofBuffer & buffer_);
+	ofBuffer & operator=(const ofBuffer & buffer_);
 
 	~ofBuffer();
 
 	void set(const char * _buffer, unsigned int _size);
 	void set(const string & text);
 	bool set(istream & stream);
+
+	// maps the file to memory instead of reading it, the pages are only
+	// loaded when they are accessed and no copy is made. writing to the
+	// buffer modifies only this buffer, never the file. copies of a mapped
+	// buffer share the mapping until one of them is modified. falls back to
+	// reading the file when it can't be mapped. the file shouldn't be
+	// truncated or rewritten while a buffer maps it
+	bool setFromMappedFile(const string & path, bool bRelativeToData=true);
+	bool isMapped() const;
 	void append(const string& _buffer);
 	void append(const char * _buffer, unsigned int _size);
 
@@ -38,22 +91,59 @@ public:
 	ofBuffer & operator=(const string & text);
 
 	long size() const;
+
+	// zero-copy access to a part of the buffer, size -1 is until the end
+	ofBufferView getView(long offset=0, long size=-1) const;
+
 	string getNextLine();
     string getFirstLine();
 	bool isLastLine();
     void resetLineReader();
+
+	// iterates the lines of the buffer as views, without allocating a
+	// string per line like getNextLine(). lines end in \n, \r\n or \r
+	//
+	// for(ofBuffer::LineIterator it=buffer.beginLines(); it!=buffer.endLines(); ++it){
+	//     const ofBufferView & line = *it;
+	// }
+	class LineIterator{
+	public:
+		LineIterator();
+		LineIterator(const char * begin, const char * end);
+		const ofBufferView & operator*() const;
+		const ofBufferView * operator->() const;
+		LineIterator & operator++();
+		LineIterator operator++(int);
+		bool operator==(const LineIterator & other) const;
+		bool operator!=(const LineIterator & other) const;
+	private:
+		ofBufferView line;
+		const char * next;
+		const char * last;
+		bool bEnd;
+	};
+
+	LineIterator beginLines() const;
+	LineIterator endLines() const;
     
 	friend ostream & operator<<(ostream & ostr, const ofBuffer & buf);
 	friend istream & operator>>(istream & istr, ofBuffer & buf);
 
 private:
+	void unmap(bool bKeepData);
+
 	vector<char> 	buffer;
+	ofPtr<ofBufferMapping> mapping;
 	long 			nextLinePos;
 };
 
 //--------------------------------------------------
 ofBuffer ofBufferFromFile(const string & path, bool binary=false);
 
+//--------------------------------------------------
+// memory maps the file, see ofBuffer::setFromMappedFile(). always binary
+ofBuffer ofBufferFromMappedFile(const string & path);
+
 //--------------------------------------------------
 bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary=false);
 
@@ -201,6 +291,25 @@ private:
 	bool binary;
 };
 
+// an entry found by ofDirectory::scan() with the information from the
+// file system at the moment of the scan, so it can be queried without
+// accessing the disk again
+class ofDirectoryEntry{
+public:
+	ofDirectoryEntry()
+	:isDirectory(false)
+	,isHidden(false)
+	,size(0)
+	,lastModified(0){}
+
+	string path;			// the scanned directory path + the path inside it
+	string name;			// e.g., "image.png"
+	bool isDirectory;
+	bool isHidden;
+	uint64_t size;
+	time_t lastModified;
+};
+
 class ofDirectory{
 
 public:
@@ -241,6 +350,13 @@ public:
 	int listDir(string path);
 	int listDir();
 
+	// lists the directory and, if recursive, all its subdirectories using
+	// the allowed extensions and hidden setting. each entry is read with a
+	// single system call and several directories are read in parallel,
+	// numThreads 0 chooses automatically. the entries are sorted by path.
+	// extensions only filter files, every directory is listed and walked
+	int scan(vector<ofDirectoryEntry> & entries, bool recursive = true, int numThreads = 0);
+
 	string getOriginalDirectory();
 	string getName(unsigned int position); // e.g., "image.png"
 	string getPath(unsigned int position);
@@ -51,6 +51,7 @@ ofLog::ofLog(){
 	level = OF_LOG_NOTICE;
 	module = "";
 	bPrinted = false;
+	bEnabled = checkLog(level,module);
 }
 		
 //--------------------------------------------------
@@ -58,12 +59,14 @@ ofLog::ofLog(ofLogLevel _level){
 	level = _level;
 	module = "";
 	bPrinted = false;
+	bEnabled = checkLog(level,module);
 }
 
 //--------------------------------------------------
 ofLog::ofLog(ofLogLevel level, const string & message){
 	_log(level,"",message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -75,6 +78,7 @@ ofLog::ofLog(ofLogLevel level, const char* format, ...){
 		va_end( args );
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -91,18 +95,22 @@ void ofLog::setAutoSpace(bool autoSpace){
 //-------------------------------------------------------
 ofLog::~ofLog(){
 	// don't log if we printed in the constructor already
-	if(!bPrinted){
-		_log(level,module,message.str());
+	if(!bPrinted && bEnabled){
+		channel->log(level,module,message.str());
 	}
 }
 
 bool ofLog::checkLog(ofLogLevel level, const string & module){
-	if(getModules().find(module)==getModules().end()){
-		if(level >= currentLogLevel) return true;
+	map<string,ofLogLevel> & modules = getModules();
+	if(modules.empty() || module.empty()){
+		return level >= currentLogLevel;
+	}
+	map<string,ofLogLevel>::iterator it = modules.find(module);
+	if(it==modules.end()){
+		return level >= currentLogLevel;
 	}else{
-		if(level >= getModules()[module]) return true;
+		return level >= it->second;
 	}
-	return false;
 }
 
 //-------------------------------------------------------
@@ -117,11 +125,13 @@ ofLogVerbose::ofLogVerbose(const string & _module){
 	level = OF_LOG_VERBOSE;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogVerbose::ofLogVerbose(const string & _module, const string & _message){
 	_log(OF_LOG_VERBOSE,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...){
@@ -132,6 +142,7 @@ ofLogVerbose::ofLogVerbose(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -139,11 +150,13 @@ ofLogNotice::ofLogNotice(const string & _module){
 	level = OF_LOG_NOTICE;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogNotice::ofLogNotice(const string & _module, const string & _message){
 	_log(OF_LOG_NOTICE,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogNotice::ofLogNotice(const string & module, const char* format, ...){
@@ -154,6 +167,7 @@ ofLogNotice::ofLogNotice(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -161,11 +175,13 @@ ofLogWarning::ofLogWarning(const string & _module){
 	level = OF_LOG_WARNING;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogWarning::ofLogWarning(const string & _module, const string & _message){
 	_log(OF_LOG_WARNING,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogWarning::ofLogWarning(const string & module, const char* format, ...){
@@ -176,6 +192,7 @@ ofLogWarning::ofLogWarning(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -183,11 +200,13 @@ ofLogError::ofLogError(const string & _module){
 	level = OF_LOG_ERROR;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogError::ofLogError(const string & _module, const string & _message){
 	_log(OF_LOG_ERROR,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogError::ofLogError(const string & module, const char* format, ...){
@@ -198,6 +217,7 @@ ofLogError::ofLogError(const string & module, const char* format, ...){
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -205,11 +225,13 @@ ofLogFatalError::ofLogFatalError(const string &  _module){
 	level = OF_LOG_FATAL_ERROR;
 	module = _module;
 	bPrinted=false;
+	bEnabled = checkLog(level,module);
 }
 
 ofLogFatalError::ofLogFatalError(const string & _module, const string & _message){
 	_log(OF_LOG_FATAL_ERROR,_module,_message);
 	bPrinted = true;
+	bEnabled = false;
 }
 
 ofLogFatalError::ofLogFatalError(const string & module, const char* format, ...){
@@ -220,6 +242,7 @@ ofLogFatalError::ofLogFatalError(const string & module, const char* format, ...)
 		va_end(args);
 	}
 	bPrinted = true;
+	bEnabled = false;
 }
 
 //--------------------------------------------------
@@ -326,3 +349,118 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const cha
 	}
 	file << ofVAArgsToString(format,args) << endl;
 }
+
+//--------------------------------------------------
+ofAsyncLoggerChannel::ofAsyncLoggerChannel(ofPtr<ofBaseLoggerChannel> _channel, int capacity)
+:channel(_channel)
+,numDroppedReported(0)
+,flushIntervalMs(10)
+,flusher(*this){
+	unsigned int size = 1;
+	while(size < (unsigned int)max(capacity,1)) size <<= 1;
+	records.resize(size);
+	mask = size - 1;
+	flusher.startThread(false,false);
+}
+
+ofAsyncLoggerChannel::~ofAsyncLoggerChannel(){
+	flusher.waitForThread(true);
+	drain();
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	push(level,module,message);
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
+	va_list args;
+	va_start(args, format);
+	log(level, module, format, args);
+	va_end(args);
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, va_list args){
+	push(level,module,ofVAArgsToString(format,args));
+}
+
+void ofAsyncLoggerChannel::push(ofLogLevel level, const string & module, const string & message){
+	// a writer only gets a record if there's a free one for it, so the
+	// record at its index has always been written and released already
+	if(++numPending > (int)records.size()){
+		--numPending;
+		++numDropped;
+		return;
+	}
+	unsigned int index = (unsigned int)(writeIndex++);
+	Record & record = records[index & mask];
+	record.level = level;
+	// the records are reused, assigning mostly doesn't need to allocate
+	record.module = module;
+	record.message = message;
+	++record.ready;
+}
+
+void ofAsyncLoggerChannel::drain(){
+	// only the flusher thread reads records, or the destructor once it's stopped
+	while(true){
+		Record & record = records[(unsigned int)readIndex.value() & mask];
+		if(record.ready.value()==0) break;
+		channel->log(record.level,record.module,record.message);
+		--record.ready;
+		++readIndex;
+		++numLogged;
+		--numPending;
+	}
+
+	unsigned int dropped = numDropped.value();
+	if(dropped!=numDroppedReported){
+		channel->log(OF_LOG_WARNING,"ofAsyncLoggerChannel",ofToString(dropped - numDroppedReported) + " messages dropped, the queue was full");
+		numDroppedReported = dropped;
+	}
+}
+
+void ofAsyncLoggerChannel::flush(){
+	unsigned int target = writeIndex.value();
+	while((int)(target - (unsigned int)readIndex.value()) > 0 && flusher.isThreadRunning()){
+		Poco::Thread::sleep(1);
+	}
+}
+
+void ofAsyncLoggerChannel::setFlushIntervalMs(int ms){
+	flushIntervalMs = max(ms,1);
+}
+
+int ofAsyncLoggerChannel::getFlushIntervalMs(){
+	return flushIntervalMs;
+}
+
+ofPtr<ofBaseLoggerChannel> ofAsyncLoggerChannel::getChannel(){
+	return channel;
+}
+
+int ofAsyncLoggerChannel::getCapacity(){
+	return records.size();
+}
+
+int ofAsyncLoggerChannel::getNumQueued(){
+	return numPending.value();
+}
+
+unsigned int ofAsyncLoggerChannel::getNumLogged(){
+	return numLogged.value();
+}
+
+unsigned int ofAsyncLoggerChannel::getNumDropped(){
+	return numDropped.value();
+}
+
+ofAsyncLoggerChannel::Flusher::Flusher(ofAsyncLoggerChannel & logger)
+:logger(logger){
+}
+
+void ofAsyncLoggerChannel::Flusher::threadedFunction(){
+	while(isThreadRunning()){
+		logger.drain();
+		sleep(logger.flushIntervalMs);
+	}
+}
@@ -3,6 +3,8 @@
 #include "ofConstants.h"
 #include "ofFileUtils.h"
 #include "ofTypes.h"
+#include "ofThread.h"
+#include "Poco/AtomicCounter.h"
 
 enum ofLogLevel{
 	OF_LOG_VERBOSE,
@@ -47,6 +49,9 @@ void ofSetLoggerChannel(ofPtr<ofBaseLoggerChannel> loggerChannel);
 ///
 /// Usage: ofLog(OF_LOG_ERROR, "another string");
 ///
+/// The log level of the message and its module are checked when the ofLog is
+/// created, if they are disabled nothing streamed into it gets formatted.
+///
 /// class idea from:
 /// 	http://www.gamedev.net/community/forums/topic.asp?topic_id=525405&whichpage=1&#3406418
 /// how to catch std::endl (which is actually a func pointer):
@@ -73,13 +78,13 @@ class ofLog{
 		/// catch the << ostream with a template class to read any type of data
 		template <class T> 
 			ofLog& operator<<(const T& value){
-			message << value << padding;
+			if(bEnabled) message << value << padding;
 			return *this;
 		}
 		
 		/// catch the << ostream function pointers such as std::endl and std::hex
 		ofLog& operator<<(std::ostream& (*func)(std::ostream&)){
-			func(message);
+			if(bEnabled) func(message);
 			return *this;
 		}
 		
@@ -92,6 +97,7 @@ class ofLog{
 	protected:
 		ofLogLevel level;			///< log level
 		bool bPrinted;				///< has the msg been printed in the constructor? 
+		bool bEnabled;				///< will the msg be printed? if not it isn't formatted
 		string module;				///< the destination module for this message
 		
 		/// print a log line
@@ -189,3 +195,77 @@ public:
 private:
 	ofFile file;
 };
+
+//--------------------------------------------------------------
+///
+/// \class ofAsyncLoggerChannel
+/// \brief logs to another channel from a background thread
+///
+/// Messages are queued in a ring buffer without locks and a thread writes them
+/// to the wrapped channel, so logging from the render or audio thread never
+/// waits for the console or for a file to be written.
+///
+/// Usage: ofSetLoggerChannel(ofPtr<ofBaseLoggerChannel>(new ofAsyncLoggerChannel(
+///            ofPtr<ofBaseLoggerChannel>(new ofFileLoggerChannel("log.txt",true)))));
+///
+/// When the queue is full new messages are dropped instead of waiting, the
+/// number dropped is logged once there's space again and can be queried with
+/// getNumDropped(). The messages are formatted in the thread that logs them
+/// so the order and content are the same as with the wrapped channel.
+///
+class ofAsyncLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// capacity is the max number of queued messages, rounded up to a power of 2
+	ofAsyncLoggerChannel(ofPtr<ofBaseLoggerChannel> channel, int capacity=1024);
+	virtual ~ofAsyncLoggerChannel();
+
+	void log(ofLogLevel level, const string & module, const string & message);
+	void log(ofLogLevel level, const string & module, const char* format, ...);
+	void log(ofLogLevel level, const string & module, const char* format, va_list args);
+
+	/// blocks until the messages queued before the call have been written
+	void flush();
+
+	/// how often the thread checks for new messages, 10ms by default
+	void setFlushIntervalMs(int ms);
+	int getFlushIntervalMs();
+
+	ofPtr<ofBaseLoggerChannel> getChannel();
+	int getCapacity();
+	int getNumQueued();
+	unsigned int getNumLogged();
+	unsigned int getNumDropped();
+
+private:
+	ofAsyncLoggerChannel(const ofAsyncLoggerChannel &);
+	ofAsyncLoggerChannel & operator=(const ofAsyncLoggerChannel &);
+
+	struct Record{
+		ofLogLevel level;
+		string module;
+		string message;
+		Poco::AtomicCounter ready;		///< 1 once the writer has filled it
+	};
+
+	class Flusher: public ofThread{
+	public:
+		Flusher(ofAsyncLoggerChannel & logger);
+		void threadedFunction();
+		ofAsyncLoggerChannel & logger;
+	};
+
+	void push(ofLogLevel level, const string & module, const string & message);
+	void drain();
+
+	ofPtr<ofBaseLoggerChannel> channel;
+	vector<Record> records;
+	unsigned int mask;
+	Poco::AtomicCounter writeIndex;		///< next record a writer gets
+	Poco::AtomicCounter readIndex;		///< next record to be written to the channel
+	Poco::AtomicCounter numPending;		///< records claimed by writers and not yet written
+	Poco::AtomicCounter numLogged;
+	Poco::AtomicCounter numDropped;
+	unsigned int numDroppedReported;
+	int flushIntervalMs;
+	Flusher flusher;
+};
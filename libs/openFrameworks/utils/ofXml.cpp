@@ -1,5 +1,8 @@
 
 #include "ofXml.h"
+#include <Poco/SAX/SAXParser.h>
+#include <Poco/SAX/InputSource.h>
+#include <Poco/SAX/Attributes.h>
 
 ofXml::~ofXml() {
 	releaseAll();
@@ -403,7 +406,12 @@ bool ofXml::setValue(const string& path, const string& value)
         ofLogWarning("ofXml") <<  "setValue(): path \"" + path + "\" doesn't exist";
         return false;
     }
-    
+
+    return setValue(e, value);
+}
+
+bool ofXml::setValue(Poco::XML::Element * e, const string& value)
+{
     if(!e->firstChild()){
     	Poco::XML::Text *node = getPocoDocument()->createTextNode(ofToString(value));
     	e->appendChild(node);
@@ -982,3 +990,475 @@ string ofXml::DOMErrorMessage(short msg)
     return "DOM ERROR";
     
 }
+
+//---------------------------------------------------------
+// compiled paths
+//---------------------------------------------------------
+
+ofXmlPath::ofXmlPath()
+:bRecursive(false)
+,bValid(false){
+}
+
+ofXmlPath::ofXmlPath(const string & path)
+:bRecursive(false)
+,bValid(false){
+    set(path);
+}
+
+bool ofXmlPath::set(const string & _path){
+    path = _path;
+    steps.clear();
+    bRecursive = false;
+    bValid = false;
+
+    size_t pos = 0;
+    if(path.compare(0,2,"//")==0){
+        bRecursive = true;
+        pos = 2;
+    }else if(path.compare(0,1,"/")==0){
+        pos = 1;
+    }
+
+    while(pos < path.size()){
+        // the end of the segment, slashes inside predicates don't count
+        size_t end = pos;
+        bool inPredicate = false;
+        while(end < path.size() && (inPredicate || path[end]!='/')){
+            if(path[end]=='[') inPredicate = true;
+            else if(path[end]==']') inPredicate = false;
+            end++;
+        }
+        string segment = path.substr(pos, end-pos);
+        pos = end + 1;
+        if(segment.empty()) continue;
+
+        // "elem/@attr" selects an attribute of the previous step
+        if(segment[0]=='@'){
+            if(steps.empty() || !steps.back().attribute.empty()){
+                steps.push_back(Step());
+            }
+            steps.back().attribute = segment.substr(1);
+            continue;
+        }
+
+        Step step;
+        size_t bracket = segment.find('[');
+        step.name = segment.substr(0,bracket);
+        if(bracket!=string::npos){
+            size_t close = segment.find(']',bracket);
+            if(close==string::npos){
+                ofLogError("ofXmlPath") << "set(): missing ] in \"" << path << "\"";
+                steps.clear();
+                return false;
+            }
+            string predicate = segment.substr(bracket+1, close-bracket-1);
+            if(!predicate.empty() && predicate[0]=='@'){
+                size_t equals = predicate.find('=');
+                step.attribute = predicate.substr(1,equals-1);
+                if(equals!=string::npos){
+                    string value = predicate.substr(equals+1);
+                    if(value.size()>=2 && (value[0]=='\'' || value[0]=='"') && value[value.size()-1]==value[0]){
+                        value = value.substr(1,value.size()-2);
+                    }
+                    step.attributeValue = value;
+                    step.bAttributeValue = true;
+                }
+            }else{
+                step.index = ofToInt(predicate);
+            }
+        }
+        steps.push_back(step);
+    }
+
+    // only the last step can select an attribute
+    for(int i=0;i<(int)steps.size()-1;i++){
+        if(!steps[i].attribute.empty() && !steps[i].bAttributeValue){
+            ofLogError("ofXmlPath") << "set(): only the last element of \"" << path << "\" can select an attribute";
+            steps.clear();
+            return false;
+        }
+    }
+    bValid = !steps.empty();
+    return bValid;
+}
+
+const string & ofXmlPath::toString() const{
+    return path;
+}
+
+bool ofXmlPath::isValid() const{
+    return bValid;
+}
+
+const vector<ofXmlPath::Step> & ofXmlPath::getSteps() const{
+    return steps;
+}
+
+bool ofXmlPath::isRecursive() const{
+    return bRecursive;
+}
+
+bool ofXmlPath::selectsAttribute() const{
+    return bValid && !steps.back().attribute.empty() && !steps.back().bAttributeValue;
+}
+
+static bool stepMatches(const ofXmlPath::Step & step, Poco::XML::Element * e){
+    if(step.name!="" && step.name!="*" && e->nodeName()!=step.name) return false;
+    if(step.bAttributeValue){
+        return e->hasAttribute(step.attribute) && e->getAttribute(step.attribute)==step.attributeValue;
+    }
+    return true;
+}
+
+static Poco::XML::Element * findChild(const ofXmlPath::Step & step, Poco::XML::Node * parent){
+    int index = step.bAttributeValue ? 0 : max(step.index,0);
+    for(Poco::XML::Node * child = parent->firstChild(); child; child = child->nextSibling()){
+        if(child->nodeType()!=Poco::XML::Node::ELEMENT_NODE) continue;
+        Poco::XML::Element * e = (Poco::XML::Element*)child;
+        if(stepMatches(step,e) && index--==0) return e;
+    }
+    return NULL;
+}
+
+static Poco::XML::Element * findDescendant(const ofXmlPath::Step & step, Poco::XML::Node * parent){
+    for(Poco::XML::Node * child = parent->firstChild(); child; child = child->nextSibling()){
+        if(child->nodeType()!=Poco::XML::Node::ELEMENT_NODE) continue;
+        Poco::XML::Element * e = (Poco::XML::Element*)child;
+        if(stepMatches(step,e)) return e;
+        e = findDescendant(step,e);
+        if(e) return e;
+    }
+    return NULL;
+}
+
+// resolves the path from root, stopping at the element when
+// bAttribute is false even if the path selects an attribute
+static Poco::XML::Node * resolvePath(Poco::XML::Node * root, const ofXmlPath & path, bool bAttribute){
+    if(!root || !path.isValid()) return NULL;
+    Poco::XML::Node * node = root;
+    const vector<ofXmlPath::Step> & steps = path.getSteps();
+    for(int i=0;i<(int)steps.size() && node;i++){
+        const ofXmlPath::Step & step = steps[i];
+        if(step.name!=""){
+            if(i==0 && path.isRecursive()){
+                node = findDescendant(step,node);
+            }else{
+                node = findChild(step,node);
+            }
+        }else if(step.bAttributeValue && !stepMatches(step,(Poco::XML::Element*)node)){
+            node = NULL;
+        }
+        if(bAttribute && node && !step.attribute.empty() && !step.bAttributeValue){
+            node = ((Poco::XML::Element*)node)->getAttributeNode(step.attribute);
+        }
+    }
+    return node;
+}
+
+Poco::XML::Node* ofXml::getPocoNode(const ofXmlPath & path) const{
+    Poco::XML::Node * root = element;
+    if(!root) root = document->documentElement();
+    return resolvePath(root,path,true);
+}
+
+string ofXml::getValue(const ofXmlPath & path) const{
+    Poco::XML::Node * node = getPocoNode(path);
+    if(!node) return "";
+    return node->innerText();
+}
+
+int ofXml::getIntValue(const ofXmlPath & path) const{
+    return ofToInt(getValue(path));
+}
+
+float ofXml::getFloatValue(const ofXmlPath & path) const{
+    return ofToFloat(getValue(path));
+}
+
+bool ofXml::getBoolValue(const ofXmlPath & path) const{
+    return ofToBool(getValue(path));
+}
+
+bool ofXml::setValue(const ofXmlPath & path, const string& value){
+    Poco::XML::Node * node = getPocoNode(path);
+    if(!node){
+        ofLogWarning("ofXml") <<  "setValue(): path \"" + path.toString() + "\" doesn't exist";
+        return false;
+    }
+    if(node->nodeType()==Poco::XML::Node::ATTRIBUTE_NODE){
+        node->setNodeValue(value);
+        return true;
+    }
+    return setValue((Poco::XML::Element*)node, value);
+}
+
+string ofXml::getAttribute(const ofXmlPath & path) const{
+    Poco::XML::Node * node = getPocoNode(path);
+    if(node && node->nodeType()==Poco::XML::Node::ATTRIBUTE_NODE){
+        return node->getNodeValue();
+    }
+    return "";
+}
+
+bool ofXml::setAttribute(const ofXmlPath & path, const string& value){
+    if(!path.selectsAttribute()){
+        ofLogWarning("ofXml") << "setAttribute(): path \"" << path.toString() << "\" doesn't select an attribute";
+        return false;
+    }
+    // set it on the element so the attribute is created if it doesn't exist yet
+    Poco::XML::Node * root = element;
+    if(!root) root = document->documentElement();
+    Poco::XML::Element * e = (Poco::XML::Element*)resolvePath(root,path,false);
+    if(!e){
+        ofLogWarning("ofXml") << "setAttribute(): path \"" << path.toString() << "\" doesn't exist";
+        return false;
+    }
+    e->setAttribute(path.getSteps().back().attribute, value);
+    return true;
+}
+
+bool ofXml::exists(const ofXmlPath & path) const{
+    return getPocoNode(path)!=NULL;
+}
+
+bool ofXml::setTo(const ofXmlPath & path){
+    Poco::XML::Node * node = getPocoNode(path);
+    if(!node || node->nodeType()!=Poco::XML::Node::ELEMENT_NODE){
+        ofLogWarning("ofXml") << "setTo(): passed invalid path \"" << path.toString() << "\"";
+        return false;
+    }
+    element = (Poco::XML::Element*)node;
+    return true;
+}
+
+//---------------------------------------------------------
+// streaming reader
+//---------------------------------------------------------
+
+class ofXmlReaderStop{};
+
+class ofXmlReader::Handler: public Poco::XML::DefaultHandler{
+public:
+    Handler(ofXmlReader & reader)
+    :reader(reader)
+    ,numCapturing(0)
+    ,elementQuery(-1)
+    ,elementDepth(0){
+        // the virtual root, nothing matched yet
+        frames.push_back(Frame());
+        frames.back().matched.assign(reader.queries.size(),0);
+    }
+
+    void startElement(const Poco::XML::XMLString&, const Poco::XML::XMLString&, const Poco::XML::XMLString& name, const Poco::XML::Attributes& attributes){
+        Frame & parent = frames.back();
+        int index = parent.childCounts[name]++;
+        int depth = frames.size();
+
+        frames.push_back(Frame());
+        Frame & frame = frames.back();
+        Frame & parentFrame = frames[frames.size()-2];
+        frame.matched.assign(reader.queries.size(),0);
+
+        for(int i=0;i<(int)reader.queries.size();i++){
+            Query & query = reader.queries[i];
+            const vector<ofXmlPath::Step> & steps = query.path.getSteps();
+            int numElementSteps = steps.size();
+            int done = parentFrame.matched[i];
+            int next = 0;
+            if(done>0 && done<numElementSteps && matches(steps[done],name,index,attributes)){
+                next = done+1;
+            }else if(startsAt(query.path,depth) && matches(steps[0],name,index,attributes)){
+                next = 1;
+            }
+            frame.matched[i] = next;
+            if(next!=numElementSteps) continue;
+
+            // full match
+            const ofXmlPath::Step & last = steps.back();
+            if(query.bElement){
+                if(elementQuery==-1){
+                    elementQuery = i;
+                    elementDepth = depth;
+                    args.path = i;
+                    args.xml.clear();
+                }
+            }else if(query.path.selectsAttribute()){
+                int attr = attributes.getIndex(last.attribute);
+                if(attr>=0) query.values.push_back(attributes.getValue(attr));
+            }else{
+                frame.capturing.push_back(query.values.size());
+                frame.capturingQueries.push_back(i);
+                query.values.push_back("");
+                numCapturing++;
+            }
+        }
+
+        if(elementQuery!=-1){
+            Poco::XML::Document * document = args.xml.document;
+            Poco::AutoPtr<Poco::XML::Element> e = document->createElement(name);
+            for(int i=0;i<attributes.getLength();i++){
+                e->setAttribute(attributes.getQName(i), attributes.getValue(i));
+            }
+            if(building.empty()){
+                document->appendChild(e);
+            }else{
+                building.back()->appendChild(e);
+            }
+            building.push_back(e);
+        }
+    }
+
+    void endElement(const Poco::XML::XMLString&, const Poco::XML::XMLString&, const Poco::XML::XMLString&){
+        Frame & frame = frames.back();
+        numCapturing -= frame.capturing.size();
+
+        if(elementQuery!=-1){
+            building.pop_back();
+            if((int)frames.size()-1==elementDepth){
+                args.xml.element = args.xml.document->documentElement();
+                elementQuery = -1;
+                ofNotifyEvent(reader.elementRead,args,&reader);
+                args.xml.clear();
+                if(reader.bStop) throw ofXmlReaderStop();
+            }
+        }
+        frames.pop_back();
+    }
+
+    void characters(const Poco::XML::XMLChar ch[], int start, int length){
+        if(numCapturing>0){
+            for(int i=1;i<(int)frames.size();i++){
+                Frame & frame = frames[i];
+                for(int j=0;j<(int)frame.capturing.size();j++){
+                    reader.queries[frame.capturingQueries[j]].values[frame.capturing[j]].append(ch+start,length);
+                }
+            }
+        }
+        if(elementQuery!=-1 && !building.empty()){
+            Poco::AutoPtr<Poco::XML::Text> text = args.xml.document->createTextNode(Poco::XML::XMLString(ch+start,length));
+            building.back()->appendChild(text);
+        }
+        if(reader.bStop) throw ofXmlReaderStop();
+    }
+
+private:
+    // paths are relative to the root element like in ofXml, an unnamed
+    // first step is the root element itself
+    static bool startsAt(const ofXmlPath & path, int depth){
+        int first = path.getSteps()[0].name=="" ? 1 : 2;
+        return depth==first || (path.isRecursive() && depth>first);
+    }
+
+    static bool matches(const ofXmlPath::Step & step, const Poco::XML::XMLString & name, int index, const Poco::XML::Attributes & attributes){
+        if(step.name!="" && step.name!="*" && step.name!=name) return false;
+        if(step.bAttributeValue){
+            int attr = attributes.getIndex(step.attribute);
+            return attr>=0 && attributes.getValue(attr)==step.attributeValue;
+        }
+        return step.index<0 || step.index==index;
+    }
+
+    struct Frame{
+        map<string,int> childCounts;
+        vector<int> matched;			// number of steps of each query matched up to this element
+        vector<int> capturing;			// values this element's text is appended to
+        vector<int> capturingQueries;
+    };
+
+    ofXmlReader & reader;
+    vector<Frame> frames;
+    int numCapturing;
+    int elementQuery;
+    int elementDepth;
+    vector<Poco::XML::Element*> building;
+    ofXmlReaderEventArgs args;
+};
+
+ofXmlReader::ofXmlReader()
+:bStop(false){
+}
+
+ofXmlReader::~ofXmlReader(){
+}
+
+int ofXmlReader::addQuery(const string & path, bool bElement){
+    Query query;
+    query.bElement = bElement;
+    if(!query.path.set(path)){
+        ofLogError("ofXmlReader") << "invalid path \"" << path << "\"";
+        return -1;
+    }
+    if(bElement && query.path.selectsAttribute()){
+        ofLogError("ofXmlReader") << "addElementPath(): \"" << path << "\" selects an attribute, use addPath()";
+        return -1;
+    }
+    queries.push_back(query);
+    return queries.size()-1;
+}
+
+int ofXmlReader::addPath(const string & path){
+    return addQuery(path,false);
+}
+
+int ofXmlReader::addElementPath(const string & path){
+    return addQuery(path,true);
+}
+
+void ofXmlReader::clearPaths(){
+    queries.clear();
+}
+
+bool ofXmlReader::load(const string & path){
+    ifstream stream(ofToDataPath(path).c_str(), ios_base::in | ios_base::binary);
+    if(!stream){
+        ofLogError("ofXmlReader") << "load(): couldn't open \"" << path << "\"";
+        return false;
+    }
+    return load(stream);
+}
+
+bool ofXmlReader::loadFromBuffer(const string & buffer){
+    istringstream stream(buffer);
+    return load(stream);
+}
+
+bool ofXmlReader::load(istream & stream){
+    for(int i=0;i<(int)queries.size();i++){
+        queries[i].values.clear();
+    }
+    bStop = false;
+
+    Handler handler(*this);
+    Poco::XML::SAXParser parser;
+    parser.setFeature(Poco::XML::XMLReader::FEATURE_NAMESPACES, false);
+    parser.setContentHandler(&handler);
+    Poco::XML::InputSource source(stream);
+    try{
+        parser.parse(&source);
+    }catch(ofXmlReaderStop &){
+    }catch(Poco::Exception & e){
+        ofLogError("ofXmlReader") << "load(): " << e.displayText();
+        return false;
+    }
+    return true;
+}
+
+void ofXmlReader::stop(){
+    bStop = true;
+}
+
+const vector<string> & ofXmlReader::getValues(int path) const{
+    static vector<string> * empty = new vector<string>;
+    if(path<0 || path>=(int)queries.size()) return *empty;
+    return queries[path].values;
+}
+
+string ofXmlReader::getValue(int path) const{
+    const vector<string> & values = getValues(path);
+    return values.empty() ? "" : values[0];
+}
+
+int ofXmlReader::getNumValues(int path) const{
+    return getValues(path).size();
+}
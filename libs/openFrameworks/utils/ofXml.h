@@ -24,6 +24,50 @@
 #include <Poco/DOM/NodeFilter.h>
 #include <Poco/DOM/NamedNodeMap.h>  
 #include <Poco/DOM/ChildNodesList.h>
+#include <Poco/SAX/DefaultHandler.h>
+
+// a path parsed once so it can be used many times without splitting the
+// string again, useful for values that are read or written every frame
+// or for many elements. supports the same syntax as the string paths:
+//
+// "settings/window/width"
+// "settings/window[1]"				second window, indices start at 0
+// "settings/window[@id='main']"	window with an attribute id = main
+// "settings/window[@id]"			the id attribute of the first window
+// "settings/window/@id"			same
+// "//window"						first window anywhere inside the element
+//
+// ofXmlPath width("settings/window/width");
+// int w = xml.getIntValue(width);
+
+class ofXmlPath{
+public:
+	ofXmlPath();
+	explicit ofXmlPath(const string & path);
+
+	bool set(const string & path);
+	const string & toString() const;
+	bool isValid() const;
+
+	struct Step{
+		Step():index(-1),bAttributeValue(false){}
+		string name;			// empty for the current element
+		int index;				// -1 for the first one
+		string attribute;		// filter by or, if it's the last step and there's no value, select this attribute
+		string attributeValue;
+		bool bAttributeValue;
+	};
+
+	const vector<Step> & getSteps() const;
+	bool isRecursive() const;		// starts with //, the first step can be at any depth
+	bool selectsAttribute() const;	// the last step selects an attribute instead of an element
+
+private:
+	string path;
+	vector<Step> steps;
+	bool bRecursive;
+	bool bValid;
+};
 
 class ofXml: public ofBaseFileSerializer {
     
@@ -70,6 +114,17 @@ public:
     						  // if the current element is the document root this will act as clear()
 
     bool            exists(const string& path) const; // works for both attributes and tags
+
+    // same as the string versions but with precompiled paths, see ofXmlPath
+    string          getValue(const ofXmlPath & path) const;
+    int             getIntValue(const ofXmlPath & path) const;
+    float           getFloatValue(const ofXmlPath & path) const;
+    bool            getBoolValue(const ofXmlPath & path) const;
+    bool            setValue(const ofXmlPath & path, const string& value);
+    string          getAttribute(const ofXmlPath & path) const;
+    bool            setAttribute(const ofXmlPath & path, const string& value);
+    bool            exists(const ofXmlPath & path) const;
+    bool            setTo(const ofXmlPath & path);
     
     void			clear();  // clears the full document and points the current element to the root
 
@@ -232,8 +287,14 @@ public:
     Poco::XML::Document*       getPocoDocument();
     const Poco::XML::Document* getPocoDocument() const;
 
+    // element or attribute, NULL if the path doesn't exist
+    Poco::XML::Node*           getPocoNode(const ofXmlPath & path) const;
+
        
 protected:
+    friend class ofXmlReader;
+
+    bool setValue(Poco::XML::Element * e, const string & value);
     void releaseAll();
     string DOMErrorMessage(short msg);
 
@@ -241,3 +302,70 @@ protected:
     Poco::XML::Element *element;
     
 };
+
+
+class ofXmlReaderEventArgs : public ofEventArgs {
+public:
+	int path;		// index returned by ofXmlReader::addElementPath
+	ofXml xml;		// the element that matched and everything inside it
+};
+
+// reads xml files as a stream, without building the document, and keeps only
+// the parts that are needed. memory and time stay low with huge files.
+//
+// ofXmlReader reader;
+// int fov = reader.addPath("camera/fov");
+// int objects = reader.addElementPath("objects/object");
+// ofAddListener(reader.elementRead,this,&testApp::objectRead);
+// reader.load("scene.xml");
+// float f = ofToFloat(reader.getValue(fov));
+//
+// Info:
+// addPath collects the text of every element, or the value of every
+// attribute, that matches. addElementPath builds each matching element
+// as a small ofXml and notifies it in elementRead, it's only valid during
+// the notification. paths start at the root element, like in ofXml after
+// load(), they can't go up (../) and indices count the
+// elements with the same name inside the same parent
+// stop() can be called from a listener to finish reading early
+
+class ofXmlReader{
+public:
+	ofXmlReader();
+	virtual ~ofXmlReader();
+
+	int addPath(const string & path);
+	int addElementPath(const string & path);
+	void clearPaths();
+
+	bool load(const string & path);
+	bool loadFromBuffer(const string & buffer);
+	bool load(istream & stream);
+	void stop();
+
+	// values found for a path added with addPath, in document order
+	const vector<string> & getValues(int path) const;
+	// the first value found or ""
+	string getValue(int path) const;
+	int getNumValues(int path) const;
+
+	ofEvent<ofXmlReaderEventArgs> elementRead;
+
+private:
+	ofXmlReader(const ofXmlReader &);
+	ofXmlReader & operator=(const ofXmlReader &);
+
+	class Handler;
+	friend class Handler;
+
+	struct Query{
+		ofXmlPath path;
+		bool bElement;
+		vector<string> values;
+	};
+
+	int addQuery(const string & path, bool bElement);
+
+	vector<Query> queries;
+	bool bStop;
+};
@@ -680,12 +680,22 @@ uint64_t ofGstUtils::getMaxLatencyNanos(){
 
 
 
+ofGstVideoUtils::Frame::Frame(){
+	buffer = 0;
+	pts = -1;
+	bPresented = false;
+}
+
 ofGstVideoUtils::ofGstVideoUtils(){
 	bIsFrameNew					= false;
 	bHavePixelsChanged			= false;
-	bBackPixelsChanged			= false;
-	buffer = 0;
+	bTimedUpdatesOnly			= false;
 	prevBuffer = 0;
+	prevBufferPts = -1;
+	frames.resize(1);
+	firstFrame = 0;
+	numFrames = 0;
+	numDroppedFrames = 0;
 #if GST_VERSION_MAJOR==1
 	GstMapInfo initMapinfo		= {0,};
 	mapinfo 					= initMapinfo;
@@ -700,19 +710,12 @@ void ofGstVideoUtils::close(){
 	ofGstUtils::close();
 	Poco::ScopedLock<ofMutex> lock(mutex);
 	pixels.clear();
-	backPixels.clear();
 	bIsFrameNew					= false;
 	bHavePixelsChanged			= false;
-	bBackPixelsChanged			= false;
-#if GST_VERSION_MAJOR==0
-	if(prevBuffer) gst_buffer_unref (prevBuffer);
-	if(buffer) gst_buffer_unref (buffer);
-#else
-	if(prevBuffer) gst_sample_unref (prevBuffer);
-	if(buffer) gst_sample_unref (buffer);
-#endif
+	clearFrames();
+	if(prevBuffer) unrefBuffer(prevBuffer);
 	prevBuffer = 0;
-	buffer = 0;
+	prevBufferPts = -1;
 }
 
 bool ofGstVideoUtils::isFrameNew(){
@@ -728,21 +731,22 @@ ofPixelsRef ofGstVideoUtils::getPixelsRef(){
 }
 
 void ofGstVideoUtils::update(){
+	// the frame was already chosen by update(timeNanos)
+	if(bTimedUpdatesOnly && isLoaded() && !isFrameByFrame()){
+		return;
+	}
 	if (isLoaded()){
 		if(!isFrameByFrame()){
 			mutex.lock();
-				bHavePixelsChanged = bBackPixelsChanged;
-				if (bHavePixelsChanged){
-					bBackPixelsChanged=false;
-					pixels.swap(backPixels);
-#if GST_VERSION_MAJOR==0
-					if(prevBuffer) gst_buffer_unref (prevBuffer);
-#else
-					if(prevBuffer) gst_sample_unref (prevBuffer);
-#endif
-					prevBuffer = buffer;
+				// the newest frame is always shown, the rest stay in
+				// the queue so they can still be retrieved by timestamp
+				if(numFrames>0){
+					int newest = (firstFrame+numFrames-1)%frames.size();
+					if(!frames[newest].bPresented){
+						presentFrame(frames[newest]);
+						bHavePixelsChanged = true;
+					}
 				}
-
 			mutex.unlock();
 		}else{
 #if GST_VERSION_MAJOR==0
@@ -755,8 +759,9 @@ void ofGstVideoUtils::update(){
 			if(buffer){
 				if(pixels.isAllocated()){
 					if(prevBuffer) gst_buffer_unref (prevBuffer);
-					pixels.setFromExternalPixels(GST_BUFFER_DATA (buffer),pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
+					pixels.setFromExternalPixels(GST_BUFFER_DATA (buffer),pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
 					prevBuffer = buffer;
+					prevBufferPts = getTimestamp(buffer);
 					bHavePixelsChanged=true;
 				}
 			}
@@ -778,8 +783,9 @@ void ofGstVideoUtils::update(){
 					if(prevBuffer) gst_sample_unref (prevBuffer);
 					gst_buffer_map (buffer, &mapinfo, GST_MAP_READ);
 					//TODO: stride = mapinfo.size / height;
-					pixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
+					pixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
 					prevBuffer = sample;
+					prevBufferPts = getTimestamp(sample);
 					bHavePixelsChanged=true;
 					gst_buffer_unmap(buffer,&mapinfo);
 				}
@@ -793,6 +799,90 @@ void ofGstVideoUtils::update(){
 	bHavePixelsChanged = false;
 }
 
+void ofGstVideoUtils::update(int64_t timeNanos){
+	if(isLoaded() && !isFrameByFrame()){
+		mutex.lock();
+			Frame * frame = findFrame(timeNanos);
+			if(frame && frame->buffer!=prevBuffer){
+				presentFrame(*frame);
+				bHavePixelsChanged = true;
+			}
+		mutex.unlock();
+		bIsFrameNew = bHavePixelsChanged;
+		bHavePixelsChanged = false;
+	}else{
+		update();
+	}
+}
+
+ofPixelsRef ofGstVideoUtils::getFrameAt(int64_t timeNanos){
+	Poco::ScopedLock<ofMutex> lock(mutex);
+	Frame * frame = findFrame(timeNanos);
+	if(frame && frame->buffer!=prevBuffer){
+		presentFrame(*frame);
+		bIsFrameNew = true;
+	}
+	return pixels;
+}
+
+ofGstVideoUtils::Frame * ofGstVideoUtils::findFrame(int64_t timeNanos){
+	if(numFrames==0){
+		return NULL;
+	}
+
+	// frames arrive in presentation order so the last one that starts
+	// before the requested time is the one that should be on screen
+	Frame * frame = &frames[firstFrame];
+	for(int i=1;i<numFrames;i++){
+		Frame & next = frames[(firstFrame+i)%frames.size()];
+		if(next.pts!=-1 && next.pts>timeNanos) break;
+		frame = &next;
+	}
+	return frame;
+}
+
+int64_t ofGstVideoUtils::getFrameTimestampNanos(){
+	return prevBufferPts;
+}
+
+void ofGstVideoUtils::setTimedUpdatesOnly(bool bTimedOnly){
+	bTimedUpdatesOnly = bTimedOnly;
+}
+
+bool ofGstVideoUtils::getTimedUpdatesOnly(){
+	return bTimedUpdatesOnly;
+}
+
+void ofGstVideoUtils::setFrameQueueSize(int size){
+	if(size<1){
+		ofLogWarning("ofGstVideoUtils") << "setFrameQueueSize(): queue needs at least 1 frame, got " << size;
+		size = 1;
+	}
+	Poco::ScopedLock<ofMutex> lock(mutex);
+	clearFrames();
+	frames.resize(size);
+}
+
+int ofGstVideoUtils::getFrameQueueSize(){
+	Poco::ScopedLock<ofMutex> lock(mutex);
+	return frames.size();
+}
+
+int ofGstVideoUtils::getNumQueuedFrames(){
+	Poco::ScopedLock<ofMutex> lock(mutex);
+	return numFrames;
+}
+
+int ofGstVideoUtils::getNumDroppedFrames(){
+	Poco::ScopedLock<ofMutex> lock(mutex);
+	return numDroppedFrames;
+}
+
+void ofGstVideoUtils::resetNumDroppedFrames(){
+	Poco::ScopedLock<ofMutex> lock(mutex);
+	numDroppedFrames = 0;
+}
+
 float ofGstVideoUtils::getHeight(){
 	return pixels.getHeight();
 }
@@ -834,33 +924,130 @@ bool ofGstVideoUtils::setPipeline(string pipeline, int bpp, bool isStream, int w
 }
 
 bool ofGstVideoUtils::allocate(int w, int h, int _bpp){
+	// pixels might be pointing to the last frame so don't reuse them
+	pixels.clear();
 	pixels.allocate(w,h,_bpp/8);
-	backPixels.allocate(w,h,_bpp/8);
+	if(prevBuffer) unrefBuffer(prevBuffer);
 	prevBuffer = 0;
+	prevBufferPts = -1;
 	pixels.set(0);
 
 	bHavePixelsChanged = pixels.isAllocated();
 	return pixels.isAllocated();
 }
 
+bool ofGstVideoUtils::allocate(int w, int h, ofPixelFormat pixelFormat){
+	pixels.clear();
+	pixels.allocate(w,h,pixelFormat);
+	if(prevBuffer) unrefBuffer(prevBuffer);
+	prevBuffer = 0;
+	prevBufferPts = -1;
+	pixels.set(0);
+	if(pixels.getNumPlanes()>1){
+		// black in yuv has the chroma at the middle of the range
+		memset(pixels.getPlane(1),128,pixels.size()-pixels.getWidth()*pixels.getHeight());
+	}
+
+	bHavePixelsChanged = pixels.isAllocated();
+	return pixels.isAllocated();
+}
+
+#if GST_VERSION_MAJOR==0
+void ofGstVideoUtils::unrefBuffer(GstBuffer * buffer){
+	gst_buffer_unref (buffer);
+}
+
+void ofGstVideoUtils::refBuffer(GstBuffer * buffer){
+	gst_buffer_ref (buffer);
+}
+
+int64_t ofGstVideoUtils::getTimestamp(GstBuffer * buffer){
+	GstClockTime pts = GST_BUFFER_TIMESTAMP (buffer);
+	return GST_CLOCK_TIME_IS_VALID(pts) ? (int64_t)pts : -1;
+}
+#else
+void ofGstVideoUtils::unrefBuffer(GstSample * buffer){
+	gst_sample_unref (buffer);
+}
+
+void ofGstVideoUtils::refBuffer(GstSample * buffer){
+	gst_sample_ref (buffer);
+}
+
+int64_t ofGstVideoUtils::getTimestamp(GstSample * sample){
+	GstClockTime pts = GST_BUFFER_PTS (gst_sample_get_buffer(sample));
+	return GST_CLOCK_TIME_IS_VALID(pts) ? (int64_t)pts : -1;
+}
+#endif
+
+#if GST_VERSION_MAJOR==0
+void ofGstVideoUtils::pushFrame(GstBuffer * buffer, unsigned char * data){
+#else
+void ofGstVideoUtils::pushFrame(GstSample * buffer, unsigned char * data){
+#endif
+	// when the queue is full the oldest frame makes room for the new one,
+	// it only counts as dropped if it was never shown
+	if(numFrames==(int)frames.size()){
+		Frame & oldest = frames[firstFrame];
+		if(!oldest.bPresented) numDroppedFrames++;
+		releaseFrame(oldest);
+		firstFrame = (firstFrame+1)%frames.size();
+		numFrames--;
+	}
+	Frame & frame = frames[(firstFrame+numFrames)%frames.size()];
+	frame.buffer = buffer;
+	frame.pts = getTimestamp(buffer);
+	frame.bPresented = false;
+	frame.pixels.setFromExternalPixels(data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
+	numFrames++;
+}
+
+void ofGstVideoUtils::presentFrame(Frame & frame){
+	// the current pixels keep their own reference so the frame can
+	// leave the queue while it's still being used
+	refBuffer(frame.buffer);
+	if(prevBuffer) unrefBuffer(prevBuffer);
+	prevBuffer = frame.buffer;
+	prevBufferPts = frame.pts;
+	pixels.setFromExternalPixels(frame.pixels.getPixels(),frame.pixels.getWidth(),frame.pixels.getHeight(),frame.pixels.getPixelFormat());
+	frame.bPresented = true;
+}
+
+void ofGstVideoUtils::releaseFrame(Frame & frame){
+	if(frame.buffer) unrefBuffer(frame.buffer);
+	frame.buffer = 0;
+	frame.pts = -1;
+	frame.bPresented = false;
+	frame.pixels.clear();
+}
+
+void ofGstVideoUtils::clearFrames(){
+	for(int i=0;i<(int)frames.size();i++){
+		releaseFrame(frames[i]);
+	}
+	firstFrame = 0;
+	numFrames = 0;
+}
+
 #if GST_VERSION_MAJOR==0
 GstFlowReturn ofGstVideoUtils::preroll_cb(GstBuffer * _buffer){
 	guint size = GST_BUFFER_SIZE (_buffer);
-	if(pixels.isAllocated() && pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel()!=(int)size){
+	if(pixels.isAllocated() && pixels.size()!=(int)size){
 		ofLogError("ofGstVideoUtils") << "preproll_cb(): error preroll buffer size: " << size
-			<< "!= init size: " << pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel();
+			<< "!= init size: " << pixels.size();
 		gst_buffer_unref (_buffer);
 		return GST_FLOW_ERROR;
 	}
 	mutex.lock();
-	if(bBackPixelsChanged && buffer) gst_buffer_unref (buffer);
 	if(pixels.isAllocated()){
-		buffer = _buffer;
-		backPixels.setFromExternalPixels(GST_BUFFER_DATA (buffer),pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		eventPixels.setFromExternalPixels(GST_BUFFER_DATA (buffer),pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		bBackPixelsChanged=true;
+		// a preroll starts a new segment, after a seek the queued
+		// frames belong to the old position
+		clearFrames();
+		pushFrame(_buffer,GST_BUFFER_DATA (_buffer));
+		eventPixels.setFromExternalPixels(GST_BUFFER_DATA (_buffer),pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
 		mutex.unlock();
 		ofNotifyEvent(prerollEvent,eventPixels);
+		return ofGstUtils::preroll_cb(_buffer);
 	}else{
 		if(isStream && appsink){
 			appsink->on_stream_prepared();
@@ -868,29 +1055,34 @@ GstFlowReturn ofGstVideoUtils::preroll_cb(GstBuffer * _buffer){
 			ofLogError("ofGstVideoUtils") << "preroll_cb(): received a preroll without allocation";
 		}
 		mutex.unlock();
+		GstFlowReturn ret = ofGstUtils::preroll_cb(_buffer);
+		gst_buffer_unref (_buffer);
+		return ret;
 	}
-	return ofGstUtils::preroll_cb(_buffer);
 }
 #else
 GstFlowReturn ofGstVideoUtils::preroll_cb(GstSample * sample){
 	GstBuffer * _buffer = gst_sample_get_buffer(sample);
 	gst_buffer_map (_buffer, &mapinfo, GST_MAP_READ);
 	guint size = mapinfo.size;
-	if(pixels.isAllocated() && pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel()!=(int)size){
+	if(pixels.isAllocated() && pixels.size()!=(int)size){
 		ofLogError("ofGstVideoUtils") << "preproll_cb(): error preroll buffer size: " << size
-			<< "!= init size: " << pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel();
+			<< "!= init size: " << pixels.size();
+		gst_buffer_unmap(_buffer,&mapinfo);
 		gst_sample_unref (sample);
 		return GST_FLOW_ERROR;
 	}
 	mutex.lock();
-	if(bBackPixelsChanged && buffer) gst_sample_unref (buffer);
-	buffer = sample;
 	if(pixels.isAllocated()){
-		backPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		eventPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		bBackPixelsChanged=true;
+		// a preroll starts a new segment, after a seek the queued
+		// frames belong to the old position
+		clearFrames();
+		pushFrame(sample,mapinfo.data);
+		eventPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
 		mutex.unlock();
 		ofNotifyEvent(prerollEvent,eventPixels);
+		gst_buffer_unmap(_buffer,&mapinfo);
+		return ofGstUtils::preroll_cb(sample);
 	}else{
 		if(isStream && appsink){
 			appsink->on_stream_prepared();
@@ -898,9 +1090,11 @@ GstFlowReturn ofGstVideoUtils::preroll_cb(GstSample * sample){
 			ofLogWarning("ofGstVideoUtils") << "preroll_cb(): received a preroll without allocation";
 		}
 		mutex.unlock();
+		gst_buffer_unmap(_buffer,&mapinfo);
+		GstFlowReturn ret = ofGstUtils::preroll_cb(sample);
+		gst_sample_unref (sample);
+		return ret;
 	}
-	gst_buffer_unmap(_buffer,&mapinfo);
-	return ofGstUtils::preroll_cb(sample);
 }
 #endif
 
@@ -910,21 +1104,19 @@ GstFlowReturn ofGstVideoUtils::buffer_cb(GstBuffer * _buffer){
 	guint size;
 
 	size = GST_BUFFER_SIZE (_buffer);
-	if(pixels.isAllocated() && pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel()!=(int)size){
+	if(pixels.isAllocated() && pixels.size()!=(int)size){
 		ofLogError("ofGstVideoUtils") << "buffer_cb(): error on new buffer, buffer size: " << size
-			<< " != init size: " << pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel();
+			<< " != init size: " << pixels.size();
 		gst_buffer_unref (_buffer);
 		return GST_FLOW_ERROR;
 	}
 	mutex.lock();
-	if(bBackPixelsChanged && buffer) gst_buffer_unref (buffer);
 	if(pixels.isAllocated()){
-		buffer = _buffer;
-		backPixels.setFromExternalPixels(GST_BUFFER_DATA (buffer),pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		eventPixels.setFromExternalPixels(GST_BUFFER_DATA (buffer),pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		bBackPixelsChanged=true;
+		pushFrame(_buffer,GST_BUFFER_DATA (_buffer));
+		eventPixels.setFromExternalPixels(GST_BUFFER_DATA (_buffer),pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
 		mutex.unlock();
 		ofNotifyEvent(bufferEvent,eventPixels);
+		return ofGstUtils::buffer_cb(_buffer);
 	}else{
 		if(isStream && appsink){
 			appsink->on_stream_prepared();
@@ -932,30 +1124,31 @@ GstFlowReturn ofGstVideoUtils::buffer_cb(GstBuffer * _buffer){
 			ofLogWarning("ofGSstVideoUtils") << "buffer_cb(): received a preroll without allocation";
 		}
 		mutex.unlock();
+		GstFlowReturn ret = ofGstUtils::buffer_cb(_buffer);
+		gst_buffer_unref (_buffer);
+		return ret;
 	}
-
-	return ofGstUtils::buffer_cb(buffer);
 }
 #else
 GstFlowReturn ofGstVideoUtils::buffer_cb(GstSample * sample){
 	GstBuffer * _buffer = gst_sample_get_buffer(sample);
 	gst_buffer_map (_buffer, &mapinfo, GST_MAP_READ);
 	guint size = mapinfo.size;
-	if(pixels.isAllocated() && pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel()!=(int)size){
+	if(pixels.isAllocated() && pixels.size()!=(int)size){
 		ofLogError("ofGstVideoUtils") << "buffer_cb(): error on new buffer, buffer size: " << size
-			<< "!= init size: " << pixels.getWidth()*pixels.getHeight()*pixels.getBytesPerPixel();
+			<< "!= init size: " << pixels.size();
+		gst_buffer_unmap(_buffer,&mapinfo);
 		gst_sample_unref (sample);
 		return GST_FLOW_ERROR;
 	}
 	mutex.lock();
-	if(bBackPixelsChanged && buffer) gst_sample_unref (buffer);
-	buffer = sample;
 	if(pixels.isAllocated()){
-		backPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		eventPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getNumChannels());
-		bBackPixelsChanged=true;
+		pushFrame(sample,mapinfo.data);
+		eventPixels.setFromExternalPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat());
 		mutex.unlock();
 		ofNotifyEvent(bufferEvent,eventPixels);
+		gst_buffer_unmap(_buffer,&mapinfo);
+		return ofGstUtils::buffer_cb(sample);
 	}else{
 		if(isStream && appsink){
 			appsink->on_stream_prepared();
@@ -963,9 +1156,11 @@ GstFlowReturn ofGstVideoUtils::buffer_cb(GstSample * sample){
 			ofLogWarning("ofGstVideoUtils") << "buffer_cb(): received a preroll without allocation";
 		}
 		mutex.unlock();
+		gst_buffer_unmap(_buffer,&mapinfo);
+		GstFlowReturn ret = ofGstUtils::buffer_cb(sample);
+		gst_sample_unref (sample);
+		return ret;
 	}
-	gst_buffer_unmap(_buffer,&mapinfo);
-	return ofGstUtils::buffer_cb(buffer);
 }
 #endif
 
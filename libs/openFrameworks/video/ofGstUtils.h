@@ -136,12 +136,41 @@ public:
 	bool 			setPipeline(string pipeline, int bpp=24, bool isStream=false, int w=-1, int h=-1);
 
 	bool 			allocate(int w, int h, int bpp);
+	bool 			allocate(int w, int h, ofPixelFormat pixelFormat);
 
 	bool 			isFrameNew();
 	unsigned char * getPixels();
 	ofPixelsRef		getPixelsRef();
 	void 			update();
 
+	// like update() but makes current the queued frame that should be on
+	// screen at timeNanos instead of the newest one, see getFrameAt()
+	void			update(int64_t timeNanos);
+
+	// decoded frames are kept in a queue of this many frames, 1 by default.
+	// when it's full the oldest one is released to make room for the new
+	// one, and counted as dropped if it was never shown
+	void			setFrameQueueSize(int size);
+	int				getFrameQueueSize();
+	int				getNumQueuedFrames();
+	int				getNumDroppedFrames();
+	void			resetNumDroppedFrames();
+
+	// makes current the last queued frame with a presentation timestamp
+	// before or at timeNanos, or the oldest if all of them are later.
+	// update() always makes current the newest frame
+	ofPixelsRef		getFrameAt(int64_t timeNanos);
+
+	// presentation timestamp of the current frame or -1 if unknown
+	int64_t			getFrameTimestampNanos();
+
+	// when enabled update() without a time doesn't change the current
+	// frame or isFrameNew(), the frames are only chosen by timestamp.
+	// ofGstVideoPool enables it for its videos so updating a player
+	// doesn't replace the frame the pool picked with the newest one
+	void			setTimedUpdatesOnly(bool bTimedOnly);
+	bool			getTimedUpdatesOnly();
+
 	float 			getHeight();
 	float 			getWidth();
 
@@ -165,17 +194,49 @@ protected:
 
 
 	ofPixels		pixels;				// 24 bit: rgb
-	ofPixels		backPixels;
 	ofPixels		eventPixels;
 private:
+	struct Frame{
+		Frame();
+		ofPixels	pixels;
+#if GST_VERSION_MAJOR==0
+		GstBuffer *	buffer;
+#else
+		GstSample *	buffer;
+#endif
+		int64_t		pts;
+		bool		bPresented;
+	};
+
+#if GST_VERSION_MAJOR==0
+	void			pushFrame(GstBuffer * buffer, unsigned char * data);
+	static void		refBuffer(GstBuffer * buffer);
+	static void		unrefBuffer(GstBuffer * buffer);
+	static int64_t	getTimestamp(GstBuffer * buffer);
+#else
+	void			pushFrame(GstSample * buffer, unsigned char * data);
+	static void		refBuffer(GstSample * buffer);
+	static void		unrefBuffer(GstSample * buffer);
+	static int64_t	getTimestamp(GstSample * buffer);
+#endif
+	Frame *			findFrame(int64_t timeNanos);
+	void			presentFrame(Frame & frame);
+	void			releaseFrame(Frame & frame);
+	void			clearFrames();
+
 	bool			bIsFrameNew;			// if we are new
 	bool			bHavePixelsChanged;
-	bool			bBackPixelsChanged;
+	bool			bTimedUpdatesOnly;
 	ofMutex			mutex;
+	vector<Frame>	frames;					// ring of decoded frames
+	int				firstFrame;
+	int				numFrames;
+	int				numDroppedFrames;
+	int64_t			prevBufferPts;
 #if GST_VERSION_MAJOR==0
-	GstBuffer * 	buffer, *prevBuffer;
+	GstBuffer * 	prevBuffer;				// frame backing pixels
 #else
-	GstSample * 	buffer, *prevBuffer;
+	GstSample * 	prevBuffer;				// frame backing pixels
 	GstMapInfo mapinfo;
 #endif
 };
@@ -614,6 +614,8 @@ ofPixelFormat ofPixelFormatFromGstFormat(string format){
 	case GST_VIDEO_FORMAT_BGRA: return OF_PIXELS_BGRA;
 	case GST_VIDEO_FORMAT_GRAY8: return OF_PIXELS_MONO;
 	case GST_VIDEO_FORMAT_RGB16: return OF_PIXELS_RGB565;
+	case GST_VIDEO_FORMAT_I420: return OF_PIXELS_I420;
+	case GST_VIDEO_FORMAT_NV12: return OF_PIXELS_NV12;
 	default: return OF_PIXELS_UNKNOWN;
 	}
 #else
@@ -108,6 +108,18 @@ bool ofGstVideoPlayer::loadMovie(string name){
 			"alpha_mask",G_TYPE_INT,0x000000ff,
 			NULL);
 		break;
+	case OF_PIXELS_I420:
+		bpp = 12;
+		caps = gst_caps_new_simple("video/x-raw-yuv",
+			"format", GST_TYPE_FOURCC, GST_MAKE_FOURCC('I','4','2','0'),
+			NULL);
+		break;
+	case OF_PIXELS_NV12:
+		bpp = 12;
+		caps = gst_caps_new_simple("video/x-raw-yuv",
+			"format", GST_TYPE_FOURCC, GST_MAKE_FOURCC('N','V','1','2'),
+			NULL);
+		break;
 	default:
 		bpp = 32;
 		caps = gst_caps_new_simple("video/x-raw-rgb",
@@ -141,6 +153,16 @@ bool ofGstVideoPlayer::loadMovie(string name){
 		format = "BGRA";
 		bpp = 32;
 		break;
+	// yuv is what most decoders output so asking for it keeps
+	// the videoconvert in playbin in passthrough
+	case OF_PIXELS_I420:
+		format = "I420";
+		bpp = 12;
+		break;
+	case OF_PIXELS_NV12:
+		format = "NV12";
+		bpp = 12;
+		break;
 	default:
 		format = "RGB";
 		bpp=24;
@@ -209,7 +231,7 @@ bool ofGstVideoPlayer::allocate(int bpp){
 #if GST_VERSION_MAJOR==0
 		int width,height;
 		if(gst_video_get_size(GST_PAD(pad), &width, &height)){
-			if(!videoUtils.allocate(width,height,bpp)) return false;
+			if(!allocatePixels(width,height,bpp)) return false;
 		}else{
 			ofLogError("ofGstVideoPlayer") << "allocate(): couldn't query width and height";
 			return false;
@@ -232,7 +254,7 @@ bool ofGstVideoPlayer::allocate(int bpp){
 			GstVideoInfo info;
 			gst_video_info_init (&info);
 			if (gst_video_info_from_caps (&info, caps)){
-				if(!videoUtils.allocate(info.width,info.height,bpp)) return false;
+				if(!allocatePixels(info.width,info.height,bpp)) return false;
 			}else{
 				ofLogError("ofGstVideoPlayer") << "allocate(): couldn't query width and height";
 				return false;
@@ -257,6 +279,14 @@ bool ofGstVideoPlayer::allocate(int bpp){
 	return bIsAllocated;
 }
 
+bool ofGstVideoPlayer::allocatePixels(int width, int height, int bpp){
+	if(internalPixelFormat==OF_PIXELS_I420 || internalPixelFormat==OF_PIXELS_NV12){
+		return videoUtils.allocate(width,height,internalPixelFormat);
+	}else{
+		return videoUtils.allocate(width,height,bpp);
+	}
+}
+
 void ofGstVideoPlayer::on_stream_prepared(){
 	if(!bIsAllocated) allocate(24);
 }
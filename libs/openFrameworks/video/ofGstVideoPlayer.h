@@ -61,6 +61,7 @@ public:
 
 protected:
 	bool	allocate(int bpp);
+	bool	allocatePixels(int width, int height, int bpp);
 	void	on_stream_prepared();
 
 	// return true to set the message as attended so upstream doesn't try to process it
@@ -0,0 +1,286 @@
+#include "ofGstVideoPool.h"
+#include <algorithm>
+
+//-------------------------------------------------
+ofGstVideoPool::ofGstVideoPool()
+:clock(NULL)
+,baseTime(0)
+,pausedRunningTime(0)
+,startDelay(50*GST_MSECOND)
+,loopState(OF_LOOP_NORMAL)
+,bPlaying(false)
+,bPaused(true){
+}
+
+//-------------------------------------------------
+ofGstVideoPool::~ofGstVideoPool(){
+	clear();
+	if(clock) gst_object_unref(clock);
+}
+
+//-------------------------------------------------
+bool ofGstVideoPool::add(ofGstVideoPlayer & player){
+	return add(*player.getGstVideoUtils());
+}
+
+//-------------------------------------------------
+bool ofGstVideoPool::add(ofGstVideoUtils & video){
+	if(find(videos.begin(),videos.end(),&video)!=videos.end()){
+		return true;
+	}
+	if(!video.isLoaded() || !video.getPipeline()){
+		ofLogError("ofGstVideoPool") << "add(): video needs to be loaded before adding it to the pool";
+		return false;
+	}
+
+	// the system clock is created by gstreamer so it can only be
+	// obtained once some video has initialized it
+	if(!clock){
+		clock = gst_system_clock_obtain();
+	}
+
+	// with no start time the pipeline keeps the base time set by the
+	// pool instead of calculating a new one every time it goes to playing
+	GstElement * pipeline = video.getPipeline();
+	gst_pipeline_use_clock(GST_PIPELINE(pipeline),clock);
+	gst_element_set_start_time(pipeline,GST_CLOCK_TIME_NONE);
+
+	// a few frames of margin so update() can pick the frame
+	// for the pool time even if the sinks deliver them a bit early
+	video.setLoopState(OF_LOOP_NONE);
+	if(video.getFrameQueueSize()<3){
+		video.setFrameQueueSize(3);
+	}
+	// only the pool chooses the frames, updating the player
+	// would show the newest one
+	video.setTimedUpdatesOnly(true);
+
+	videos.push_back(&video);
+	segmentStarts.push_back(0);
+
+	// a video added while the pool is running joins it at the current
+	// position so every video has to be realigned
+	if(bPlaying){
+		bool wasPaused = bPaused;
+		pausePipelines();
+		vector<int64_t> positions(videos.size());
+		for(int i=0;i<(int)videos.size();i++){
+			positions[i] = segmentStarts[i] + pausedRunningTime;
+		}
+		seekPipelines(positions);
+		if(!wasPaused) play();
+	}else{
+		video.setPaused(true);
+	}
+	return true;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::remove(ofGstVideoPlayer & player){
+	remove(*player.getGstVideoUtils());
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::remove(ofGstVideoUtils & video){
+	vector<ofGstVideoUtils*>::iterator it = find(videos.begin(),videos.end(),&video);
+	if(it==videos.end()) return;
+
+	GstElement * pipeline = video.getPipeline();
+	if(pipeline){
+		gst_pipeline_auto_clock(GST_PIPELINE(pipeline));
+		gst_element_set_start_time(pipeline,0);
+	}
+	video.setFrameQueueSize(1);
+	video.setTimedUpdatesOnly(false);
+
+	segmentStarts.erase(segmentStarts.begin() + (it-videos.begin()));
+	videos.erase(it);
+	if(videos.empty()){
+		bPlaying = false;
+		bPaused = true;
+		pausedRunningTime = 0;
+	}
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::clear(){
+	while(!videos.empty()){
+		remove(*videos.back());
+	}
+}
+
+//-------------------------------------------------
+int ofGstVideoPool::size(){
+	return videos.size();
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::play(){
+	if(videos.empty() || (bPlaying && !bPaused)) return;
+
+	// every pipeline has to be prerolled before setting the base time
+	// so none of them starts late
+	for(int i=0;i<(int)videos.size();i++){
+		if(!videos[i]->isPlaying()) videos[i]->setPaused(true);
+	}
+	waitForPreroll();
+
+	baseTime = gst_clock_get_time(clock) + startDelay - pausedRunningTime;
+	for(int i=0;i<(int)videos.size();i++){
+		gst_element_set_base_time(videos[i]->getPipeline(),baseTime);
+		videos[i]->setPaused(false);
+	}
+	bPlaying = true;
+	bPaused = false;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::stop(){
+	for(int i=0;i<(int)videos.size();i++){
+		videos[i]->stop();
+		segmentStarts[i] = 0;
+	}
+	pausedRunningTime = 0;
+	bPlaying = false;
+	bPaused = true;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::setPaused(bool bPause){
+	if(bPause){
+		pausePipelines();
+	}else{
+		play();
+	}
+}
+
+//-------------------------------------------------
+bool ofGstVideoPool::isPaused(){
+	return bPaused;
+}
+
+//-------------------------------------------------
+bool ofGstVideoPool::isPlaying(){
+	return bPlaying;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::setPosition(float pct){
+	if(videos.empty()) return;
+	bool wasPaused = bPaused;
+	pausePipelines();
+	vector<int64_t> positions(videos.size());
+	for(int i=0;i<(int)videos.size();i++){
+		positions[i] = (double)pct * (double)videos[i]->getDurationNanos();
+	}
+	seekPipelines(positions);
+	if(!wasPaused) play();
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::setLoopState(ofLoopType state){
+	if(state==OF_LOOP_PALINDROME){
+		ofLogWarning("ofGstVideoPool") << "setLoopState(): palindrome loop not supported, using normal loop";
+		state = OF_LOOP_NORMAL;
+	}
+	loopState = state;
+}
+
+//-------------------------------------------------
+ofLoopType ofGstVideoPool::getLoopState(){
+	return loopState;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::update(){
+	if(videos.empty()) return;
+
+	// the same running time maps to the same instant in every pipeline
+	// so choosing the frame by time keeps them in sync even if the
+	// sinks deliver them at slightly different moments
+	int64_t runningTime = getRunningTimeNanos();
+	bool bAllDone = true;
+	for(int i=0;i<(int)videos.size();i++){
+		videos[i]->update(segmentStarts[i] + runningTime);
+		bAllDone &= videos[i]->getIsMovieDone();
+	}
+
+	if(bAllDone && bPlaying && !bPaused){
+		if(loopState==OF_LOOP_NORMAL){
+			setPosition(0);
+		}else{
+			pausePipelines();
+		}
+	}
+}
+
+//-------------------------------------------------
+bool ofGstVideoPool::isFrameNew(){
+	for(int i=0;i<(int)videos.size();i++){
+		if(videos[i]->isFrameNew()) return true;
+	}
+	return false;
+}
+
+//-------------------------------------------------
+bool ofGstVideoPool::isFrameNewInAll(){
+	for(int i=0;i<(int)videos.size();i++){
+		if(!videos[i]->isFrameNew()) return false;
+	}
+	return !videos.empty();
+}
+
+//-------------------------------------------------
+int64_t ofGstVideoPool::getRunningTimeNanos(){
+	if(!bPlaying || bPaused || !clock){
+		return pausedRunningTime;
+	}
+	int64_t runningTime = (int64_t)gst_clock_get_time(clock) - (int64_t)baseTime;
+	return max(runningTime,(int64_t)0);
+}
+
+//-------------------------------------------------
+GstClock * ofGstVideoPool::getClock(){
+	return clock;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::setStartDelayNanos(int64_t delay){
+	startDelay = delay;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::pausePipelines(){
+	if(bPlaying && !bPaused){
+		pausedRunningTime = getRunningTimeNanos();
+	}
+	for(int i=0;i<(int)videos.size();i++){
+		videos[i]->setPaused(true);
+	}
+	waitForPreroll();
+	bPaused = true;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::seekPipelines(const vector<int64_t> & positions){
+	// after a flushing seek the running time of every pipeline starts
+	// again from 0 at the position it was seeked to
+	GstSeekFlags flags = (GstSeekFlags) (GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE);
+	for(int i=0;i<(int)videos.size();i++){
+		if(!gst_element_seek_simple(videos[i]->getPipeline(),GST_FORMAT_TIME,flags,positions[i])){
+			ofLogWarning("ofGstVideoPool") << "seekPipelines(): unable to seek video " << i;
+		}
+		segmentStarts[i] = positions[i];
+	}
+	waitForPreroll();
+	pausedRunningTime = 0;
+}
+
+//-------------------------------------------------
+void ofGstVideoPool::waitForPreroll(){
+	for(int i=0;i<(int)videos.size();i++){
+		if(gst_element_get_state(videos[i]->getPipeline(),NULL,NULL,2*GST_SECOND)==GST_STATE_CHANGE_FAILURE){
+			ofLogWarning("ofGstVideoPool") << "waitForPreroll(): video " << i << " failed to change state";
+		}
+	}
+}
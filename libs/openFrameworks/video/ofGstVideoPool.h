@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ofGstUtils.h"
+#include "ofGstVideoPlayer.h"
+
+// plays a set of videos in sync. every pipeline in the pool runs on the
+// same clock with the same base time so their sinks present frames at the
+// same moments, and update() makes current in every video the frame that
+// should be on screen at the same running time.
+//
+// the pool takes over the transport of the videos it contains, play,
+// pause, seek and loop them through the pool instead of individually.
+// videos can be ofGstVideoPlayers or any ofGstVideoUtils, for example one
+// created with setPipeline("videotestsrc ! ...")
+//
+// only the pool chooses the frame of its videos, updating a player or an
+// ofVideoPlayer using it doesn't change it, call the pool update() before
+// updating the players so their textures get the new frame
+//
+// Info:
+// videos need to be loaded before being added and can't be streams
+// the pool loops when all the videos have reached their end so the
+// shorter ones wait on their last frame for the longest one
+// bus messages for all the pipelines are handled in the gstreamer main
+// loop thread shared by all the ofGstUtils
+
+class ofGstVideoPool {
+public:
+	ofGstVideoPool();
+	virtual ~ofGstVideoPool();
+
+	bool add(ofGstVideoPlayer & player);
+	bool add(ofGstVideoUtils & video);
+	void remove(ofGstVideoPlayer & player);
+	void remove(ofGstVideoUtils & video);
+	void clear();
+	int size();
+
+	void play();
+	void stop();
+	void setPaused(bool bPause);
+	bool isPaused();
+	bool isPlaying();
+
+	// seeks all the videos to pct of their duration, they restart in
+	// sync from there
+	void setPosition(float pct);
+	void setLoopState(ofLoopType state);
+	ofLoopType getLoopState();
+
+	// updates all the videos to the frame for the current running time
+	// of the pool and loops them if they are done
+	void update();
+
+	// true if any / all of the videos got a new frame in the last update
+	bool isFrameNew();
+	bool isFrameNewInAll();
+
+	// time since the pool started playing excluding pauses
+	int64_t getRunningTimeNanos();
+	GstClock * getClock();
+
+	// delay between play() and the first frame, gives all the pipelines
+	// time to go to playing before the clock reaches the first frame
+	void setStartDelayNanos(int64_t delay);
+
+private:
+	ofGstVideoPool(const ofGstVideoPool &);
+	ofGstVideoPool & operator=(const ofGstVideoPool &);
+
+	void pausePipelines();
+	void seekPipelines(const vector<int64_t> & positions);
+	void waitForPreroll();
+
+	vector<ofGstVideoUtils*> videos;
+	vector<int64_t> segmentStarts;
+	GstClock * clock;
+	GstClockTime baseTime;
+	int64_t pausedRunningTime;
+	int64_t startDelay;
+	ofLoopType loopState;
+	bool bPlaying;
+	bool bPaused;
+};
@@ -1,6 +1,163 @@
 #include "ofVideoPlayer.h"
 #include "ofUtils.h"
 #include "ofGraphics.h"
+#include "ofShader.h"
+
+//---------------------------------------------------------------------------
+static bool isPlanar(ofPixelFormat pixelFormat){
+	return pixelFormat == OF_PIXELS_I420 || pixelFormat == OF_PIXELS_NV12;
+}
+
+//---------------------------------------------------------------------------
+#define STRINGIFY(x) #x
+
+// bt.601 video range, the same as ofConvertYuvToRgb. the chroma is in
+// chroma0 and chroma1 for i420 and interleaved in chroma0 for nv12
+#ifdef TARGET_OPENGLES
+static string yuvVertexShader = STRINGIFY(
+	precision highp float;
+
+	uniform mat4 modelViewProjectionMatrix;
+	uniform mat4 textureMatrix;
+
+	attribute vec4 position;
+	attribute vec2 texcoord;
+
+	varying vec2 texCoordVarying;
+
+	void main(){
+		texCoordVarying = (textureMatrix*vec4(texcoord.x,texcoord.y,0,1)).xy;
+		gl_Position = modelViewProjectionMatrix * position;
+	}
+);
+
+static string yuvFragmentShader = STRINGIFY(
+	precision highp float;
+
+	uniform sampler2D src_tex_unit0;
+	uniform sampler2D chroma0;
+	uniform sampler2D chroma1;
+	uniform int interleaved;
+
+	varying vec2 texCoordVarying;
+
+	void main(){
+		float y = texture2D(src_tex_unit0, texCoordVarying).r;
+		vec2 uv;
+		if(interleaved==1){
+			uv = texture2D(chroma0, texCoordVarying).ra;
+		}else{
+			uv = vec2(texture2D(chroma0, texCoordVarying).r, texture2D(chroma1, texCoordVarying).r);
+		}
+		float c = 1.164 * (y - 0.0627);
+		float d = uv.x - 0.502;
+		float e = uv.y - 0.502;
+		gl_FragColor = vec4(c + 1.596*e, c - 0.391*d - 0.813*e, c + 2.018*d, 1.0);
+	}
+);
+#else
+static string yuvVertexShader = "#version 120\n" STRINGIFY(
+	varying vec2 texCoordVarying;
+
+	void main(){
+		texCoordVarying = (gl_TextureMatrix[0] * gl_MultiTexCoord0).xy;
+		gl_Position = ftransform();
+	}
+);
+
+static string yuvFragmentShader = "#version 120\n" STRINGIFY(
+	uniform sampler2D src_tex_unit0;
+	uniform sampler2D chroma0;
+	uniform sampler2D chroma1;
+	uniform int interleaved;
+
+	varying vec2 texCoordVarying;
+
+	void main(){
+		float y = texture2D(src_tex_unit0, texCoordVarying).r;
+		vec2 uv;
+		if(interleaved==1){
+			uv = texture2D(chroma0, texCoordVarying).ra;
+		}else{
+			uv = vec2(texture2D(chroma0, texCoordVarying).r, texture2D(chroma1, texCoordVarying).r);
+		}
+		float c = 1.164 * (y - 0.0627);
+		float d = uv.x - 0.502;
+		float e = uv.y - 0.502;
+		gl_FragColor = vec4(c + 1.596*e, c - 0.391*d - 0.813*e, c + 2.018*d, 1.0);
+	}
+);
+
+static string yuvVertexShaderGL3 = "#version 150\n" STRINGIFY(
+	uniform mat4 modelViewProjectionMatrix;
+	uniform mat4 textureMatrix;
+
+	in vec4 position;
+	in vec2 texcoord;
+
+	out vec2 texCoordVarying;
+
+	void main(){
+		texCoordVarying = (textureMatrix*vec4(texcoord.x,texcoord.y,0,1)).xy;
+		gl_Position = modelViewProjectionMatrix * position;
+	}
+);
+
+// two channel textures are GL_RG8 with the programmable renderer
+static string yuvFragmentShaderGL3 = "#version 150\n" STRINGIFY(
+	uniform sampler2D src_tex_unit0;
+	uniform sampler2D chroma0;
+	uniform sampler2D chroma1;
+	uniform int interleaved;
+
+	in vec2 texCoordVarying;
+
+	out vec4 fragColor;
+
+	void main(){
+		float y = texture(src_tex_unit0, texCoordVarying).r;
+		vec2 uv;
+		if(interleaved==1){
+			uv = texture(chroma0, texCoordVarying).rg;
+		}else{
+			uv = vec2(texture(chroma0, texCoordVarying).r, texture(chroma1, texCoordVarying).r);
+		}
+		float c = 1.164 * (y - 0.0627);
+		float d = uv.x - 0.502;
+		float e = uv.y - 0.502;
+		fragColor = vec4(c + 1.596*e, c - 0.391*d - 0.813*e, c + 2.018*d, 1.0);
+	}
+);
+#endif
+
+//---------------------------------------------------------------------------
+// isLoaded() is false if the shader couldn't be compiled, then the
+// frames are converted on the cpu
+static ofShader & yuvShader(){
+	static ofShader * shader = new ofShader;
+	static bool bSetup = false;
+	if(!bSetup){
+		bSetup = true;
+#ifndef TARGET_OPENGLES
+		if(!ofIsGLProgrammableRenderer()){
+			shader->setupShaderFromSource(GL_VERTEX_SHADER, yuvVertexShader);
+			shader->setupShaderFromSource(GL_FRAGMENT_SHADER, yuvFragmentShader);
+		}else{
+			shader->setupShaderFromSource(GL_VERTEX_SHADER, yuvVertexShaderGL3);
+			shader->setupShaderFromSource(GL_FRAGMENT_SHADER, yuvFragmentShaderGL3);
+			shader->bindDefaults();
+		}
+#else
+		if(ofIsGLProgrammableRenderer()){
+			shader->setupShaderFromSource(GL_VERTEX_SHADER, yuvVertexShader);
+			shader->setupShaderFromSource(GL_FRAGMENT_SHADER, yuvFragmentShader);
+			shader->bindDefaults();
+		}
+#endif
+		shader->linkProgram();
+	}
+	return *shader;
+}
 
 //---------------------------------------------------------------------------
 ofVideoPlayer::ofVideoPlayer (){
@@ -70,7 +227,8 @@ bool ofVideoPlayer::loadMovie(string name){
 
 	if( bOk){
         moviePath = name;
-        if(bUseTexture ){
+        // planar formats allocate their textures with the first frame
+        if(bUseTexture && !isPlanar(internalPixelFormat)){
             if(width!=0 && height!=0) {
                 tex.allocate(width, height, ofGetGLInternalFormatFromPixelFormat(internalPixelFormat));
         		if(ofGetGLProgrammableRenderer() && internalPixelFormat == OF_PIXELS_MONO){
@@ -148,7 +306,9 @@ void ofVideoPlayer::update(){
 			
 			playerTex = player->getTexture();
 			
-			if(playerTex == NULL){
+			if(playerTex == NULL && isPlanar(internalPixelFormat)){
+				updatePlanarTexture();
+			}else if(playerTex == NULL){
 				unsigned char *pxls = player->getPixels();
 				
 				bool bDiffPixFormat = ( tex.bAllocated() && tex.texData.glTypeInternal != ofGetGLInternalFormatFromPixelFormat(internalPixelFormat) );
@@ -177,6 +337,59 @@ void ofVideoPlayer::update(){
 	}
 }
 
+//---------------------------------------------------------------------------
+void ofVideoPlayer::updatePlanarTexture(){
+	ofPixels & yuv = player->getPixelsRef();
+	width = yuv.getWidth();
+	height = yuv.getHeight();
+	if(width==0 || height==0) return;
+
+	ofShader & shader = yuvShader();
+	if(!shader.isLoaded()){
+		ofConvertYuvToRgb(yuv, rgbPixels, OF_PIXELS_RGB);
+		if(!tex.isAllocated() || tex.getWidth()!=width || tex.getHeight()!=height){
+			tex.allocate(rgbPixels);
+		}
+		tex.loadData(rgbPixels);
+		return;
+	}
+
+	// every plane goes to its own texture, the chroma at half resolution
+	// and with u and v in 2 channels for nv12
+	int numPlanes = yuv.getNumPlanes();
+	for(int i=0; i<numPlanes; i++){
+		int channels = (i==1 && numPlanes==2) ? 2 : 1;
+		ofPixels plane;
+		plane.setFromExternalPixels(yuv.getPlane(i), yuv.getPlaneStride(i)/channels, yuv.getPlaneHeight(i), channels);
+		if(!yuvPlanes[i].isAllocated() || yuvPlanes[i].getWidth()!=plane.getWidth() || yuvPlanes[i].getHeight()!=plane.getHeight()){
+			yuvPlanes[i].allocate(plane, false);
+		}
+		yuvPlanes[i].loadData(plane);
+	}
+	if(!yuvFbo.isAllocated() || yuvFbo.getWidth()!=width || yuvFbo.getHeight()!=height){
+		yuvFbo.allocate(width, height, GL_RGB);
+	}
+
+	bool bTexHackEnabled = ofIsTextureEdgeHackEnabled();
+	ofDisableTextureEdgeHack();
+	yuvFbo.begin();
+	ofPushStyle();
+	ofDisableAlphaBlending();
+	ofSetColor(255);
+	shader.begin();
+	shader.setUniformTexture("chroma0", yuvPlanes[1], 1);
+	shader.setUniformTexture("chroma1", yuvPlanes[numPlanes==3 ? 2 : 1], 2);
+	shader.setUniform1i("interleaved", numPlanes==2);
+	yuvPlanes[0].draw(0, 0, width, height);
+	shader.end();
+	ofPopStyle();
+	yuvFbo.end();
+	if(bTexHackEnabled){
+		ofEnableTextureEdgeHack();
+	}
+	playerTex = &yuvFbo.getTextureReference();
+}
+
 //---------------------------------------------------------------------------
 void ofVideoPlayer::closeMovie(){
 	close();
@@ -326,7 +539,7 @@ void ofVideoPlayer::setPaused(bool _bPause){
 //------------------------------------
 void ofVideoPlayer::setUseTexture(bool bUse){
 	bUseTexture = bUse;
-	if(bUse && width!=0 && height!=0 && !tex.isAllocated()){
+	if(bUse && width!=0 && height!=0 && !tex.isAllocated() && !isPlanar(internalPixelFormat)){
 		tex.allocate(width, height, ofGetGLTypeFromPixelFormat(internalPixelFormat));
 		if(ofGetGLProgrammableRenderer() && internalPixelFormat == OF_PIXELS_MONO){
 			tex.setRGToRGBASwizzles(true);
@@ -2,11 +2,13 @@
 
 #include "ofConstants.h"
 #include "ofTexture.h"
+#include "ofFbo.h"
 #include "ofBaseTypes.h"
 #include "ofTypes.h"
 
 #ifdef OF_VIDEO_PLAYER_GSTREAMER
 	#include "ofGstVideoPlayer.h"
+	#include "ofGstVideoPool.h"
 	#define OF_VID_PLAYER_TYPE ofGstVideoPlayer
 #endif
 
@@ -101,10 +103,15 @@ class ofVideoPlayer : public ofBaseVideoPlayer,public ofBaseVideoDraws{
 		int					width;
 
 	private:
+		void updatePlanarTexture();
+
 		ofPtr<ofBaseVideoPlayer>		player;
 		
 		ofTexture tex;
 		ofTexture * playerTex; // a seperate texture that may be optionally implemented by the player to avoid excessive pixel copying.
+		ofTexture yuvPlanes[3]; // planar yuv frames are uploaded as they are
+		ofFbo yuvFbo; // and converted to rgb in a shader
+		ofPixels rgbPixels; // or converted on the cpu for uploading to tex if there's no shaders
 		bool bUseTexture;
 		ofPixelFormat internalPixelFormat;
 	    string moviePath;